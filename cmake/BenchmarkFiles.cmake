@@ -0,0 +1,47 @@
+# Microbenchmarks based on Google Benchmark. Each benchmark is a separate
+# executable that links the libraries it measures.
+
+FetchContent_Declare(
+  googlebenchmark
+  GIT_REPOSITORY https://github.com/google/benchmark.git
+  GIT_TAG        v1.8.3
+  GIT_PROGRESS   FALSE
+)
+
+set(BENCHMARK_ENABLE_TESTING OFF CACHE BOOL "" FORCE)
+set(BENCHMARK_ENABLE_INSTALL OFF CACHE BOOL "" FORCE)
+FetchContent_MakeAvailable(googlebenchmark)
+
+add_library(benchmark_cxx_flags INTERFACE)
+target_link_libraries(benchmark_cxx_flags INTERFACE common_cxx_flags)
+target_link_libraries(benchmark_cxx_flags INTERFACE benchmark::benchmark)
+
+add_executable(state_registry_benchmarks benchmarks/state_registry_benchmarks.cc)
+target_link_libraries(state_registry_benchmarks PRIVATE
+    benchmark_cxx_flags
+    iface_concurrent_state_registry
+    iface_test_tasks)
+
+add_executable(successor_generator_benchmarks benchmarks/successor_generator_benchmarks.cc)
+target_link_libraries(successor_generator_benchmarks PRIVATE
+    benchmark_cxx_flags
+    iface_successor_generator
+    iface_test_tasks)
+
+add_executable(heuristic_benchmarks benchmarks/heuristic_benchmarks.cc)
+target_link_libraries(heuristic_benchmarks PRIVATE
+    benchmark_cxx_flags
+    iface_blind_search_heuristic
+    iface_ff_heuristic
+    iface_goal_count_heuristic
+    iface_max_heuristic
+    iface_pdbs
+    iface_test_tasks)
+
+# Run the heuristic benchmarks and save the results for regression tracking.
+add_custom_target(heuristic_benchmarks_json
+    COMMAND heuristic_benchmarks
+        --benchmark_out=${CMAKE_BINARY_DIR}/heuristic_benchmarks.json
+        --benchmark_out_format=json
+    DEPENDS heuristic_benchmarks
+    USES_TERMINAL)
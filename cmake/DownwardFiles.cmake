@@ -52,6 +52,7 @@ create_fast_downward_library(
         downward/evaluator
         downward/evaluator_cache
         downward/heuristic
+        downward/heuristic_cache
         downward/open_list
         downward/open_list_factory
         downward/operator_cost
@@ -74,7 +75,7 @@ create_fast_downward_library(
         downward/state_registry
         downward/task_id
         downward/task_proxy
-    DEPENDS int_hash_set int_packer ordered_set segmented_vector subscriber successor_generator task_properties policies
+    DEPENDS compiled_task indexed_cache int_hash_set int_packer mapped_segment_allocator ordered_set segmented_vector subscriber successor_generator task_properties policies
     CORE_LIBRARY
 )
 
@@ -107,6 +108,7 @@ create_fast_downward_library(
         downward/utils/distribution
         downward/utils/exceptions
         downward/utils/hash
+        downward/utils/json
         downward/utils/logging
         downward/utils/markup
         downward/utils/math
@@ -136,6 +138,29 @@ create_fast_downward_library(
         downward/open_lists/tiebreaking_open_list
 )
 
+create_fast_downward_library(
+    NAME bucket_tiebreaking_open_list
+    HELP "Bucket-based tiebreaking open list for up to three evaluators"
+    SOURCES
+        downward/open_lists/bucket_tiebreaking_open_list
+    DEPENDS tiebreaking_open_list
+)
+
+create_fast_downward_library(
+    NAME alternation_open_list
+    HELP "Open list that alternates between several sublists"
+    SOURCES
+        downward/open_lists/alternation_open_list
+)
+
+create_fast_downward_library(
+    NAME indexed_cache
+    HELP "Caches indexed by dense object IDs"
+    SOURCES
+        downward/algorithms/indexed_cache
+    DEPENDENCY_ONLY
+)
+
 create_fast_downward_library(
     NAME int_hash_set
     HELP "Hash set storing non-negative integers"
@@ -176,6 +201,22 @@ create_fast_downward_library(
     DEPENDENCY_ONLY
 )
 
+create_fast_downward_library(
+    NAME mapped_segment_allocator
+    HELP "Allocator for segmented vectors backed by a memory-mapped file"
+    SOURCES
+        downward/algorithms/mapped_segment_allocator
+    DEPENDENCY_ONLY
+)
+
+create_fast_downward_library(
+    NAME concurrent_segmented_vector
+    HELP "Segmented vector that can be grown from several threads"
+    SOURCES
+        downward/algorithms/concurrent_segmented_vector
+    DEPENDENCY_ONLY
+)
+
 create_fast_downward_library(
     NAME subscriber
     HELP "Allows object to subscribe to the destructor of other objects"
@@ -251,7 +292,7 @@ create_fast_downward_library(
     HELP "Basic classes used for all search algorithms"
     SOURCES
         downward/search_algorithms/search_common
-    DEPENDS g_evaluator sum_evaluator tiebreaking_open_list
+    DEPENDS g_evaluator sum_evaluator alternation_open_list bucket_tiebreaking_open_list
     DEPENDENCY_ONLY
 )
 
@@ -272,6 +313,38 @@ create_fast_downward_library(
     DEPENDS eager_search search_common
 )
 
+create_fast_downward_library(
+    NAME hda_search
+    HELP "Hash-distributed parallel A* search algorithm"
+    SOURCES
+        downward/search_algorithms/hda_search
+    DEPENDS search_common successor_generator
+    DEPENDENCY_ONLY
+)
+
+# The parallel search uses std::thread.
+find_package(Threads REQUIRED)
+target_link_libraries(hda_search PUBLIC Threads::Threads)
+
+create_fast_downward_library(
+    NAME concurrent_state_registry
+    HELP "State registry that can be shared by several threads"
+    SOURCES
+        downward/concurrent_state_registry
+    DEPENDS concurrent_segmented_vector int_packer task_properties
+    DEPENDENCY_ONLY
+)
+
+target_link_libraries(concurrent_state_registry PUBLIC Threads::Threads)
+
+create_fast_downward_library(
+    NAME plugin_parallel_astar
+    HELP "Parallel A* search (HDA*)"
+    SOURCES
+        downward/search_algorithms/plugin_parallel_astar
+    DEPENDS hda_search
+)
+
 create_fast_downward_library(
     NAME plugin_eager
     HELP "Eager (i.e., normal) best-first search"
@@ -280,6 +353,82 @@ create_fast_downward_library(
     DEPENDS eager_search search_common
 )
 
+create_fast_downward_library(
+    NAME plugin_eager_greedy
+    HELP "Eager greedy best-first search"
+    SOURCES
+        downward/search_algorithms/plugin_eager_greedy
+    DEPENDS eager_search search_common
+)
+
+create_fast_downward_library(
+    NAME idastar_search
+    HELP "IDA* search algorithm"
+    SOURCES
+        downward/search_algorithms/idastar_search
+    DEPENDS successor_generator
+    DEPENDENCY_ONLY
+)
+
+create_fast_downward_library(
+    NAME plugin_idastar
+    HELP "IDA* search"
+    SOURCES
+        downward/search_algorithms/plugin_idastar
+    DEPENDS idastar_search
+)
+
+create_fast_downward_library(
+    NAME anytime_astar_search
+    HELP "Anytime A* search algorithm"
+    SOURCES
+        downward/search_algorithms/anytime_astar_search
+    DEPENDS successor_generator
+    DEPENDENCY_ONLY
+)
+
+create_fast_downward_library(
+    NAME plugin_anytime_astar
+    HELP "Anytime A* search"
+    SOURCES
+        downward/search_algorithms/plugin_anytime_astar
+    DEPENDS anytime_astar_search
+)
+
+create_fast_downward_library(
+    NAME external_bfs_search
+    HELP "External breadth-first search algorithm"
+    SOURCES
+        downward/search_algorithms/external_bfs_search
+    DEPENDS successor_generator
+    DEPENDENCY_ONLY
+)
+
+create_fast_downward_library(
+    NAME plugin_external_bfs
+    HELP "External breadth-first search"
+    SOURCES
+        downward/search_algorithms/plugin_external_bfs
+    DEPENDS external_bfs_search
+)
+
+create_fast_downward_library(
+    NAME lazy_search
+    HELP "Lazy search algorithm"
+    SOURCES
+        downward/search_algorithms/lazy_search
+    DEPENDS ordered_set successor_generator
+    DEPENDENCY_ONLY
+)
+
+create_fast_downward_library(
+    NAME plugin_lazy_greedy
+    HELP "Greedy best-first search with deferred evaluation"
+    SOURCES
+        downward/search_algorithms/plugin_lazy_greedy
+    DEPENDS lazy_search search_common
+)
+
 create_fast_downward_library(
     NAME relaxation_heuristic
     HELP "The base class for relaxation heuristics"
@@ -326,9 +475,13 @@ create_fast_downward_library(
         downward/tasks/cost_adapted_task
         downward/tasks/delegating_task
         downward/tasks/root_task
+    DEPENDS successor_generator
     CORE_LIBRARY
 )
 
+# The translator output can be parsed with several threads.
+target_link_libraries(core_tasks PUBLIC Threads::Threads)
+
 create_fast_downward_library(
     NAME extra_tasks
     HELP "Non-core task transformations"
@@ -347,6 +500,15 @@ create_fast_downward_library(
     DEPENDENCY_ONLY
 )
 
+create_fast_downward_library(
+    NAME compiled_task
+    HELP "Flat snapshot of a classical task"
+    SOURCES
+        downward/task_utils/compiled_task
+    DEPENDS task_properties
+    DEPENDENCY_ONLY
+)
+
 create_fast_downward_library(
     NAME successor_generator
     HELP "Successor generator"
@@ -14,6 +14,7 @@ create_fast_downward_library(
     SOURCES
         neuralfd/task_utils/operator_generator_factory
         neuralfd/task_utils/operator_generator_internals
+        neuralfd/task_utils/partial_state_index
         neuralfd/task_utils/predecessor_generator
         neuralfd/task_utils/predecessor_generator_factory
         neuralfd/task_utils/regression_task_proxy
@@ -113,6 +114,23 @@ create_fast_downward_library(
     DEPENDS search_common
 )
 
+create_fast_downward_library(
+    NAME bidirectional_search
+    HELP "Bidirectional search with regression"
+    SOURCES
+        neuralfd/search_algorithms/bidirectional_search
+    DEPENDS regression
+    DEPENDENCY_ONLY
+)
+
+create_fast_downward_library(
+    NAME plugin_bidirectional
+    HELP "Bidirectional search plugin"
+    SOURCES
+        neuralfd/search_algorithms/plugin_bidirectional
+    DEPENDS bidirectional_search
+)
+
 create_fast_downward_library(
     NAME network_heuristic
     HELP "The network heuristic"
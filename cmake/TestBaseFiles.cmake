@@ -44,3 +44,221 @@ create_test_library(
         search_common
         eager_search
 )
+
+create_test_library(
+    NAME bucket_tiebreaking_open_list_public_tests
+    HELP "Bucket-based tie-breaking open list public tests"
+    SOURCES
+        tests/public/search_tests/bucket_tiebreaking_open_list_tests
+    DEPENDS
+        bucket_tiebreaking_open_list
+        tiebreaking_open_list
+        test_tasks
+)
+
+create_test_library(
+    NAME search_space_public_tests
+    HELP "Search space public tests"
+    SOURCES
+        tests/public/search_tests/search_space_tests
+    DEPENDS
+        test_tasks
+)
+
+create_test_library(
+    NAME state_registry_public_tests
+    HELP "State registry public tests"
+    SOURCES
+        tests/public/state_registry_tests/state_registry_tests
+    DEPENDS
+        test_tasks
+)
+
+create_test_library(
+    NAME concurrent_state_registry_public_tests
+    HELP "Concurrent state registry public tests"
+    SOURCES
+        tests/public/state_registry_tests/concurrent_state_registry_tests
+    DEPENDS
+        concurrent_state_registry
+        test_tasks
+)
+
+create_test_library(
+    NAME mapped_segment_allocator_public_tests
+    HELP "Memory-mapped segment allocator public tests"
+    SOURCES
+        tests/public/algorithm_tests/mapped_segment_allocator_tests
+    DEPENDS
+        mapped_segment_allocator
+        test_tasks
+)
+
+create_test_library(
+    NAME int_packer_public_tests
+    HELP "Int packer public tests"
+    SOURCES
+        tests/public/algorithm_tests/int_packer_tests
+    DEPENDS
+        int_packer
+)
+
+create_test_library(
+    NAME int_hash_set_public_tests
+    HELP "Int hash set public tests"
+    SOURCES
+        tests/public/algorithm_tests/int_hash_set_tests
+    DEPENDS
+        int_hash_set
+)
+
+create_test_library(
+    NAME successor_generator_public_tests
+    HELP "Successor generator public tests"
+    SOURCES
+        tests/public/task_tests/successor_generator_tests
+    DEPENDS
+        successor_generator
+        test_tasks
+)
+
+create_test_library(
+    NAME compiled_task_public_tests
+    HELP "Compiled task public tests"
+    SOURCES
+        tests/public/task_tests/compiled_task_tests
+    DEPENDS
+        compiled_task
+        test_tasks
+)
+
+create_test_library(
+    NAME binary_task_public_tests
+    HELP "Binary task file public tests"
+    SOURCES
+        tests/public/task_tests/binary_task_tests
+    DEPENDS
+        core_tasks
+)
+
+create_test_library(
+    NAME sas_parser_public_tests
+    HELP "Translator output parser public tests"
+    SOURCES
+        tests/public/task_tests/sas_parser_tests
+    DEPENDS
+        core_tasks
+)
+
+create_test_library(
+    NAME json_public_tests
+    HELP "JSON writer public tests"
+    SOURCES
+        tests/public/utils_tests/json_tests
+)
+
+create_test_library(
+    NAME search_statistics_public_tests
+    HELP "Search statistics public tests"
+    SOURCES
+        tests/public/search_tests/search_statistics_tests
+    DEPENDS
+        test_tasks
+)
+
+create_test_library(
+    NAME lazy_search_public_tests
+    HELP "Lazy search public tests"
+    SOURCES
+        tests/public/search_tests/lazy_search_tests
+    DEPENDS
+        lazy_search
+        search_common
+        goal_count_heuristic
+        test_tasks
+)
+
+create_test_library(
+    NAME alternation_open_list_public_tests
+    HELP "Alternation open list public tests"
+    SOURCES
+        tests/public/search_tests/alternation_open_list_tests
+    DEPENDS
+        alternation_open_list
+        tiebreaking_open_list
+        test_tasks
+)
+
+create_test_library(
+    NAME idastar_public_tests
+    HELP "IDA* search public tests"
+    SOURCES
+        tests/public/search_tests/idastar_tests
+    DEPENDS
+        idastar_search
+        goal_count_heuristic
+        test_tasks
+        search_test_utils
+)
+
+create_test_library(
+    NAME partial_state_index_public_tests
+    HELP "Partial state index public tests"
+    SOURCES
+        tests/public/task_tests/partial_state_index_tests
+    DEPENDS
+        regression
+)
+
+create_test_library(
+    NAME bidirectional_search_public_tests
+    HELP "Bidirectional search public tests"
+    SOURCES
+        tests/public/search_tests/bidirectional_search_tests
+    DEPENDS
+        bidirectional_search
+        goal_count_heuristic
+        test_tasks
+        search_test_utils
+)
+
+create_test_library(
+    NAME anytime_astar_public_tests
+    HELP "Anytime A* search public tests"
+    SOURCES
+        tests/public/search_tests/anytime_astar_tests
+    DEPENDS
+        anytime_astar_search
+        goal_count_heuristic
+        test_tasks
+        search_test_utils
+)
+
+create_test_library(
+    NAME external_bfs_public_tests
+    HELP "External breadth-first search public tests"
+    SOURCES
+        tests/public/search_tests/external_bfs_tests
+    DEPENDS
+        external_bfs_search
+        test_tasks
+)
+
+create_test_library(
+    NAME indexed_cache_public_tests
+    HELP "ID pool and indexed cache public tests"
+    SOURCES
+        tests/public/algorithm_tests/indexed_cache_tests
+    DEPENDS
+        indexed_cache
+        test_tasks
+)
+
+create_test_library(
+    NAME heuristic_cache_public_tests
+    HELP "Heuristic cache public tests"
+    SOURCES
+        tests/public/heuristic_tests/heuristic_cache_tests
+    DEPENDS
+        test_tasks
+)
@@ -0,0 +1,144 @@
+#ifndef DOWNWARD_ALGORITHMS_CONCURRENT_SEGMENTED_VECTOR_H
+#define DOWNWARD_ALGORITHMS_CONCURRENT_SEGMENTED_VECTOR_H
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <memory>
+
+/*
+  ConcurrentSegmentedArrayVector stores fixed-size arrays of elements, like
+  SegmentedArrayVector, but may be read and grown from several threads at the
+  same time.
+
+  Growth protocol: the directory of segment pointers is allocated once with a
+  fixed capacity, so it never moves. Segments are allocated lazily on first
+  access and are installed into the directory with a compare-and-swap. If two
+  threads race to allocate the same segment, exactly one allocation wins and
+  the other one is freed again. Segments are never moved or freed before the
+  vector is destroyed, so pointers to arrays stay valid forever.
+
+  The class only synchronizes the allocation of memory. Concurrent accesses
+  to the *same* array must be synchronized by the caller, e.g. by handing out
+  indices to one thread only or by publishing them through an atomic.
+*/
+
+namespace concurrent_segmented_vector {
+template <class Element>
+class ConcurrentSegmentedArrayVector {
+    static const size_t SEGMENT_BYTES = 1 << 16;
+
+    const size_t elements_per_array;
+    const size_t arrays_per_segment;
+    const size_t max_segments;
+    const Element default_value;
+
+    std::unique_ptr<std::atomic<Element*>[]> segments;
+    std::atomic<size_t> num_allocated_segments;
+
+    size_t get_elements_per_segment() const
+    {
+        return elements_per_array * arrays_per_segment;
+    }
+
+    Element* allocate_segment(size_t segment)
+    {
+        Element* new_segment = new Element[get_elements_per_segment()];
+        std::fill_n(new_segment, get_elements_per_segment(), default_value);
+        Element* expected = nullptr;
+        if (segments[segment].compare_exchange_strong(
+                expected,
+                new_segment,
+                std::memory_order_acq_rel,
+                std::memory_order_acquire)) {
+            num_allocated_segments.fetch_add(1, std::memory_order_relaxed);
+            return new_segment;
+        }
+        // Another thread installed the segment first.
+        delete[] new_segment;
+        return expected;
+    }
+
+public:
+    static size_t compute_arrays_per_segment(size_t elements_per_array)
+    {
+        return std::max<size_t>(
+            SEGMENT_BYTES /
+                (std::max<size_t>(elements_per_array, 1) * sizeof(Element)),
+            1);
+    }
+
+    /*
+      Create a vector for at most max_arrays arrays with elements_per_array
+      elements each. New elements are initialized to default_value.
+    */
+    ConcurrentSegmentedArrayVector(
+        size_t elements_per_array,
+        size_t max_arrays,
+        const Element& default_value = Element())
+        : elements_per_array(std::max<size_t>(elements_per_array, 1))
+        , arrays_per_segment(compute_arrays_per_segment(elements_per_array))
+        , max_segments(
+              (max_arrays + arrays_per_segment - 1) / arrays_per_segment)
+        , default_value(default_value)
+        , segments(new std::atomic<Element*>[max_segments])
+        , num_allocated_segments(0)
+    {
+        for (size_t i = 0; i < max_segments; ++i)
+            segments[i].store(nullptr, std::memory_order_relaxed);
+    }
+
+    ConcurrentSegmentedArrayVector(const ConcurrentSegmentedArrayVector&) =
+        delete;
+    ConcurrentSegmentedArrayVector&
+    operator=(const ConcurrentSegmentedArrayVector&) = delete;
+
+    ~ConcurrentSegmentedArrayVector()
+    {
+        for (size_t i = 0; i < max_segments; ++i)
+            delete[] segments[i].load(std::memory_order_relaxed);
+    }
+
+    /*
+      Return the array with the given index, allocating its segment if
+      necessary. Thread-safe.
+    */
+    Element* operator[](size_t index)
+    {
+        size_t segment = index / arrays_per_segment;
+        assert(segment < max_segments);
+        Element* data = segments[segment].load(std::memory_order_acquire);
+        if (!data) data = allocate_segment(segment);
+        return data + (index % arrays_per_segment) * elements_per_array;
+    }
+
+    /*
+      Return the array with the given index or nullptr if its segment has not
+      been allocated yet. Thread-safe.
+    */
+    const Element* lookup(size_t index) const
+    {
+        size_t segment = index / arrays_per_segment;
+        assert(segment < max_segments);
+        const Element* data =
+            segments[segment].load(std::memory_order_acquire);
+        if (!data) return nullptr;
+        return data + (index % arrays_per_segment) * elements_per_array;
+    }
+
+    size_t get_arrays_per_segment() const { return arrays_per_segment; }
+
+    size_t get_max_segments() const { return max_segments; }
+
+    size_t get_max_arrays() const { return max_segments * arrays_per_segment; }
+
+    size_t get_allocated_bytes() const
+    {
+        return num_allocated_segments.load(std::memory_order_relaxed) *
+               get_elements_per_segment() * sizeof(Element);
+    }
+};
+} // namespace concurrent_segmented_vector
+
+#endif
@@ -0,0 +1,129 @@
+#ifndef DOWNWARD_ALGORITHMS_INDEXED_CACHE_H
+#define DOWNWARD_ALGORITHMS_INDEXED_CACHE_H
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace indexed_cache {
+/*
+  Hand out small non-negative IDs to objects. An ID is reused after it has
+  been released, and the smallest free ID is always handed out first, so
+  the IDs of the objects that exist at the same time stay dense.
+*/
+class IdPool {
+    std::mutex mutex;
+    std::vector<bool> used;
+
+public:
+    int allocate();
+    void release(int id);
+};
+
+/*
+  An ID taken from an IdPool that is released when the PooledId is
+  destroyed. Because IDs are reused, data indexed by an ID can outlive the
+  object the ID belonged to. Every PooledId therefore also has a serial
+  number that is never reused, and per-ID data must be tagged with the
+  serial number of its owner and discarded when the serial numbers differ
+  (see IndexedCache).
+*/
+class PooledId {
+    const std::shared_ptr<IdPool> pool;
+    const int id;
+    const std::uint64_t serial;
+
+public:
+    explicit PooledId(std::shared_ptr<IdPool> pool);
+    ~PooledId();
+
+    PooledId(const PooledId&) = delete;
+    PooledId& operator=(const PooledId&) = delete;
+
+    int get_id() const { return id; }
+    // Unique among all PooledIds ever created in this process; never 0.
+    std::uint64_t get_serial() const { return serial; }
+};
+
+/*
+  Replace the pool stored in "current" by a new, empty pool while the
+  scope exists. Objects that take their IDs from "current" then get small
+  IDs even if many objects of the same kind exist outside the scope.
+*/
+class IdPoolScope {
+    std::shared_ptr<IdPool>& current;
+    std::shared_ptr<IdPool> previous;
+
+public:
+    explicit IdPoolScope(std::shared_ptr<IdPool>& current);
+    ~IdPoolScope();
+
+    IdPoolScope(const IdPoolScope&) = delete;
+    IdPoolScope& operator=(const IdPoolScope&) = delete;
+};
+
+/*
+  Map from objects with dense IDs (see IdPool) to results. The results for
+  the first NumInline IDs are stored inline, so the cache needs no heap
+  memory and no hashing if only objects with small IDs are stored. Larger
+  IDs are stored in a vector that grows as needed.
+
+  Key must provide "int get_id() const" and "std::uint64_t get_serial()
+  const" (see PooledId). Results are default-constructed when they are
+  accessed for the first time. An entry left behind by a destroyed key
+  whose ID has been reused is reset when the new key accesses it.
+*/
+template <class Key, class Result, int NumInline>
+class IndexedCache {
+    struct Entry {
+        Key* key = nullptr;
+        std::uint64_t serial = 0;
+        Result result;
+    };
+
+    std::array<Entry, NumInline> inline_entries;
+    std::vector<Entry> overflow_entries;
+
+    Entry& get_entry(int id)
+    {
+        if (id < NumInline) {
+            return inline_entries[id];
+        }
+        std::size_t index = id - NumInline;
+        if (index >= overflow_entries.size()) {
+            overflow_entries.resize(index + 1);
+        }
+        return overflow_entries[index];
+    }
+
+public:
+    Result& operator[](Key* key)
+    {
+        Entry& entry = get_entry(key->get_id());
+        if (entry.serial != key->get_serial()) {
+            entry.key = key;
+            entry.serial = key->get_serial();
+            entry.result = Result();
+        }
+        return entry.result;
+    }
+
+    // Call callback(key, result) for all keys in the cache by increasing ID.
+    template <class Callback>
+    void for_each(const Callback& callback) const
+    {
+        for (const Entry& entry : inline_entries) {
+            if (entry.key) callback(entry.key, entry.result);
+        }
+        for (const Entry& entry : overflow_entries) {
+            if (entry.key) callback(entry.key, entry.result);
+        }
+    }
+};
+} // namespace indexed_cache
+
+#endif
@@ -7,6 +7,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstdint>
 #include <iostream>
 #include <limits>
 #include <utility>
@@ -31,8 +32,8 @@ namespace int_hash_set {
 
   Limitations:
 
-  We use 32-bit (signed and unsigned) integers instead of larger data
-  types for keys and hashes to save memory.
+  We use 32-bit signed integers instead of larger data types for keys
+  to save memory.
 
   Consequently, the range of valid keys is [0, 2^31 - 1]. This range
   could be extended to [0, 2^32 - 2] without using more memory by
@@ -66,13 +67,21 @@ namespace int_hash_set {
   check for a given key are aligned in memory, the lookup has good
   cache locality.
 
+  Hashes are 64 bits wide. The low bits select the ideal bucket, and
+  each bucket stores the high 32 bits of the hash of its key as a
+  fingerprint. Since the capacity is below 2^32, the fingerprint is
+  independent of the bucket index, so the equality test, which usually
+  has to look at data outside of the hash set, is almost only called
+  for equal keys. The full hash is not stored. The hash function is
+  called again for stored keys when the hash set is resized or
+  entries are moved during an insertion, so it should be cheap, e.g.,
+  look up a hash that the user of the set stores anyway.
 */
 
 using KeyType = int;
-using HashType = unsigned int;
+using HashType = std::uint64_t;
 
 static_assert(sizeof(KeyType) == 4, "KeyType does not use 4 bytes");
-static_assert(sizeof(HashType) == 4, "HashType does not use 4 bytes");
 
 template <typename Hasher, typename Equal>
 class IntHashSet {
@@ -138,6 +147,12 @@ public:
     */
     std::pair<KeyType, bool> insert(KeyType key);
 
+    /*
+      Return a key equivalent to the given key if the hash set contains one,
+      and -1 otherwise. The given key itself is not inserted.
+    */
+    KeyType find(KeyType key) const;
+
     void dump(utils::LogProxy& log) const;
 
     void print_statistics(utils::LogProxy& log) const;
@@ -150,7 +165,8 @@ struct IntHashSet<Hasher, Equal>::Bucket {
     static constexpr KeyType empty_bucket_key = -1;
 
     KeyType key;
-    HashType hash;
+    // The high 32 bits of the hash of the key.
+    std::uint32_t fingerprint;
 
     Bucket()
         : Bucket(empty_bucket_key, 0)
@@ -159,8 +175,13 @@ struct IntHashSet<Hasher, Equal>::Bucket {
 
     Bucket(KeyType key, HashType hash)
         : key(key)
-        , hash(hash)
+        , fingerprint(get_fingerprint(hash))
+    {
+    }
+
+    static std::uint32_t get_fingerprint(HashType hash)
     {
+        return static_cast<std::uint32_t>(hash >> 32);
     }
 
     bool full() const { return key != empty_bucket_key; }
@@ -183,7 +204,7 @@ void IntHashSet<Hasher, Equal>::rehash(int new_capacity)
     buckets.resize(new_capacity);
     for (const Bucket& bucket : old_buckets) {
         if (bucket.full()) {
-            insert(bucket.key, bucket.hash);
+            insert(bucket.key, hasher(bucket.key));
         }
     }
     (void)num_entries_before;
@@ -219,7 +240,7 @@ int IntHashSet<Hasher, Equal>::get_bucket(HashType hash) const
     assert((num_buckets & (num_buckets - 1)) == 0);
     /* We want to return hash % num_buckets. The following line does this
         because we know that num_buckets is a power of 2. */
-    return hash & (num_buckets - 1);
+    return static_cast<int>(hash & (num_buckets - 1));
 }
 
 /*
@@ -258,7 +279,9 @@ IntHashSet<Hasher, Equal>::find_equal_key(KeyType key, HashType hash) const
     for (int i = 0; i < MAX_DISTANCE; ++i) {
         int index = get_bucket(ideal_index + i);
         const Bucket& bucket = buckets[index];
-        if (bucket.full() && bucket.hash == hash && equal(bucket.key, key)) {
+        if (bucket.full() &&
+            bucket.fingerprint == Bucket::get_fingerprint(hash) &&
+            equal(bucket.key, key)) {
             return bucket.key;
         }
     }
@@ -320,7 +343,7 @@ IntHashSet<Hasher, Equal>::insert(KeyType key, HashType hash)
             int candidate_index = free_index + num_buckets - offset;
             assert(candidate_index >= 0);
             candidate_index = get_bucket(candidate_index);
-            HashType candidate_hash = buckets[candidate_index].hash;
+            HashType candidate_hash = hasher(buckets[candidate_index].key);
             int candidate_ideal_index = get_bucket(candidate_hash);
             if (get_distance(candidate_ideal_index, free_index) <
                 MAX_DISTANCE) {
@@ -378,6 +401,13 @@ std::pair<KeyType, bool> IntHashSet<Hasher, Equal>::insert(KeyType key)
     return insert(key, hasher(key));
 }
 
+template <typename Hasher, typename Equal>
+KeyType IntHashSet<Hasher, Equal>::find(KeyType key) const
+{
+    assert(key >= 0);
+    return find_equal_key(key, hasher(key));
+}
+
 template <typename Hasher, typename Equal>
 void IntHashSet<Hasher, Equal>::dump(utils::LogProxy& log) const
 {
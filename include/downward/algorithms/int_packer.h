@@ -16,8 +16,20 @@
   Uses a greedy bin-packing strategy to pack the variables, which
   should be close to optimal in most cases. (See code comments for
   details.)
+
+  With Encoding::BIT_FIELDS, every variable occupies a whole number
+  of bits. Variables whose range is not a power of two waste part of
+  these bits. Encoding::MIXED_RADIX instead stores the values of all
+  variables in a bin as one number in a mixed-radix system, i.e., the
+  variables of a bin with ranges r_1, ..., r_k need only
+  log2(r_1 * ... * r_k) bits together. For example, 20 variables
+  with range 3 need 40 bits as bit fields but fit into 32 bits with
+  mixed-radix ranking. Accessing a variable then costs a division
+  and a modulo operation instead of a shift and a mask.
 */
 namespace int_packer {
+enum class Encoding { BIT_FIELDS, MIXED_RADIX };
+
 class IntPacker {
     class VariableInfo;
 
@@ -27,6 +39,7 @@ class IntPacker {
     int pack_one_bin(const std::vector<int> &ranges,
                      std::vector<std::vector<int>> &bits_to_vars);
     void pack_bins(const std::vector<int> &ranges);
+    void pack_bins_mixed_radix(const std::vector<int> &ranges);
 public:
     typedef unsigned int Bin;
 
@@ -36,7 +49,8 @@ public:
       ints for the ranges (and genenerally for the values of variables),
       a variable can take up at most 31 bits if int is 32-bit.
     */
-    explicit IntPacker(const std::vector<int> &ranges);
+    explicit IntPacker(const std::vector<int> &ranges,
+                       Encoding encoding = Encoding::BIT_FIELDS);
     ~IntPacker();
 
     int get(const Bin *buffer, int var) const;
@@ -0,0 +1,117 @@
+#ifndef DOWNWARD_ALGORITHMS_MAPPED_SEGMENT_ALLOCATOR_H
+#define DOWNWARD_ALGORITHMS_MAPPED_SEGMENT_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+  Memory for SegmentedVector and SegmentedArrayVector that can be backed by a
+  memory-mapped file instead of the heap.
+
+  MappedArena maps an (unlinked) temporary file in large chunks and hands out
+  segments from them with a bump pointer. Since the mapping is shared with the
+  file, the operating system can write pages back to disk and evict them under
+  memory pressure instead of killing the process. Whenever a new chunk is
+  mapped, all but the most recent chunks are marked as cold with madvise, so
+  that the pages of old (typically closed) states are reclaimed first.
+
+  Note that mapped memory still counts towards limits on the address space
+  (e.g. ulimit -v), only the resident set is reduced.
+
+  Memory handed out by the arena is only released when the arena is destroyed.
+  This matches the segmented vectors, which never free segments before they
+  are destroyed.
+
+  SegmentAllocator is a standard allocator that allocates from an arena if it
+  has one and from the heap otherwise. Since the choice is made at runtime, the
+  same container types can be used with both kinds of memory.
+*/
+
+namespace mapped_segment_allocator {
+class MappedArena {
+    struct Chunk {
+        char* address;
+        std::size_t bytes;
+    };
+
+    const std::size_t chunk_bytes;
+    const std::size_t num_hot_chunks;
+    int file_descriptor;
+    std::size_t file_size;
+    std::vector<Chunk> chunks;
+    // Number of bytes used in the last chunk.
+    std::size_t used_bytes;
+
+    void map_chunk(std::size_t min_bytes);
+    void mark_cold_chunks();
+
+public:
+    /*
+      Create an arena backed by a temporary file in the given directory.
+      chunk_bytes is rounded up to a multiple of the page size.
+    */
+    explicit MappedArena(
+        const std::string& directory,
+        std::size_t chunk_bytes = 64 << 20,
+        std::size_t num_hot_chunks = 2);
+    ~MappedArena();
+
+    MappedArena(const MappedArena&) = delete;
+    MappedArena& operator=(const MappedArena&) = delete;
+
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    std::size_t get_mapped_bytes() const;
+    // Number of mapped bytes that are currently in physical memory.
+    std::size_t get_resident_bytes() const;
+};
+
+template <class T>
+class SegmentAllocator {
+    template <class U>
+    friend class SegmentAllocator;
+
+    std::shared_ptr<MappedArena> arena;
+
+public:
+    using value_type = T;
+
+    SegmentAllocator() = default;
+
+    explicit SegmentAllocator(std::shared_ptr<MappedArena> arena)
+        : arena(std::move(arena))
+    {
+    }
+
+    template <class U>
+    SegmentAllocator(const SegmentAllocator<U>& other)
+        : arena(other.arena)
+    {
+    }
+
+    T* allocate(std::size_t n)
+    {
+        if (!arena) return std::allocator<T>().allocate(n);
+        return static_cast<T*>(arena->allocate(n * sizeof(T), alignof(T)));
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        // Arena memory is released together with the arena.
+        if (!arena) std::allocator<T>().deallocate(p, n);
+    }
+
+    const std::shared_ptr<MappedArena>& get_arena() const { return arena; }
+
+    template <class U>
+    friend bool
+    operator==(const SegmentAllocator& lhs, const SegmentAllocator<U>& rhs)
+    {
+        return lhs.arena == rhs.get_arena();
+    }
+};
+} // namespace mapped_segment_allocator
+
+#endif
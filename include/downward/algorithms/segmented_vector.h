@@ -200,11 +200,11 @@ public:
 
 
     SegmentedArrayVector(size_t elements_per_array_, const ElementAllocator &allocator_)
-        : element_allocator(allocator_),
-          elements_per_array(elements_per_array_),
+        : elements_per_array(elements_per_array_),
           arrays_per_segment(
               std::max(SEGMENT_BYTES / (elements_per_array * sizeof(Element)), size_t(1))),
           elements_per_segment(elements_per_array * arrays_per_segment),
+          element_allocator(allocator_),
           the_size(0) {
     }
 
@@ -254,6 +254,26 @@ public:
         ++the_size;
     }
 
+    /*
+      Append an array with all elements set to value and return a pointer to
+      it, so that callers can fill the new array in place instead of copying
+      it from a temporary buffer.
+    */
+    Element *push_back_filled(const Element &value) {
+        size_t segment = get_segment(the_size);
+        size_t offset = get_offset(the_size);
+        if (segment == segments.size()) {
+            assert(offset == 0);
+            // Must add a new segment.
+            add_segment();
+        }
+        Element *dest = segments[segment] + offset;
+        for (size_t i = 0; i < elements_per_array; ++i)
+            ATraits::construct(element_allocator, dest + i, value);
+        ++the_size;
+        return dest;
+    }
+
     void pop_back() {
         for (size_t offset = 0; offset < elements_per_array; ++offset) {
             ATraits::destroy(
@@ -21,6 +21,22 @@ public:
     virtual void print() const override;
 };
 
+/*
+  Options that control how the task is read. They are needed before the
+  task is read and thus before the rest of the command line is parsed,
+  which ignores them.
+*/
+struct TaskInputOptions {
+    // Read the task from this binary task file instead of standard input.
+    std::string binary_task_filename;
+    // Write the task that was read to this binary task file.
+    std::string write_binary_task_filename;
+    // Number of threads for parsing the operators of the translator output.
+    int sas_parser_threads = 1;
+};
+
+extern TaskInputOptions parse_task_input_options(int argc, const char** argv);
+
 extern std::shared_ptr<SearchAlgorithm> parse_cmd_line(
     int argc,
     const char** argv,
@@ -0,0 +1,261 @@
+#ifndef DOWNWARD_CONCURRENT_STATE_REGISTRY_H
+#define DOWNWARD_CONCURRENT_STATE_REGISTRY_H
+
+#include "downward/planning_task.h"
+#include "downward/state_id.h"
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "downward/algorithms/concurrent_segmented_vector.h"
+#include "downward/algorithms/int_packer.h"
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+namespace utils {
+class LogProxy;
+}
+
+/**
+ * @brief A state registry that can be shared by several threads.
+ *
+ * Like StateRegistry, this class assigns a unique ID to every distinct state
+ * that is inserted, but all methods may be called concurrently.
+ *
+ * Duplicate detection uses a lock-free open-addressing hash table. Each
+ * bucket is a single 64-bit word holding a 32-bit hash fingerprint of the
+ * state and its ID. A new state is published by a compare-and-swap on an empty bucket; the
+ * packed state data is written beforehand, so threads that find the bucket
+ * always see complete data. As in other lock-free tables for parallel state
+ * space search, the table does not grow: its capacity is derived from the
+ * maximum number of states passed on construction.
+ *
+ * The packed states are stored in a pool of fixed-size segments. Every thread
+ * claims whole segments for itself through a ThreadHandle and fills them
+ * without synchronization, so the StateID of a state is simply its position
+ * in the pool and never changes. Since every thread may leave the end of its
+ * last segment unused, the IDs are not consecutive. Use get_id_bound() as an
+ * upper bound when iterating over IDs.
+ *
+ * Registered states are identified by StateIDs only; use
+ * ConcurrentPerStateInformation to associate information with them.
+ *
+ * @see ConcurrentPerStateInformation
+ *
+ * @ingroup downward
+ */
+class ConcurrentStateRegistry {
+public:
+    /**
+     * @brief A per-thread view of the registry that is used for insertions.
+     *
+     * Handles must not be shared between threads.
+     */
+    class ThreadHandle {
+        friend class ConcurrentStateRegistry;
+
+        ConcurrentStateRegistry* registry;
+        // Index of the reserved, not yet registered pool slot.
+        std::size_t reserved_index;
+        // Index one past the last slot of the currently claimed segment.
+        std::size_t segment_end;
+        PackedStateBin* reserved_buffer;
+
+        explicit ThreadHandle(ConcurrentStateRegistry& registry);
+
+        PackedStateBin* reserve_slot();
+
+    public:
+        /**
+         * @brief Inserts the state with the given values and returns its ID.
+         */
+        StateID insert_state(std::span<const int> values);
+
+        /**
+         * @brief Inserts the successor state obtained by applying the given
+         * effect to the registered state with ID \p predecessor_id and returns
+         * its ID.
+         */
+        template <typename Effect>
+        StateID
+        get_successor_state(StateID predecessor_id, const Effect& effect_facts)
+        {
+            const PackedStateBin* predecessor =
+                registry->lookup_packed_state(predecessor_id);
+            PackedStateBin* buffer = reserve_slot();
+            std::copy_n(predecessor, registry->bins_per_state, buffer);
+            for (FactProxy effect_fact : effect_facts) {
+                FactPair effect_pair = effect_fact.get_pair();
+                registry->state_packer.set(
+                    buffer,
+                    effect_pair.var,
+                    effect_pair.value);
+            }
+            return registry->register_reserved_slot(*this);
+        }
+    };
+
+private:
+    PlanningTaskProxy task_proxy;
+    const int_packer::IntPacker& state_packer;
+    const int num_variables;
+    const int bins_per_state;
+    const std::size_t max_states;
+
+    concurrent_segmented_vector::ConcurrentSegmentedArrayVector<PackedStateBin>
+        state_data_pool;
+    std::atomic<std::size_t> num_claimed_segments;
+
+    /*
+      Bucket layout: the upper 32 bits hold a hash fingerprint, the lower 32
+      bits the state ID plus one, so that 0 marks an empty bucket.
+    */
+    std::unique_ptr<std::atomic<std::uint64_t>[]> buckets;
+    const std::size_t bucket_mask;
+    std::atomic<std::size_t> num_registered_states;
+
+    std::uint64_t compute_hash(const PackedStateBin* buffer) const;
+
+    /*
+      Look up the state stored in the given buffer. Returns the ID of the
+      registered copy, or StateID::no_state if there is none.
+    */
+    StateID find_packed_state(const PackedStateBin* buffer) const;
+
+    /*
+      Register the state in the slot reserved by the handle. If an equal state
+      is already registered, its ID is returned and the slot stays reserved
+      for the next insertion of the handle.
+    */
+    StateID register_reserved_slot(ThreadHandle& handle);
+
+    void claim_segment(ThreadHandle& handle);
+
+public:
+    /**
+     * @brief Creates a registry for at most \p max_states states.
+     *
+     * The hash table is allocated immediately and takes 16 to 32 bytes per
+     * state. Exceeding the limit terminates the planner with an out-of-memory error.
+     */
+    ConcurrentStateRegistry(
+        const PlanningTaskProxy& task_proxy,
+        std::size_t max_states);
+
+    ConcurrentStateRegistry(const ConcurrentStateRegistry&) = delete;
+    ConcurrentStateRegistry&
+    operator=(const ConcurrentStateRegistry&) = delete;
+
+    const PlanningTaskProxy& get_task_proxy() const { return task_proxy; }
+
+    int get_num_variables() const { return num_variables; }
+
+    /**
+     * @brief Returns a new handle for inserting states from the calling
+     * thread.
+     */
+    ThreadHandle create_thread_handle();
+
+    /**
+     * @brief Returns the packed data of the registered state with the given
+     * ID.
+     */
+    const PackedStateBin* lookup_packed_state(StateID id) const;
+
+    /**
+     * @brief Returns the values of the registered state with the given ID.
+     */
+    std::vector<int> lookup_state_values(StateID id) const;
+
+    /**
+     * @brief Returns the ID of the registered state with the given values, or
+     * StateID::no_state if no such state has been registered.
+     */
+    StateID find_state_id(std::span<const int> values) const;
+
+    /**
+     * @brief Returns the number of registered states.
+     */
+    std::size_t size() const
+    {
+        return num_registered_states.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Returns an exclusive upper bound for the values of all IDs that
+     * have been handed out so far.
+     */
+    std::size_t get_id_bound() const;
+
+    std::size_t get_max_states() const { return max_states; }
+
+    /**
+     * @brief Returns an exclusive upper bound for the values of all IDs this
+     * registry can ever hand out.
+     */
+    std::size_t get_id_capacity() const
+    {
+        return state_data_pool.get_max_arrays();
+    }
+
+    int get_state_size_in_bytes() const;
+
+    void print_statistics(utils::LogProxy& log) const;
+};
+
+/**
+ * @brief A mapping from the states of a ConcurrentStateRegistry to some type
+ * of information.
+ *
+ * Lookups of unknown states insert a default value, like for
+ * PerStateInformation. The storage grows with the lock-free protocol of
+ * ConcurrentSegmentedArrayVector, so entries may be accessed from several
+ * threads while the registry grows. Accesses to the same entry must still be
+ * synchronized by the caller, e.g. by letting only the thread that owns a
+ * state modify its entry.
+ *
+ * @see PerStateInformation
+ *
+ * @ingroup downward
+ */
+template <class Entry>
+class ConcurrentPerStateInformation {
+    const ConcurrentStateRegistry& registry;
+    const Entry default_value;
+    mutable concurrent_segmented_vector::ConcurrentSegmentedArrayVector<Entry>
+        entries;
+
+public:
+    explicit ConcurrentPerStateInformation(
+        const ConcurrentStateRegistry& registry,
+        const Entry& default_value = Entry())
+        : registry(registry)
+        , default_value(default_value)
+        , entries(1, registry.get_id_capacity(), default_value)
+    {
+    }
+
+    ConcurrentPerStateInformation(const ConcurrentPerStateInformation&) =
+        delete;
+    ConcurrentPerStateInformation&
+    operator=(const ConcurrentPerStateInformation&) = delete;
+
+    Entry& operator[](StateID id)
+    {
+        assert(id != StateID::no_state);
+        assert(static_cast<std::size_t>(id.value) < registry.get_id_bound());
+        return *entries[id.value];
+    }
+
+    const Entry& operator[](StateID id) const
+    {
+        assert(id != StateID::no_state);
+        const Entry* entry = entries.lookup(id.value);
+        return entry ? *entry : default_value;
+    }
+};
+
+#endif
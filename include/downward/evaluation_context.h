@@ -8,8 +8,6 @@
 
 #include "neuralfd/policy_cache.h"
 
-#include <unordered_map>
-
 class Evaluator;
 class SearchStatistics;
 
@@ -54,16 +52,6 @@ class EvaluationContext {
 
     static const int INVALID = -1;
 
-    EvaluationContext(
-        const EvaluatorCache& cache,
-        const PolicyCache& policy_cache,
-        const State& state,
-        int g_value,
-        bool is_preferred,
-        SearchStatistics* statistics,
-        bool calculate_preferred,
-        bool report_confidence = false);
-
 public:
     /*
       Copy existing heuristic cache and use it to look up heuristic values.
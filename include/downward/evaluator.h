@@ -3,6 +3,7 @@
 
 #include "downward/evaluation_result.h"
 
+#include "downward/algorithms/indexed_cache.h"
 #include "downward/utils/logging.h"
 
 #include <set>
@@ -18,6 +19,8 @@ class Options;
 
 class Evaluator {
     const std::string description;
+    // Small ID that is unique among the existing evaluators of its pool.
+    const indexed_cache::PooledId id;
 
 protected:
     mutable utils::LogProxy log;
@@ -26,7 +29,10 @@ public:
     explicit Evaluator(const options::Options& opts);
     explicit Evaluator(std::string description, utils::LogProxy log);
 
-    virtual ~Evaluator() = default;
+    virtual ~Evaluator();
+
+    Evaluator(const Evaluator&) = delete;
+    Evaluator& operator=(const Evaluator&) = delete;
 
     /*
       dead_ends_are_reliable should return true if the evaluator is
@@ -88,6 +94,13 @@ public:
     void report_new_minimum_value(const EvaluationResult& result) const;
 
     const std::string& get_description() const;
+    /*
+      IDs are dense and reused after an evaluator is destroyed, so they can
+      index arrays of per-evaluator data (see EvaluatorCache). Such data
+      must be tagged with the serial number, which is never reused.
+    */
+    int get_id() const { return id.get_id(); }
+    std::uint64_t get_serial() const { return id.get_serial(); }
 
     virtual bool does_cache_estimates() const;
     virtual bool is_estimate_cached(const State& state) const;
@@ -98,6 +111,22 @@ public:
     virtual int get_cached_estimate(const State& state) const;
 };
 
+/*
+  While an EvaluatorIdScope exists, the evaluators that the current thread
+  creates take their IDs from a new pool, so their IDs start at 0 again.
+  Use this for independent copies of an evaluator tree, e.g. one per
+  thread of a parallel search, to keep the IDs in each copy small. The
+  IDs of evaluators from different pools can coincide, so evaluators from
+  different pools should not be evaluated in the same EvaluationContext:
+  this is still correct, but they evict each other's cached results.
+*/
+class EvaluatorIdScope {
+    indexed_cache::IdPoolScope scope;
+
+public:
+    EvaluatorIdScope();
+};
+
 extern void add_evaluator_options_to_parser(options::OptionParser& parser);
 
 #endif
@@ -3,17 +3,17 @@
 
 #include "downward/evaluation_result.h"
 
-#include <unordered_map>
+#include "downward/algorithms/indexed_cache.h"
 
 class Evaluator;
 
-using EvaluationResults = std::unordered_map<Evaluator*, EvaluationResult>;
-
 /*
-  Store evaluation results for evaluators.
+  Store evaluation results for evaluators, indexed by the evaluator IDs.
+  Results of the first eight evaluators are stored inline, which covers
+  typical configurations without any heap allocation.
 */
 class EvaluatorCache {
-    EvaluationResults eval_results;
+    indexed_cache::IndexedCache<Evaluator, EvaluationResult, 8> eval_results;
 
 public:
     EvaluationResult& operator[](Evaluator* eval);
@@ -21,11 +21,10 @@ public:
     template <class Callback>
     void for_each_evaluator_result(const Callback& callback) const
     {
-        for (const auto& element : eval_results) {
-            const Evaluator* eval = element.first;
-            const EvaluationResult& result = element.second;
-            callback(eval, result);
-        }
+        eval_results.for_each(
+            [&callback](const Evaluator* eval, const EvaluationResult& result) {
+                callback(eval, result);
+            });
     }
 };
 
@@ -2,11 +2,12 @@
 #define DOWNWARD_HEURISTIC_H
 
 #include "downward/evaluator.h"
+#include "downward/heuristic_cache.h"
 #include "downward/operator_id.h"
-#include "downward/per_state_information.h"
 #include "downward/task_proxy.h"
 
 #include "downward/algorithms/ordered_set.h"
+#include "downward/task_utils/compiled_task.h"
 
 #include <memory>
 #include <utility>
@@ -27,20 +28,6 @@ class Options;
  */
 class Heuristic : public Evaluator {
 protected:
-    struct HEntry {
-        /* dirty is conceptually a bool, but Visual C++ does not support
-           packing ints and bools together in a bitfield. */
-        int h : 31;
-        unsigned int dirty : 1;
-
-        HEntry(int h, bool dirty)
-            : h(h)
-            , dirty(dirty)
-        {
-        }
-    };
-    static_assert(sizeof(HEntry) == 4, "HEntry has unexpected size.");
-
     /*
       TODO: We might want to get rid of the preferred_operators
       attribute. It is currently only used by compute_result() and the
@@ -56,9 +43,11 @@ protected:
 
     /*
       Cache for saving h values - as soon as the cache is
-      accessed it will create entries for all existing states
+      accessed it will create entries for all existing states.
+      Only used if cache_evaluator_values is set.
     */
-    PerStateInformation<HEntry> heuristic_cache;
+    HeuristicCache<> heuristic_cache;
+    const bool cache_evaluator_values;
 
     /// The planning task for which this heuristic is computed.
     const std::shared_ptr<ClassicalTask> task;
@@ -67,11 +56,17 @@ protected:
     /// planning task.
     ClassicalTaskProxy task_proxy;
 
+    /// A flat copy of the planning task that can be read without virtual
+    /// calls in the inner loops of the heuristic computation.
+    const compiled_task::CompiledTask& compiled_task;
+
 public:
     /// Heuristic value representing positive infinity (dead end).
     static constexpr int DEAD_END = -1;
     static constexpr int NO_VALUE = -2;
-    
+    static_assert(DEAD_END == HeuristicCache<>::DEAD_END);
+    static_assert(NO_VALUE == HeuristicCache<>::NO_VALUE);
+
     explicit Heuristic(const options::Options& opts);
 
     /**
@@ -82,11 +77,15 @@ public:
      * @param log - A log proxy for logging purposes
      * @param task - The classical planning task for which the heuristic is
      * computed
+     * @param cache_estimates - Whether heuristic values of registered states
+     * are cached. Heuristics that are cheaper to recompute than to look up
+     * can turn this off.
      */
     explicit Heuristic(
         std::string description,
         utils::LogProxy log,
-        std::shared_ptr<ClassicalTask> task);
+        std::shared_ptr<ClassicalTask> task,
+        bool cache_estimates = true);
 
     virtual ~Heuristic() override;
 
@@ -109,6 +108,7 @@ public:
     virtual EvaluationResult
     compute_result(EvaluationContext& eval_context) override;
 
+    virtual bool does_cache_estimates() const override;
     virtual bool is_estimate_cached(const State& state) const override;
     virtual int get_cached_estimate(const State& state) const override;
 
@@ -0,0 +1,180 @@
+#ifndef DOWNWARD_HEURISTIC_CACHE_H
+#define DOWNWARD_HEURISTIC_CACHE_H
+
+#include "downward/per_state_information.h"
+#include "downward/state_id.h"
+
+#include "downward/algorithms/subscriber.h"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <type_traits>
+#include <unordered_map>
+
+/**
+ * @brief A compact mapping from (registered) states to heuristic values.
+ *
+ * Every state takes up a single unsigned integer of type `Code` in the cache.
+ * Its highest bit is the dirty flag of the entry and the remaining bits
+ * encode the heuristic value. Three codes are reserved for "no value",
+ * "dead end" and "value too large to be encoded". Values of the last kind
+ * are stored in a side table, which is only filled for states with very
+ * large estimates. With the default 16-bit codes, all values up to 32764
+ * are encoded directly.
+ *
+ * A lookup with operator[] resolves the slot of a state once and returns a
+ * handle through which the entry can be read and written, so that testing
+ * the cache and storing a new value costs a single lookup.
+ *
+ * @warning Like PerStateInformation, the cache may only be used with states
+ * that are registered in a StateRegistry.
+ *
+ * @tparam Code - The unsigned integer type of an entry.
+ *
+ * @see Heuristic
+ *
+ * @ingroup downward
+ */
+template <class Code = std::uint16_t>
+class HeuristicCache : public subscriber::Subscriber<StateRegistry> {
+    static_assert(std::is_unsigned_v<Code>, "Codes must be unsigned.");
+
+    static constexpr int VALUE_BITS = std::numeric_limits<Code>::digits - 1;
+    static constexpr Code DIRTY_FLAG = Code(1) << VALUE_BITS;
+    static constexpr Code VALUE_MASK = DIRTY_FLAG - 1;
+    static constexpr Code NO_VALUE_CODE = VALUE_MASK;
+    static constexpr Code DEAD_END_CODE = VALUE_MASK - 1;
+    static constexpr Code OVERFLOW_CODE = VALUE_MASK - 2;
+
+public:
+    /// Value of states without an entry in the cache.
+    static constexpr int NO_VALUE = -2;
+    /// Value of states that are recognized as dead ends.
+    static constexpr int DEAD_END = -1;
+    /// The largest heuristic value that is stored without the side table.
+    static constexpr int MAX_ENCODED_VALUE = OVERFLOW_CODE - 1;
+
+private:
+    using OverflowValues = std::map<StateID, int>;
+
+    PerStateInformation<Code> codes;
+    std::unordered_map<const StateRegistry*, OverflowValues>
+        overflow_values_by_registry;
+
+    OverflowValues& get_overflow_values(const StateRegistry* registry)
+    {
+        auto [it, inserted] = overflow_values_by_registry.try_emplace(registry);
+        if (inserted) {
+            registry->subscribe(this);
+        }
+        return it->second;
+    }
+
+    int decode(Code code, const State& state) const
+    {
+        Code value_code = code & VALUE_MASK;
+        if (value_code == NO_VALUE_CODE) {
+            return NO_VALUE;
+        } else if (value_code == DEAD_END_CODE) {
+            return DEAD_END;
+        } else if (value_code == OVERFLOW_CODE) {
+            return overflow_values_by_registry.at(state.get_registry())
+                .at(state.get_id());
+        }
+        return value_code;
+    }
+
+    virtual void
+    notify_service_destroyed(const StateRegistry* registry) override
+    {
+        overflow_values_by_registry.erase(registry);
+    }
+
+public:
+    /**
+     * @brief A handle to the cache entry of a single state.
+     *
+     * The handle is only valid until the next state is registered in the
+     * registry of the state or the cache is destroyed.
+     */
+    class Entry {
+        HeuristicCache& cache;
+        Code& code;
+        const State& state;
+
+    public:
+        Entry(HeuristicCache& cache, Code& code, const State& state)
+            : cache(cache)
+            , code(code)
+            , state(state)
+        {
+        }
+
+        bool has_value() const
+        {
+            return (code & VALUE_MASK) != NO_VALUE_CODE;
+        }
+
+        bool is_dirty() const { return code & DIRTY_FLAG; }
+
+        /// Returns the stored heuristic value, DEAD_END or NO_VALUE.
+        int get_value() const { return cache.decode(code, state); }
+
+        /// Stores a heuristic value or DEAD_END and clears the dirty flag.
+        void set_value(int value)
+        {
+            assert(value == DEAD_END || value >= 0);
+            bool had_overflow = (code & VALUE_MASK) == OVERFLOW_CODE;
+            if (value > MAX_ENCODED_VALUE) {
+                cache.get_overflow_values(state.get_registry())
+                    [state.get_id()] = value;
+                code = OVERFLOW_CODE;
+                return;
+            }
+            if (had_overflow) {
+                cache.get_overflow_values(state.get_registry())
+                    .erase(state.get_id());
+            }
+            code = value == DEAD_END ? DEAD_END_CODE : static_cast<Code>(value);
+        }
+
+        /// Marks the stored value as outdated without removing it.
+        void mark_dirty() { code |= DIRTY_FLAG; }
+    };
+
+    HeuristicCache()
+        : codes(NO_VALUE_CODE | DIRTY_FLAG)
+    {
+    }
+
+    // May not be copied.
+    HeuristicCache(const HeuristicCache&) = delete;
+    HeuristicCache& operator=(const HeuristicCache&) = delete;
+
+    /**
+     * @brief Look up the entry of a state, creating an empty dirty entry if
+     * the state has none yet.
+     *
+     * @warning The state must be registered with a StateRegistry.
+     */
+    Entry operator[](const State& state)
+    {
+        return Entry(*this, codes[state], state);
+    }
+
+    /**
+     * @brief Returns the value stored for a state (or NO_VALUE) without
+     * creating an entry for it.
+     *
+     * @warning The state must be registered with a StateRegistry.
+     */
+    int get_value(const State& state) const
+    {
+        const PerStateInformation<Code>& const_codes = codes;
+        return decode(const_codes[state], state);
+    }
+};
+
+#endif
@@ -29,7 +29,8 @@ public:
     BlindSearchHeuristic(const options::Options& opts);
     BlindSearchHeuristic(
         std::shared_ptr<ClassicalTask> task,
-        utils::LogProxy log = utils::get_silent_log());
+        utils::LogProxy log = utils::get_silent_log(),
+        bool cache_estimates = true);
 
     virtual int compute_heuristic(const State& ancestor_state) override;
 };
@@ -37,7 +37,8 @@ public:
     CliquesHeuristic(
         std::shared_ptr<ClassicalTask> task,
         PatternCollection patterns,
-        utils::LogProxy log = utils::get_silent_log());
+        utils::LogProxy log = utils::get_silent_log(),
+        bool cache_estimates = true);
 
     virtual int compute_heuristic(const State& ancestor_state) override;
 };
@@ -38,7 +38,8 @@ public:
     explicit FFHeuristic(const options::Options& opts);
     FFHeuristic(
         std::shared_ptr<ClassicalTask> task,
-        utils::LogProxy log = utils::get_silent_log());
+        utils::LogProxy log = utils::get_silent_log(),
+        bool cache_estimates = true);
 
     int compute_heuristic(const State& ancestor_state) override;
 
@@ -34,7 +34,8 @@ public:
     explicit HSPMaxHeuristic(const options::Options& opts);
     HSPMaxHeuristic(
         std::shared_ptr<ClassicalTask> task,
-        utils::LogProxy log = utils::get_silent_log());
+        utils::LogProxy log = utils::get_silent_log(),
+        bool cache_estimates = true);
 
     virtual int compute_heuristic(const State& ancestor_state) override;
 };
@@ -45,7 +45,8 @@ public:
     PDBHeuristic(
         std::shared_ptr<ClassicalTask> task,
         Pattern pattern,
-        utils::LogProxy log = utils::get_silent_log());
+        utils::LogProxy log = utils::get_silent_log(),
+        bool cache_estimates = true);
 
     int compute_heuristic(const State& ancestor_state) override;
     bool is_abstract_goal_state(const SyntacticProjection projection, const State& state);
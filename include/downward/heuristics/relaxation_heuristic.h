@@ -12,7 +12,8 @@ public:
     RelaxationHeuristic(
         std::string description,
         std::shared_ptr<ClassicalTask> task,
-        utils::LogProxy log);
+        utils::LogProxy log,
+        bool cache_estimates = true);
 
     virtual bool dead_ends_are_reliable() const override { return true; }
 };
@@ -0,0 +1,32 @@
+#ifndef DOWNWARD_OPEN_LISTS_ALTERNATION_OPEN_LIST_H
+#define DOWNWARD_OPEN_LISTS_ALTERNATION_OPEN_LIST_H
+
+#include "downward/open_list_factory.h"
+#include "downward/option_parser_util.h"
+
+/*
+  Open list that alternates between several sublists. Every entry is
+  inserted into all sublists (which may reject it, e.g. if they only accept
+  preferred entries), and remove_min takes the next entry from the non-empty
+  sublist with the lowest priority value. Every removal increases the
+  priority value of the sublist by one, which results in round-robin
+  selection.
+
+  On search progress, boost_preferred decreases the priority values of all
+  sublists that only contain preferred entries by the boost amount, so that
+  they are selected for the next "boost" removals.
+*/
+namespace alternation_open_list {
+class AlternationOpenListFactory : public OpenListFactory {
+    Options options;
+
+public:
+    explicit AlternationOpenListFactory(const Options& options);
+    virtual ~AlternationOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+} // namespace alternation_open_list
+
+#endif
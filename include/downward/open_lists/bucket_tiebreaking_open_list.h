@@ -0,0 +1,36 @@
+#ifndef DOWNWARD_OPEN_LISTS_BUCKET_TIEBREAKING_OPEN_LIST_H
+#define DOWNWARD_OPEN_LISTS_BUCKET_TIEBREAKING_OPEN_LIST_H
+
+#include "downward/open_list_factory.h"
+#include "downward/option_parser_util.h"
+
+/*
+  Open list with the same semantics as the tie-breaking open list (entries
+  are ordered lexicographically by the values of the given evaluators, ties
+  are broken in FIFO order), specialized at compile time for one, two and
+  three evaluators.
+
+  Instead of a map from key vectors to buckets, entries are stored in nested
+  bucket arrays indexed by the evaluator values, so that insertion and
+  removal take amortized constant time and do not allocate memory once the
+  buckets have grown to their working size. Negative and very large
+  evaluator values (including infinity) are stored in an ordered map at the
+  respective level instead.
+
+  For more than three evaluators, the factory falls back to the regular
+  tie-breaking open list.
+*/
+namespace bucket_tiebreaking_open_list {
+class BucketTieBreakingOpenListFactory : public OpenListFactory {
+    Options options;
+
+public:
+    explicit BucketTieBreakingOpenListFactory(const Options& options);
+    virtual ~BucketTieBreakingOpenListFactory() override = default;
+
+    virtual std::unique_ptr<StateOpenList> create_state_open_list() override;
+    virtual std::unique_ptr<EdgeOpenList> create_edge_open_list() override;
+};
+} // namespace bucket_tiebreaking_open_list
+
+#endif
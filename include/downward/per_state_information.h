@@ -3,6 +3,7 @@
 
 #include "downward/state_registry.h"
 
+#include "downward/algorithms/mapped_segment_allocator.h"
 #include "downward/algorithms/segmented_vector.h"
 #include "downward/algorithms/subscriber.h"
 #include "downward/utils/collections.h"
@@ -34,13 +35,19 @@
 template <class Entry>
 class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
     const Entry default_value;
-    using EntryVectorMap = std::unordered_map<
-        const StateRegistry*,
-        std::unique_ptr<segmented_vector::SegmentedVector<Entry>>>;
+    /*
+      The entries for a registry are allocated from the same memory as the
+      states of the registry (see StateStorage).
+    */
+    using EntryVector = segmented_vector::SegmentedVector<
+        Entry,
+        mapped_segment_allocator::SegmentAllocator<Entry>>;
+    using EntryVectorMap = std::
+        unordered_map<const StateRegistry*, std::unique_ptr<EntryVector>>;
     EntryVectorMap entries_by_registry;
 
     mutable const StateRegistry* cached_registry;
-    mutable segmented_vector::SegmentedVector<Entry>* cached_entries;
+    mutable EntryVector* cached_entries;
 
     /*
       Returns the SegmentedVector associated with the given StateRegistry.
@@ -48,14 +55,15 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       created. Both the registry and the returned vector are cached to speed up
       consecutive calls with the same registry.
     */
-    segmented_vector::SegmentedVector<Entry>*
-    get_entries(const StateRegistry* registry)
+    EntryVector* get_entries(const StateRegistry* registry)
     {
         if (cached_registry != registry) {
             cached_registry = registry;
             auto it = entries_by_registry.find(registry);
             if (it == entries_by_registry.end()) {
-                cached_entries = new segmented_vector::SegmentedVector<Entry>();
+                mapped_segment_allocator::SegmentAllocator<Entry> allocator(
+                    registry->get_mapped_memory());
+                cached_entries = new EntryVector(allocator);
                 entries_by_registry.emplace(registry, cached_entries);
                 registry->subscribe(this);
             } else {
@@ -74,8 +82,7 @@ class PerStateInformation : public subscriber::Subscriber<StateRegistry> {
       Otherwise, both the registry and the returned vector are cached to speed
       up consecutive calls with the same registry.
     */
-    const segmented_vector::SegmentedVector<Entry>*
-    get_entries(const StateRegistry* registry) const
+    const EntryVector* get_entries(const StateRegistry* registry) const
     {
         if (cached_registry != registry) {
             const auto it = entries_by_registry.find(registry);
@@ -119,8 +126,7 @@ public:
                       << "unregistered state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        segmented_vector::SegmentedVector<Entry>* entries =
-            get_entries(registry);
+        EntryVector* entries = get_entries(registry);
         int state_id = state.get_id().value;
         assert(state.get_id() != StateID::no_state);
         size_t virtual_size = registry->size();
@@ -144,8 +150,7 @@ public:
                       << "unregistered state." << std::endl;
             utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
         }
-        const segmented_vector::SegmentedVector<Entry>* entries =
-            get_entries(registry);
+        const EntryVector* entries = get_entries(registry);
         if (!entries) {
             return default_value;
         }
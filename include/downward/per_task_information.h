@@ -64,6 +64,17 @@ public:
         return *entries[id];
     }
 
+    /*
+      Set the entry of a task explicitly, e.g., to an object loaded from a
+      file instead of one created by the entry constructor.
+    */
+    void set(const PlanningTaskProxy& task_proxy, std::unique_ptr<Entry> entry)
+    {
+        TaskID id = task_proxy.get_id();
+        if (!entries.count(id)) task_proxy.subscribe_to_task_destruction(this);
+        entries[id] = std::move(entry);
+    }
+
     virtual void notify_service_destroyed(const PlanningTask* task) override
     {
         TaskID id = PlanningTaskProxy(*task).get_id();
@@ -10,8 +10,12 @@
 #include "downward/state_registry.h"
 #include "downward/task_proxy.h"
 
+#include "downward/task_utils/compiled_task.h"
+#include "downward/task_utils/successor_generator.h"
 #include "downward/utils/logging.h"
 
+#include <iosfwd>
+#include <string>
 #include <vector>
 
 namespace options {
@@ -24,12 +28,9 @@ template <typename T>
 class OrderedSet;
 }
 
-namespace successor_generator {
-class SuccessorGenerator;
-}
-
 namespace utils {
 class CountdownTimer;
+class JsonWriter;
 } // namespace utils
 
 enum SearchStatus { IN_PROGRESS, TIMEOUT, FAILED, SOLVED };
@@ -52,6 +53,8 @@ protected:
     PlanManager plan_manager;
     StateRegistry state_registry;
     const successor_generator::SuccessorGenerator& successor_generator;
+    // Flat copy of the task for the hot loops of the search.
+    const compiled_task::CompiledTask& compiled_task;
     SearchSpace search_space;
     SearchProgress search_progress;
     SearchStatistics statistics;
@@ -62,12 +65,21 @@ protected:
 
     std::unique_ptr<utils::CountdownTimer> timer;
 
+    // JSON statistics file and interval between snapshots (in seconds).
+    std::string statistics_file;
+    double statistics_snapshot_interval;
+    double next_statistics_snapshot;
+
     virtual void initialize() {}
     virtual SearchStatus step() = 0;
 
     void set_plan(const Plan& plan);
     bool check_goal_and_set_plan(const State& state);
     int get_adjusted_cost(const OperatorProxy& op) const;
+    int get_adjusted_cost(OperatorID op) const
+    {
+        return compiled_task.get_adjusted_cost(op, cost_type);
+    }
 
 public:
     SearchAlgorithm(const options::Options& opts);
@@ -76,15 +88,43 @@ public:
         utils::LogProxy log,
         OperatorCost cost_type,
         double max_time,
-        int bound);
+        int bound,
+        SearchNodeStorage node_storage = SearchNodeStorage::STRUCT,
+        std::shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory =
+            nullptr,
+        int_packer::Encoding state_encoding =
+            int_packer::Encoding::BIT_FIELDS,
+        successor_generator::Representation
+            successor_generator_representation =
+                successor_generator::Representation::TREE);
     virtual ~SearchAlgorithm();
     virtual void print_statistics() const = 0;
     virtual void save_plan_if_necessary();
+    /*
+      Write the search statistics as JSON. Derived classes can extend the
+      object by overriding write_statistics_json and calling the base
+      version first.
+    */
+    virtual void write_statistics_json(utils::JsonWriter& json) const;
+    void write_statistics_json(std::ostream& os) const;
+    /*
+      Set the statistics file and snapshot interval from the options added
+      in add_options_to_parser. Algorithms built with the explicit
+      constructor must call this themselves.
+    */
+    void read_statistics_options(const options::Options& opts);
+    // Write the statistics to the statistics file if one was given.
+    void save_statistics_if_necessary() const;
     bool found_solution() const;
     SearchStatus get_status() const;
     const Plan& get_plan() const;
     const State get_goal_state() const;
     const StateRegistry& get_state_registry() const;
+    // Searches with several registries report the states of all of them.
+    virtual std::size_t get_num_registered_states() const
+    {
+        return state_registry.size();
+    }
     const SearchSpace& get_search_space() const;
     const ClassicalTaskProxy& get_task_proxy() const;
     void search();
@@ -98,9 +138,30 @@ public:
     /* The following three methods should become functions as they
        do not require access to private/protected class members. */
     static void add_options_to_parser(options::OptionParser& parser);
+    /*
+      The options of add_options_to_parser in groups, so that algorithms
+      that do not use all of them only offer the options they read. The
+      common options are needed by all algorithms.
+    */
+    static void add_common_options_to_parser(options::OptionParser& parser);
+    static void
+    add_search_node_storage_option_to_parser(options::OptionParser& parser);
+    static void
+    add_state_storage_options_to_parser(options::OptionParser& parser);
+    static void
+    add_state_encoding_option_to_parser(options::OptionParser& parser);
+    static void
+    add_successor_generator_option_to_parser(options::OptionParser& parser);
     static void add_succ_order_options(options::OptionParser& parser);
 };
 
+/*
+  Create the arena for the states of a search as selected by the options added
+  in SearchAlgorithm::add_options_to_parser. Returns null for heap storage.
+*/
+extern std::shared_ptr<mapped_segment_allocator::MappedArena>
+create_mapped_state_storage(const options::Options& opts);
+
 /*
   Print evaluator values of all evaluators evaluated in the evaluation context.
 */
@@ -0,0 +1,120 @@
+#ifndef DOWNWARD_SEARCH_ALGORITHMS_ANYTIME_ASTAR_SEARCH_H
+#define DOWNWARD_SEARCH_ALGORITHMS_ANYTIME_ASTAR_SEARCH_H
+
+#include "downward/per_state_information.h"
+#include "downward/search_algorithm.h"
+
+#include <memory>
+#include <queue>
+#include <utility>
+#include <vector>
+
+class Evaluator;
+
+namespace options {
+class OptionParser;
+class Options;
+} // namespace options
+
+namespace anytime_astar_search {
+/*
+  Anytime repairing A* (ARA*, Likhachev, Gordon and Thrun, 2003).
+
+  Runs weighted A* with f = g + w * h for a decreasing sequence of weights
+  w. Every iteration continues from the search space of the previous one:
+  states that were reached more cheaply after their expansion in the
+  current iteration are collected as inconsistent and only re-expanded in
+  the next iteration, and at the start of each iteration the open list is
+  reordered with the new weight. Heuristic values come from the evaluator
+  caches, so no state is evaluated from scratch twice.
+
+  Whenever a goal state is reached on a path that is cheaper than the best
+  plan found so far, the new plan is saved right away, so an interrupted
+  search still leaves its best plan behind. An iteration ends when no open
+  state has a smaller f value than the cost of the best plan. That plan
+  then costs at most w times the optimal cost. With a consistent
+  heuristic, the plan after the iteration with w = 1 is optimal.
+*/
+class AnytimeAStarSearch : public SearchAlgorithm {
+    struct OpenEntry {
+        int f;
+        int h;
+        int g;
+        StateID id;
+    };
+
+    struct OpenEntryCompare {
+        bool operator()(const OpenEntry& lhs, const OpenEntry& rhs) const
+        {
+            if (lhs.f != rhs.f) return lhs.f > rhs.f;
+            return lhs.h > rhs.h;
+        }
+    };
+
+    using OpenList = std::
+        priority_queue<OpenEntry, std::vector<OpenEntry>, OpenEntryCompare>;
+
+    std::shared_ptr<Evaluator> evaluator;
+    const std::vector<int> weights;
+
+    OpenList open_list;
+    // States reached more cheaply after their expansion in this iteration.
+    std::vector<std::pair<StateID, int>> inconsistent_states;
+    PerStateInformation<int> expansion_iteration;
+
+    int iteration;
+    // The cheapest goal state reached so far and the cost of its plan.
+    StateID incumbent_id;
+    int incumbent_cost;
+    // Cost of the last saved plan and real costs of all saved plans.
+    int published_cost;
+    std::vector<int> plan_costs;
+
+    int get_weight() const { return weights[iteration]; }
+    void insert(StateID id, int g, int h);
+    bool prune_stale_entries();
+    void start_next_iteration();
+    void publish_incumbent();
+    int evaluate(const State& state, int g);
+    void handle_goal(const State& state, int g);
+    void expand(const OpenEntry& entry);
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit AnytimeAStarSearch(const options::Options& opts);
+    AnytimeAStarSearch(
+        std::shared_ptr<ClassicalTask> task,
+        utils::LogProxy log,
+        OperatorCost cost_type,
+        double max_time,
+        int bound,
+        std::shared_ptr<Evaluator> evaluator,
+        std::vector<int> weights,
+        SearchNodeStorage node_storage = SearchNodeStorage::STRUCT,
+        std::shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory =
+            nullptr,
+        int_packer::Encoding state_encoding =
+            int_packer::Encoding::BIT_FIELDS,
+        successor_generator::Representation
+            successor_generator_representation =
+                successor_generator::Representation::TREE);
+    virtual ~AnytimeAStarSearch() override = default;
+
+    /*
+      Plans are saved as soon as they are found. This only saves the
+      incumbent again if its path became cheaper since then, e.g. when the
+      search was interrupted.
+    */
+    virtual void save_plan_if_necessary() override;
+
+    virtual void write_statistics_json(utils::JsonWriter& json) const override;
+    virtual void print_statistics() const override;
+};
+
+extern void add_options_to_parser(options::OptionParser& parser);
+} // namespace anytime_astar_search
+
+#endif
@@ -45,7 +45,15 @@ public:
         std::unique_ptr<StateOpenList> open_list,
         std::shared_ptr<Evaluator> f_eval,
         std::vector<std::shared_ptr<Evaluator>> preferred,
-        std::shared_ptr<Evaluator> lazy_evaluator);
+        std::shared_ptr<Evaluator> lazy_evaluator,
+        SearchNodeStorage node_storage = SearchNodeStorage::STRUCT,
+        std::shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory =
+            nullptr,
+        int_packer::Encoding state_encoding =
+            int_packer::Encoding::BIT_FIELDS,
+        successor_generator::Representation
+            successor_generator_representation =
+                successor_generator::Representation::TREE);
     virtual ~EagerSearch() = default;
 
     virtual void print_statistics() const override;
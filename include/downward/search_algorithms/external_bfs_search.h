@@ -0,0 +1,174 @@
+#ifndef DOWNWARD_SEARCH_ALGORITHMS_EXTERNAL_BFS_SEARCH_H
+#define DOWNWARD_SEARCH_ALGORITHMS_EXTERNAL_BFS_SEARCH_H
+
+#include "downward/search_algorithm.h"
+
+#include "downward/algorithms/int_packer.h"
+#include "downward/utils/timer.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace options {
+class OptionParser;
+class Options;
+} // namespace options
+
+namespace external_bfs_search {
+using Bin = int_packer::IntPacker::Bin;
+
+struct IOStatistics {
+    long long bytes_read = 0;
+    long long bytes_written = 0;
+    // Time spent in reading and writing files.
+    utils::Timer timer{true};
+};
+
+/*
+  Files of packed states, i.e., records of a fixed number of bins in the
+  encoding of the state packer. The writer and reader transfer data in
+  large blocks, so that all accesses to the disk are sequential.
+*/
+class PackedStateWriter {
+    std::FILE* file;
+    const int num_bins;
+    std::vector<Bin> buffer;
+    long long num_states;
+    IOStatistics& io_statistics;
+
+    void flush();
+
+public:
+    PackedStateWriter(
+        const std::string& path,
+        int num_bins,
+        IOStatistics& io_statistics);
+    ~PackedStateWriter();
+
+    PackedStateWriter(const PackedStateWriter&) = delete;
+    PackedStateWriter& operator=(const PackedStateWriter&) = delete;
+
+    void write(const Bin* state);
+    long long get_num_states() const { return num_states; }
+};
+
+class PackedStateReader {
+    std::FILE* file;
+    const int num_bins;
+    std::vector<Bin> buffer;
+    // Position of the current state in the buffer.
+    std::size_t position;
+    IOStatistics& io_statistics;
+
+    void fill();
+
+public:
+    PackedStateReader(
+        const std::string& path,
+        int num_bins,
+        IOStatistics& io_statistics);
+    ~PackedStateReader();
+
+    PackedStateReader(const PackedStateReader&) = delete;
+    PackedStateReader& operator=(const PackedStateReader&) = delete;
+
+    // Return the current state or nullptr if all states have been read.
+    const Bin* get() const
+    {
+        return position < buffer.size() ? &buffer[position] : nullptr;
+    }
+    void advance();
+};
+
+/*
+  Breadth-first search with delayed duplicate detection (Korf, 2003) that
+  keeps its layers on disk instead of registering states in memory.
+
+  Layer d + 1 is generated by streaming the states of layer d from disk.
+  Successors are collected in a buffer of bounded size, which is sorted and
+  written to disk as a run whenever it is full. When all states of layer d
+  are expanded, the runs are merged, which removes duplicates within the
+  new layer, and the result is merged with the sorted previous layers to
+  remove states that have been reached before. All layers are sorted, so
+  each of these passes reads every file once from start to end.
+
+  Memory only holds the successor buffer and one block per open file, so
+  the size of the state space is limited by the disk rather than by memory.
+  A plan is reconstructed from the layer files by searching each layer for
+  a predecessor of the next state on the plan, so all layers stay on disk
+  until the search ends. The layers are plain arrays of packed states in
+  the encoding of the state_encoding option and can be kept as a record of
+  all reachable states and their distances from the initial state.
+*/
+class ExternalBFSSearch : public SearchAlgorithm {
+    const std::string directory;
+    const int locality;
+    const bool keep_layers;
+    const int_packer::IntPacker& state_packer;
+    const int num_bins;
+    const std::size_t max_buffered_states;
+    std::vector<FactPair> goals;
+
+    IOStatistics io_statistics;
+    long long bytes_on_disk;
+    long long peak_bytes_on_disk;
+
+    // Number of states in each layer written so far.
+    std::vector<long long> layer_sizes;
+    int current_layer;
+    std::unique_ptr<PackedStateReader> layer_reader;
+    std::vector<Bin> successor_buffer;
+    // Number of states in each sorted run of the layer being generated.
+    std::vector<long long> run_sizes;
+    std::vector<Bin> goal_state;
+
+    std::vector<int> values;
+    std::vector<OperatorID> applicable_ops;
+
+    std::string get_layer_path(int layer) const;
+    std::string get_run_path(int run) const;
+    void remove_file(const std::string& path, long long num_states);
+    bool is_goal(const Bin* state) const;
+    bool less(const Bin* lhs, const Bin* rhs) const;
+    bool equal(const Bin* lhs, const Bin* rhs) const;
+    void generate_applicable_ops(const Bin* state);
+    void apply(OperatorID op_id, Bin* state) const;
+
+    void expand(const Bin* state);
+    void write_run();
+    void merge_runs();
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit ExternalBFSSearch(const options::Options& opts);
+    ExternalBFSSearch(
+        std::shared_ptr<ClassicalTask> task,
+        utils::LogProxy log,
+        OperatorCost cost_type,
+        double max_time,
+        int bound,
+        int_packer::Encoding state_encoding,
+        const std::string& directory,
+        int buffer_size_in_mb,
+        int locality,
+        bool keep_layers,
+        successor_generator::Representation
+            successor_generator_representation =
+                successor_generator::Representation::TREE);
+    virtual ~ExternalBFSSearch() override;
+
+    virtual void write_statistics_json(utils::JsonWriter& json) const override;
+    virtual void print_statistics() const override;
+};
+
+extern void add_options_to_parser(options::OptionParser& parser);
+} // namespace external_bfs_search
+
+#endif
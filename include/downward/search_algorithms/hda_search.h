@@ -0,0 +1,99 @@
+#ifndef DOWNWARD_SEARCH_ALGORITHMS_HDA_SEARCH_H
+#define DOWNWARD_SEARCH_ALGORITHMS_HDA_SEARCH_H
+
+#include "downward/search_algorithm.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+class Evaluator;
+
+namespace options {
+class OptionParser;
+class Options;
+} // namespace options
+
+namespace hda_search {
+/*
+  Hash-distributed A* (HDA*, Kishimoto, Fukunaga and Botea, 2009).
+
+  Every state is owned by exactly one worker thread, determined by a hash of
+  its variable assignment. Each worker keeps its own open list, state registry
+  and per-state search information. Successors owned by another worker are
+  sent to that worker through an asynchronous message queue, where they are
+  evaluated, checked for duplicates and inserted into the open list.
+
+  Because the threads expand nodes in parallel, a state may first be expanded
+  with a suboptimal g value. We therefore always reopen states reached on a
+  cheaper path. The search terminates once a solution of cost C has been found
+  and no worker has an open node with f < C and no message is in transit. With
+  an admissible heuristic, the solution found is then optimal.
+
+  Evaluators are generally not thread-safe, so every worker uses its own
+  evaluator instance. The caller passes one evaluator per worker. Likewise,
+  with mapped state storage every worker maps its own arena, and the
+  registry of the search itself stays empty.
+*/
+class HDASearch : public SearchAlgorithm {
+    class Worker;
+
+    const StateStorage state_storage;
+    const std::string state_storage_directory;
+    const int_packer::Encoding state_encoding;
+    std::vector<std::unique_ptr<Worker>> workers;
+
+    /*
+      Global work counter: the number of busy workers plus the number of
+      messages that have been sent but not yet processed. The search space is
+      exhausted (with respect to the incumbent) iff this reaches zero.
+    */
+    std::atomic<int> outstanding_work;
+    std::atomic<bool> terminated;
+    std::atomic<bool> timed_out;
+
+    std::mutex incumbent_mutex;
+    std::atomic<int> incumbent_cost;
+    int goal_worker;
+    StateID goal_id;
+
+    std::shared_ptr<mapped_segment_allocator::MappedArena>
+    create_worker_arena() const;
+    int get_owner(const std::vector<int>& values) const;
+    void report_goal(int worker_id, StateID id, int g);
+    void run_worker(int worker_id);
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    HDASearch(
+        std::shared_ptr<ClassicalTask> task,
+        utils::LogProxy log,
+        OperatorCost cost_type,
+        double max_time,
+        int bound,
+        const std::vector<std::shared_ptr<Evaluator>>& evaluators,
+        StateStorage state_storage = StateStorage::HEAP,
+        const std::string& state_storage_directory = ".",
+        int_packer::Encoding state_encoding =
+            int_packer::Encoding::BIT_FIELDS,
+        successor_generator::Representation
+            successor_generator_representation =
+                successor_generator::Representation::TREE);
+    virtual ~HDASearch() override;
+
+    int get_num_threads() const;
+    virtual std::size_t get_num_registered_states() const override;
+
+    virtual void print_statistics() const override;
+};
+
+extern void add_options_to_parser(options::OptionParser& parser);
+} // namespace hda_search
+
+#endif
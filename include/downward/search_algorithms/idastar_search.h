@@ -0,0 +1,141 @@
+#ifndef DOWNWARD_SEARCH_ALGORITHMS_IDASTAR_SEARCH_H
+#define DOWNWARD_SEARCH_ALGORITHMS_IDASTAR_SEARCH_H
+
+#include "downward/search_algorithm.h"
+
+#include "downward/utils/hash.h"
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace options {
+class OptionParser;
+class Options;
+} // namespace options
+
+namespace idastar_search {
+/*
+  Fixed-size, direct-mapped table that remembers the cheapest g value with
+  which a state has been reached in the current iteration. States are
+  identified by a 64-bit hash of their variable assignment, and colliding
+  entries simply overwrite each other, so the table never grows.
+*/
+class TranspositionTable {
+    struct Entry {
+        std::uint64_t key;
+        int g;
+        int iteration;
+    };
+    static_assert(sizeof(Entry) == 16, "Entry has unexpected size.");
+
+    std::vector<Entry> entries;
+    long long num_hits;
+
+    Entry& get_entry(std::uint64_t key)
+    {
+        return entries[key % entries.size()];
+    }
+
+public:
+    explicit TranspositionTable(int size_in_mb);
+
+    /*
+      Return true iff the state with the given key has already been reached
+      with a g value of at most g in the given iteration. Otherwise, record g
+      for the state and return false.
+    */
+    bool check_and_update(std::uint64_t key, int g, int iteration);
+    // Like check_and_update, but without recording g.
+    bool check(std::uint64_t key, int g, int iteration);
+
+    std::size_t size() const { return entries.size(); }
+    long long get_num_hits() const { return num_hits; }
+};
+
+/*
+  Iterative deepening A* (Korf, 1985).
+
+  A sequence of depth-first searches that prune nodes with f = g + h above the
+  current f bound. Each iteration raises the bound to the smallest f value
+  pruned in the previous one, so with an admissible heuristic the first plan
+  found is optimal. States are not registered in the state registry: the
+  search only keeps the current path and, for each state on it, the successors
+  that are still to be explored. Cycles on the current path are always
+  pruned; transpositions are pruned only if the optional transposition table
+  is used. Successors are explored in order of increasing h value.
+
+  Each call to step() expands or backtracks from a single node, so the time
+  limit is checked regularly even within long iterations.
+*/
+class IDAStarSearch : public SearchAlgorithm {
+    struct Successor {
+        OperatorID op_id;
+        int h;
+        std::uint64_t key;
+    };
+
+    struct Frame {
+        State state;
+        // The operator that leads to this state from its parent on the path.
+        OperatorID op_id;
+        int g;
+        int real_g;
+        std::vector<Successor> successors;
+        std::size_t next_successor;
+    };
+
+    std::shared_ptr<Evaluator> evaluator;
+    std::unique_ptr<TranspositionTable> transposition_table;
+
+    std::vector<Frame> path;
+    utils::HashSet<std::vector<int>> states_on_path;
+    std::vector<OperatorID> applicable_ops;
+
+    int f_bound;
+    int next_f_bound;
+    int iteration;
+    bool initial_state_is_dead_end;
+
+    std::uint64_t get_key(const std::vector<int>& values) const;
+    void start_iteration();
+    bool push(
+        State&& state,
+        OperatorID op_id,
+        int g,
+        int real_g,
+        std::uint64_t key);
+    void pop();
+    void extract_plan();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit IDAStarSearch(const options::Options& opts);
+    IDAStarSearch(
+        std::shared_ptr<ClassicalTask> task,
+        utils::LogProxy log,
+        OperatorCost cost_type,
+        double max_time,
+        int bound,
+        std::shared_ptr<Evaluator> evaluator,
+        int transposition_table_size_in_mb,
+        successor_generator::Representation
+            successor_generator_representation =
+                successor_generator::Representation::TREE);
+    virtual ~IDAStarSearch() override;
+
+    int get_num_iterations() const { return iteration + 1; }
+
+    virtual void write_statistics_json(utils::JsonWriter& json) const override;
+    virtual void print_statistics() const override;
+};
+
+extern void add_options_to_parser(options::OptionParser& parser);
+} // namespace idastar_search
+
+#endif
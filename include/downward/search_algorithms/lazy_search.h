@@ -0,0 +1,92 @@
+#ifndef DOWNWARD_SEARCH_ALGORITHMS_LAZY_SEARCH_H
+#define DOWNWARD_SEARCH_ALGORITHMS_LAZY_SEARCH_H
+
+#include "downward/evaluation_context.h"
+#include "downward/open_list.h"
+#include "downward/search_algorithm.h"
+
+#include "downward/algorithms/ordered_set.h"
+
+#include <memory>
+#include <vector>
+
+class Evaluator;
+
+namespace options {
+class Options;
+}
+
+namespace utils {
+class RandomNumberGenerator;
+}
+
+namespace lazy_search {
+/*
+  Best-first search with deferred evaluation.
+
+  Successors are not evaluated when they are generated. Instead, the edge
+  (parent, operator) is inserted into the open list with the evaluator
+  values of the parent, and the successor state is only created and
+  evaluated when the edge is removed from the open list. This saves most
+  evaluations if the heuristic is expensive and guides the search well.
+*/
+class LazySearch : public SearchAlgorithm {
+protected:
+    std::unique_ptr<EdgeOpenList> open_list;
+
+    // Search behavior parameters
+    bool reopen_closed_nodes;
+    bool randomize_successors;
+    bool preferred_successors_first;
+    std::shared_ptr<utils::RandomNumberGenerator> rng;
+
+    std::vector<Evaluator*> path_dependent_evaluators;
+    std::vector<std::shared_ptr<Evaluator>> preferred_operator_evaluators;
+
+    State current_state;
+    StateID current_predecessor_id;
+    OperatorID current_operator_id;
+    int current_g;
+    int current_real_g;
+    EvaluationContext current_eval_context;
+
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+    void generate_successors();
+    SearchStatus fetch_next_state();
+
+    void reward_progress();
+
+    std::vector<OperatorID> get_successor_operators(
+        const ordered_set::OrderedSet<OperatorID>& preferred_operators) const;
+
+public:
+    explicit LazySearch(const options::Options& opts);
+    LazySearch(
+        std::shared_ptr<ClassicalTask> task,
+        utils::LogProxy log,
+        OperatorCost cost_type,
+        double max_time,
+        int bound,
+        bool reopen_closed,
+        std::unique_ptr<EdgeOpenList> open_list,
+        std::vector<std::shared_ptr<Evaluator>> preferred,
+        bool randomize_successors,
+        bool preferred_successors_first,
+        std::shared_ptr<utils::RandomNumberGenerator> rng,
+        SearchNodeStorage node_storage = SearchNodeStorage::STRUCT,
+        std::shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory =
+            nullptr,
+        int_packer::Encoding state_encoding =
+            int_packer::Encoding::BIT_FIELDS,
+        successor_generator::Representation
+            successor_generator_representation =
+                successor_generator::Representation::TREE);
+    virtual ~LazySearch() = default;
+
+    virtual void print_statistics() const override;
+};
+} // namespace lazy_search
+
+#endif
@@ -35,9 +35,9 @@ namespace search_common {
   Create open list factory and f_evaluator (used for displaying progress
   statistics) for A* search.
 
-  The resulting open list factory produces a tie-breaking open list
-  ordered primarily on g + h and secondarily on h. Uses "eval" from
-  the passed-in Options object as the h evaluator.
+  The resulting open list factory produces a (bucket-based) tie-breaking
+  open list ordered primarily on g + h and secondarily on h. Uses "eval"
+  from the passed-in Options object as the h evaluator.
 */
 extern std::pair<std::shared_ptr<OpenListFactory>, const std::shared_ptr<Evaluator>>
 create_astar_open_list_factory_and_f_eval(const options::Options &opts);
@@ -47,6 +47,24 @@ extern std::
     create_astar_open_list_factory_and_f_eval(
         utils::Verbosity verbosity,
         std::shared_ptr<Evaluator> evaluator);
+
+/*
+  Create open list factory for the eager_greedy or lazy_greedy plugins.
+
+  This is usually an alternation open list with:
+  - one sublist for each evaluator, considering all successors
+  - one sublist for each evaluator, considering only preferred successors
+
+  However, the preferred-only open lists are omitted if no preferred
+  operator evaluators are used, and if there would only be one sublist
+  for the alternation open list, then that sublist is returned directly.
+
+  The sublists are tie-breaking open lists with a single evaluator. Uses
+  "evals", "preferred" and "boost" from the passed-in Options object to
+  construct the open list factory.
+*/
+extern std::shared_ptr<OpenListFactory>
+create_greedy_open_list_factory(const options::Options &opts);
 } // namespace search_common
 
 #endif
@@ -4,6 +4,8 @@
 #include "downward/operator_id.h"
 #include "downward/state_id.h"
 
+#include <cstdint>
+
 // For documentation on classes relevant to storing and working with registered
 // states see the file state_registry.h.
 
@@ -26,4 +28,18 @@ struct SearchNodeInfo {
     }
 };
 
+/*
+  With the compact search node storage, the fields of a search node live in
+  separate per-state arrays. This struct points to the entries of one node.
+  The creating operator is not stored at all (it is recomputed from the
+  parent and child state when needed), and real_g is only stored if it can
+  differ from g, i.e., if the search does not use the normal cost type.
+*/
+struct CompactSearchNodeRef {
+    uint8_t* status = nullptr;
+    int* g = nullptr;
+    StateID* parent_state_id = nullptr;
+    int* real_g = nullptr;
+};
+
 #endif
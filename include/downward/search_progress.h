@@ -1,7 +1,8 @@
 #ifndef DOWNWARD_SEARCH_PROGRESS_H
 #define DOWNWARD_SEARCH_PROGRESS_H
 
-#include <unordered_map>
+#include <cstdint>
+#include <vector>
 
 class EvaluationContext;
 class Evaluator;
@@ -20,7 +21,14 @@ class LogProxy;
 
 
 class SearchProgress {
-    std::unordered_map<const Evaluator *, int> min_values;
+    struct MinValue {
+        // Serial number of the evaluator the value belongs to (0 if none).
+        std::uint64_t serial = 0;
+        int value = 0;
+    };
+
+    // Minimum value of each evaluator, indexed by evaluator ID.
+    std::vector<MinValue> min_values;
 
     bool process_evaluator_value(const Evaluator *evaluator, int value);
 
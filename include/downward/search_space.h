@@ -5,22 +5,52 @@
 #include "downward/per_state_information.h"
 #include "downward/search_node_info.h"
 
+#include <cstdint>
 #include <vector>
 
 class OperatorProxy;
 class State;
 class ClassicalTaskProxy;
 
+namespace successor_generator {
+class SuccessorGenerator;
+}
+
 namespace utils {
 class LogProxy;
 }
 
+/*
+  Memory layout of the search nodes.
+
+  STRUCT stores one SearchNodeInfo struct per state. COMPACT stores status,
+  g-value and parent pointer in separate arrays, omits real_g for the normal
+  cost type and recomputes creating operators from the parent and child
+  states when a path is traced. Only the operators that the successor
+  generator yields for the parent are considered, so this costs about as
+  much as one expansion per plan step.
+*/
+enum class SearchNodeStorage { STRUCT, COMPACT };
+
 class SearchNode {
     State state;
-    SearchNodeInfo& info;
+    // Exactly one of the following two is used, depending on the storage.
+    SearchNodeInfo* info;
+    CompactSearchNodeRef compact;
+
+    unsigned int get_status() const
+    {
+        return info ? info->status : *compact.status;
+    }
+    void set_status(SearchNodeInfo::NodeStatus status);
+    void set_path(
+        const SearchNode& parent_node,
+        const OperatorProxy& parent_op,
+        int adjusted_cost);
 
 public:
     SearchNode(const State& state, SearchNodeInfo& info);
+    SearchNode(const State& state, const CompactSearchNodeRef& compact);
 
     const State& get_state() const;
 
@@ -54,25 +84,38 @@ public:
 };
 
 class SearchSpace {
+    const SearchNodeStorage storage;
+    // Only relevant for the compact storage.
+    const bool store_real_g;
+
     PerStateInformation<SearchNodeInfo> search_node_infos;
 
+    PerStateInformation<uint8_t> node_statuses;
+    PerStateInformation<int> node_g_values;
+    PerStateInformation<StateID> node_parents;
+    PerStateInformation<int> node_real_g_values;
+
     StateRegistry& state_registry;
+    // Used to recompute creating operators for the compact storage.
+    const successor_generator::SuccessorGenerator& successor_generator;
     utils::LogProxy& log;
 
+    OperatorID
+    recompute_creating_operator(const State& parent, const State& child) const;
+
 public:
-    SearchSpace(StateRegistry& state_registry, utils::LogProxy& log);
+    SearchSpace(
+        StateRegistry& state_registry,
+        const successor_generator::SuccessorGenerator& successor_generator,
+        utils::LogProxy& log,
+        SearchNodeStorage storage = SearchNodeStorage::STRUCT,
+        OperatorCost cost_type = NORMAL);
 
     SearchNode get_node(const State& state);
 
-    StateID get_parent_id(const State& state) const
-    {
-        return search_node_infos[state].parent_state_id;
-    }
+    StateID get_parent_id(const State& state) const;
 
-    OperatorID get_creating_operator(const State& state) const
-    {
-        return search_node_infos[state].creating_operator;
-    }
+    OperatorID get_creating_operator(const State& state) const;
 
     void
     trace_path(const State& goal_state, std::vector<OperatorID>& path) const;
@@ -84,6 +127,9 @@ public:
         std::vector<OperatorID>& path,
         std::vector<StateID>& trajectory) const;
 
+    // Number of bytes used per state for storing the search node.
+    int get_node_size_in_bytes() const;
+
     void dump(const ClassicalTaskProxy& task_proxy) const;
     void print_statistics() const;
 };
@@ -9,7 +9,13 @@
   methods.
 */
 
+#include <string>
+#include <vector>
+
+class Evaluator;
+
 namespace utils {
+class JsonWriter;
 class LogProxy;
 }
 
@@ -33,7 +39,34 @@ class SearchStatistics {
     int lastjump_evaluated_states;
     int lastjump_generated_states;
 
+    // Expansions per worker thread (only set by parallel searches)
+    std::vector<int> thread_expansions;
+
+    // Only collect evaluator statistics if they are written.
+    bool time_evaluators;
+    // Calls and cumulative time of each evaluator, in order of first call.
+    struct EvaluatorStatistics {
+        const Evaluator *evaluator;
+        std::string description;
+        int calls;
+        double time;
+    };
+    std::vector<EvaluatorStatistics> evaluator_statistics;
+
+    // Counters and total time (in seconds) at every jump in the f value.
+    struct FLayer {
+        int f_value;
+        int expanded_states;
+        int evaluated_states;
+        int generated_states;
+        int reopened_states;
+        double time;
+    };
+    std::vector<FLayer> f_layers;
+
+    FLayer get_f_layer(int f) const;
     void print_f_line() const;
+    void print_thread_statistics() const;
 public:
     explicit SearchStatistics(utils::LogProxy &log);
     ~SearchStatistics() = default;
@@ -54,6 +87,27 @@ public:
     int get_generated() const {return generated_states;}
     int get_reopened() const {return reopened_states;}
     int get_generated_ops() const {return generated_ops;}
+    int get_dead_ends() const {return dead_end_states;}
+
+    /*
+      Parallel searches report how many expansions each worker thread
+      performed. We print them together with the load imbalance, i.e.,
+      the ratio of the maximum to the mean number of expansions per thread.
+    */
+    void report_thread_expansions(const std::vector<int> &expansions);
+    const std::vector<int> &get_thread_expansions() const {return thread_expansions;}
+    double get_load_imbalance() const;
+
+    /*
+      Called by EvaluationContext for every evaluator result that is
+      computed if is_timing_evaluators() holds, which is off by default
+      because it reads the clock twice per call. The time of an evaluator
+      includes the time of the evaluators it calls itself, e.g., the
+      components of a sum.
+    */
+    void set_time_evaluators(bool time) {time_evaluators = time;}
+    bool is_timing_evaluators() const {return time_evaluators;}
+    void report_evaluator_call(const Evaluator *evaluator, double seconds);
 
     /*
       Call the following method with the f value of every expanded
@@ -70,13 +124,29 @@ public:
       state space and heuristic, independently of things like the
       order in which successors are generated or the tie-breaking
       performed by the open list.)
+
+      Every jump is also recorded for the JSON output, so that the progress
+      over the f layers can be plotted.
     */
     void report_f_value_progress(int f);
     void print_checkpoint_line(int g) const;
 
+    /*
+      Add the statistics of a search over another part of the state space,
+      e.g., of a worker thread of a parallel search. Evaluators are matched
+      by their description, since every worker has its own instances; the
+      i-th evaluator with a description is matched with the i-th one. The
+      merged layer of an f value holds the sums of the counters both
+      searches had when they first reached it (or their final counters if
+      they never did) and the later of the two times.
+    */
+    void merge(const SearchStatistics &other);
+
     // output
     void print_basic_statistics() const;
     void print_detailed_statistics() const;
+    // Write all statistics as the members of the currently open JSON object.
+    void write_json(utils::JsonWriter &json) const;
 };
 
 #endif
@@ -87,6 +87,8 @@ class State final : private PartialAssignment {
 
     template <class Entry>
     friend class PerStateInformation;
+    template <class Code>
+    friend class HeuristicCache;
 
     friend PlanningTaskProxy;
     friend StateRegistry;
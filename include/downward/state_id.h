@@ -17,9 +17,12 @@
  */
 class StateID {
     friend class StateRegistry;
+    friend class ConcurrentStateRegistry;
     friend std::ostream &operator<<(std::ostream &os, StateID id);
     template <typename>
     friend class PerStateInformation;
+    template <typename>
+    friend class ConcurrentPerStateInformation;
 
     int value;
     explicit StateID(int value_)
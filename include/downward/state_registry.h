@@ -7,15 +7,31 @@
 
 #include "downward/algorithms/int_hash_set.h"
 #include "downward/algorithms/int_packer.h"
+#include "downward/algorithms/mapped_segment_allocator.h"
 #include "downward/algorithms/segmented_vector.h"
 #include "downward/algorithms/subscriber.h"
 #include "downward/utils/hash.h"
 
+#include <cstdint>
+#include <memory>
 #include <ranges>
 #include <set>
+#include <span>
+#include <vector>
 
 using PackedStateBin = int_packer::IntPacker::Bin;
 
+/**
+ * @brief Where the state data and the per-state information of a
+ * StateRegistry are stored.
+ *
+ * MAPPED places them in a memory-mapped temporary file, so that the operating
+ * system can page out old states when memory runs short.
+ *
+ * @see mapped_segment_allocator::MappedArena
+ */
+enum class StateStorage { HEAP, MAPPED };
+
 /**
  * @brief The StateRegistry class handles a collection of states identified with
  * with consecutive integer IDs.
@@ -34,37 +50,38 @@ using PackedStateBin = int_packer::IntPacker::Bin;
 class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     friend class State;
 
+    using StateDataPool = segmented_vector::SegmentedArrayVector<
+        PackedStateBin,
+        mapped_segment_allocator::SegmentAllocator<PackedStateBin>>;
+    using StateHashPool = segmented_vector::SegmentedVector<
+        std::uint64_t,
+        mapped_segment_allocator::SegmentAllocator<std::uint64_t>>;
+
+    /*
+      The hash of a state is the Zobrist hash of its facts, i.e., the XOR of
+      a random key for each fact of the state. It is computed when the state
+      is added to the state data pool and stored in the state hash pool at the
+      same index, so this functor only has to look it up. This is the only
+      copy of the hash: the hash set only keeps a 32-bit fingerprint of it.
+    */
     struct StateIDSemanticHash {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-            state_data_pool;
-        int state_size;
-        StateIDSemanticHash(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-                state_data_pool,
-            int state_size)
-            : state_data_pool(state_data_pool)
-            , state_size(state_size)
+        const StateHashPool& state_hash_pool;
+        explicit StateIDSemanticHash(const StateHashPool& state_hash_pool)
+            : state_hash_pool(state_hash_pool)
         {
         }
 
         int_hash_set::HashType operator()(int id) const
         {
-            const PackedStateBin* data = state_data_pool[id];
-            utils::HashState hash_state;
-            for (int i = 0; i < state_size; ++i) {
-                hash_state.feed(data[i]);
-            }
-            return hash_state.get_hash32();
+            return state_hash_pool[id];
         }
     };
 
     struct StateIDSemanticEqual {
-        const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-            state_data_pool;
+        const StateDataPool& state_data_pool;
         int state_size;
         StateIDSemanticEqual(
-            const segmented_vector::SegmentedArrayVector<PackedStateBin>&
-                state_data_pool,
+            const StateDataPool& state_data_pool,
             int state_size)
             : state_data_pool(state_data_pool)
             , state_size(state_size)
@@ -91,7 +108,18 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     const int_packer::IntPacker& state_packer;
     const int num_variables;
 
-    segmented_vector::SegmentedArrayVector<PackedStateBin> state_data_pool;
+    /*
+      Zobrist keys of the facts. The key of fact (var, value) is
+      zobrist_keys[zobrist_offsets[var] + value].
+    */
+    std::vector<std::uint64_t> zobrist_keys;
+    std::vector<int> zobrist_offsets;
+
+    // Null if the registry uses the heap.
+    std::shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory;
+    StateDataPool state_data_pool;
+    // Hashes of the states in state_data_pool (same indices).
+    StateHashPool state_hash_pool;
     StateIDSet registered_states;
 
     std::unique_ptr<State> cached_initial_state;
@@ -99,6 +127,27 @@ class StateRegistry : public subscriber::SubscriberService<StateRegistry> {
     StateID insert_id_or_pop_state();
     int get_bins_per_state() const;
 
+    std::uint64_t get_zobrist_key(int var, int value) const
+    {
+        return zobrist_keys[zobrist_offsets[var] + value];
+    }
+
+    // Effects are given either as proxies or as plain facts.
+    static FactPair get_pair(const FactProxy& fact) { return fact.get_pair(); }
+    static FactPair get_pair(const FactPair& fact) { return fact; }
+
+    /*
+      Remove the last state of the state data pool together with its hash.
+    */
+    void pop_state();
+
+    /*
+      Append a zero-initialized slot to the state data pool, pack the given
+      values into it and store their hash. The caller must either register the
+      new slot with insert_id_or_pop_state() or remove it with pop_state().
+    */
+    PackedStateBin* push_packed_state(std::span<const int> values);
+
     const int_packer::IntPacker& get_state_packer() const
     {
         return state_packer;
@@ -160,6 +209,30 @@ public:
     /// Create a state registry for a planning task.
     explicit StateRegistry(const PlanningTaskProxy& task_proxy);
 
+    /**
+     * @brief Creates a registry that keeps its states and the per-state
+     * information of its states in the given memory-mapped arena, or on the
+     * heap if \p mapped_memory is null.
+     *
+     * The states are packed with the state packer of the task for
+     * \p state_encoding (see task_properties::get_state_packer).
+     */
+    StateRegistry(
+        const PlanningTaskProxy& task_proxy,
+        std::shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory,
+        int_packer::Encoding state_encoding =
+            int_packer::Encoding::BIT_FIELDS);
+
+    /**
+     * @brief Returns the arena used for the states of this registry, or null
+     * if they are stored on the heap.
+     */
+    const std::shared_ptr<mapped_segment_allocator::MappedArena>&
+    get_mapped_memory() const
+    {
+        return mapped_memory;
+    }
+
     // Get the task for which this state registry was created.
     const PlanningTaskProxy& get_task_proxy() const { return task_proxy; }
 
@@ -184,23 +257,68 @@ public:
     /// Inserts a state with the given values in the registry and returns it.
     State insert_state(std::vector<int>&& state);
 
+    /**
+     * @brief Inserts \p count states whose values are stored consecutively in
+     * \p values and returns their IDs in the same order.
+     *
+     * The states are packed directly into the state data pool, so no
+     * temporary buffers are allocated per state.
+     */
+    std::vector<StateID>
+    insert_states(std::span<const int> values, std::size_t count);
+
+    /**
+     * @brief Returns the ID of the registered state with the given values, or
+     * StateID::no_state if no such state has been registered.
+     *
+     * The state is not registered by this call. (The state data pool is used
+     * as scratch space, which is why this method is not const.)
+     */
+    StateID find_state_id(std::span<const int> values);
+
     /**
      * @brief Create a registered successor state by applying the given effect
      * to a state.
      *
+     * If the predecessor is registered in this registry, the hash of the
+     * successor is derived from the stored hash of the predecessor, so hashing
+     * takes time linear in the number of effects rather than in the size of
+     * the state.
+     *
+     * The effect can be any range of FactProxy or FactPair objects, e.g.,
+     * the effect of an OperatorProxy or of a compiled_task::CompiledTask.
+     *
      * @see StateRegistry::get_successor
      */
     template <typename Effect>
     State
     get_successor_state(const State& predecessor, const Effect& effect_facts)
     {
+        if (predecessor.get_registry() != this) {
+            /*
+              Neither the hash nor the packed data can be reused, since the
+              other registry may use a different encoding.
+            */
+            std::vector<int> values = predecessor.get_unpacked_values();
+            for (const auto& effect_fact : effect_facts) {
+                FactPair effect_pair = get_pair(effect_fact);
+                values[effect_pair.var] = effect_pair.value;
+            }
+            return insert_state(std::move(values));
+        }
+
         state_data_pool.push_back(predecessor.get_buffer());
         PackedStateBin* buffer = state_data_pool[state_data_pool.size() - 1];
+        std::uint64_t hash = state_hash_pool[predecessor.get_id().value];
 
-        for (FactProxy effect_fact : effect_facts) {
-            FactPair effect_pair = effect_fact.get_pair();
+        for (const auto& effect_fact : effect_facts) {
+            FactPair effect_pair = get_pair(effect_fact);
+            int old_value = state_packer.get(buffer, effect_pair.var);
+            hash ^= get_zobrist_key(effect_pair.var, old_value) ^
+                    get_zobrist_key(effect_pair.var, effect_pair.value);
             state_packer.set(buffer, effect_pair.var, effect_pair.value);
         }
+        state_hash_pool.push_back(hash);
         ::StateID id = insert_id_or_pop_state();
         return task_proxy.create_state(*this, id, state_data_pool[id.value]);
     }
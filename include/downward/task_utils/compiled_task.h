@@ -0,0 +1,121 @@
+#ifndef DOWNWARD_TASK_UTILS_COMPILED_TASK_H
+#define DOWNWARD_TASK_UTILS_COMPILED_TASK_H
+
+#include "downward/operator_cost.h"
+#include "downward/operator_id.h"
+#include "downward/per_task_information.h"
+#include "downward/planning_task.h"
+
+#include <span>
+#include <vector>
+
+class ClassicalTaskProxy;
+
+namespace compiled_task {
+/*
+  A snapshot of a classical planning task in flat arrays, built once per task.
+
+  Accessing a task through the proxies costs one virtual call per fact (and
+  one per level of task transformation). The hot loops of search and
+  heuristics can read the snapshot instead: the preconditions and effects
+  of all operators are stored in compressed sparse row layout, i.e., the
+  preconditions of operator i are preconditions[precondition_offsets[i]],
+  ..., preconditions[precondition_offsets[i + 1] - 1], and the costs are
+  precomputed for every OperatorCost.
+
+  Since the task cannot change after it has been created, the snapshot stays
+  valid as long as the task. Use g_compiled_tasks to share it between all
+  users of a task and to destroy it together with the task.
+*/
+class CompiledTask {
+    std::vector<int> domain_sizes;
+    std::vector<int> fact_offsets;
+    int num_facts;
+
+    std::vector<int> precondition_offsets;
+    std::vector<FactPair> preconditions;
+    std::vector<int> effect_offsets;
+    std::vector<FactPair> effects;
+    std::vector<FactPair> goals;
+
+    // adjusted_costs[cost_type * num_operators + op] for each OperatorCost.
+    std::vector<int> adjusted_costs;
+    bool unit_cost;
+
+public:
+    explicit CompiledTask(const ClassicalTaskProxy& task_proxy);
+
+    int get_num_variables() const { return domain_sizes.size(); }
+
+    int get_num_operators() const { return precondition_offsets.size() - 1; }
+
+    int get_domain_size(int var) const { return domain_sizes[var]; }
+
+    // Facts are numbered consecutively, ordered by variable and value.
+    int get_num_facts() const { return num_facts; }
+
+    int get_fact_id(const FactPair& fact) const
+    {
+        return fact_offsets[fact.var] + fact.value;
+    }
+
+    std::span<const FactPair> get_preconditions(OperatorID op) const
+    {
+        int begin = precondition_offsets[op.get_index()];
+        int end = precondition_offsets[op.get_index() + 1];
+        return {preconditions.data() + begin, preconditions.data() + end};
+    }
+
+    std::span<const FactPair> get_effects(OperatorID op) const
+    {
+        int begin = effect_offsets[op.get_index()];
+        int end = effect_offsets[op.get_index() + 1];
+        return {effects.data() + begin, effects.data() + end};
+    }
+
+    std::span<const FactPair> get_goals() const { return goals; }
+
+    int get_cost(OperatorID op) const
+    {
+        return get_adjusted_cost(op, NORMAL);
+    }
+
+    int get_adjusted_cost(OperatorID op, OperatorCost cost_type) const
+    {
+        return adjusted_costs
+            [cost_type * get_num_operators() + op.get_index()];
+    }
+
+    // True iff all operators have cost 1.
+    bool is_unit_cost() const { return unit_cost; }
+
+    bool is_applicable(OperatorID op, std::span<const int> values) const
+    {
+        for (const FactPair& pre : get_preconditions(op)) {
+            if (values[pre.var] != pre.value) return false;
+        }
+        return true;
+    }
+
+    bool is_goal_state(std::span<const int> values) const
+    {
+        for (const FactPair& goal : goals) {
+            if (values[goal.var] != goal.value) return false;
+        }
+        return true;
+    }
+
+    int get_num_unsatisfied_goals(std::span<const int> values) const
+    {
+        int num_unsatisfied = 0;
+        for (const FactPair& goal : goals) {
+            if (values[goal.var] != goal.value) ++num_unsatisfied;
+        }
+        return num_unsatisfied;
+    }
+};
+
+extern PerTaskInformation<CompiledTask> g_compiled_tasks;
+} // namespace compiled_task
+
+#endif
@@ -3,21 +3,53 @@
 
 #include "downward/per_task_information.h"
 
+#include "downward/operator_id.h"
+
 #include <memory>
+#include <span>
 #include <vector>
 
-class OperatorID;
 class State;
 class PlanningTaskProxy;
 
 namespace successor_generator {
 class GeneratorBase;
+class GeneratorByteCode;
+class GeneratorBitset;
+
+/*
+  TREE uses a tree of polymorphic nodes. BYTE_CODE flattens this tree into a
+  single vector of ints (see GeneratorByteCode), which avoids virtual calls
+  and pointer chasing. Both generate the same operators in the same order.
+  BITSET tests the operators in blocks with bitsets (see GeneratorBitset)
+  and generates them ordered by ID. AUTOMATIC uses TREE or BITSET,
+  depending on which is estimated to be faster for the task.
+*/
+enum class Representation { TREE, BYTE_CODE, BITSET, AUTOMATIC };
+
+/*
+  The applicable operators of a batch of states in compressed sparse row
+  layout: the operators applicable in state i are operators[offsets[i]],
+  ..., operators[offsets[i + 1] - 1]. This can also serve directly as a
+  mask of applicable operators for the policy networks.
+*/
+struct ApplicableOpsBatch {
+    std::vector<int> offsets;
+    std::vector<OperatorID> operators;
+};
 
 class SuccessorGenerator {
+    // Exactly one of root, byte_code and bitset is set.
     std::unique_ptr<GeneratorBase> root;
+    std::unique_ptr<GeneratorByteCode> byte_code;
+    std::unique_ptr<GeneratorBitset> bitset;
 
 public:
-    explicit SuccessorGenerator(const PlanningTaskProxy& task_proxy);
+    explicit SuccessorGenerator(
+        const PlanningTaskProxy& task_proxy,
+        Representation representation = Representation::TREE);
+    // Create a BYTE_CODE generator from the result of get_byte_code.
+    explicit SuccessorGenerator(std::vector<int> byte_code);
     /*
       We cannot use the default destructor (implicitly or explicitly)
       here because GeneratorBase is a forward declaration and the
@@ -28,9 +60,40 @@ public:
     void generate_applicable_ops(
         const State& state,
         std::vector<OperatorID>& applicable_ops) const;
+
+    /*
+      Generate the applicable operators of all states, which must be
+      unpacked. The operators of each state are the same and in the same
+      order as for generate_applicable_ops. The tree representation is
+      walked once for the whole batch, the others handle one state after
+      the other. The batched walk pays off for large trees; for small
+      trees that fit into the cache, the bookkeeping for the batch can
+      make it slower than generating the operators state by state.
+    */
+    void generate_applicable_ops_batch(
+        std::span<const State> states,
+        ApplicableOpsBatch& result) const;
+
+    /*
+      Return the byte code of a BYTE_CODE generator in a form that can be
+      stored, e.g., in a binary task file, and passed to the constructor.
+    */
+    std::vector<int> get_byte_code() const;
 };
 
 extern PerTaskInformation<SuccessorGenerator> g_successor_generators;
+extern PerTaskInformation<SuccessorGenerator> g_byte_code_successor_generators;
+extern PerTaskInformation<SuccessorGenerator> g_bitset_successor_generators;
+extern PerTaskInformation<SuccessorGenerator> g_automatic_successor_generators;
+
+/*
+  Return the successor generator of the task for the given representation,
+  i.e., the entry of g_successor_generators for TREE and of the
+  corresponding g_*_successor_generators otherwise.
+*/
+extern SuccessorGenerator& get_successor_generator(
+    const PlanningTaskProxy& task_proxy,
+    Representation representation);
 } // namespace successor_generator
 
 #endif
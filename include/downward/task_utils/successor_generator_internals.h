@@ -3,13 +3,44 @@
 
 #include "downward/operator_id.h"
 
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
+class PlanningTaskProxy;
 class State;
 
 namespace successor_generator {
+/*
+  The leaves reached by the states of a batch. Visit i means that the
+  states with the indices state_indices[begin], ...,
+  state_indices[end - 1] reach a leaf with the given operators.
+*/
+struct LeafVisits {
+    struct Visit {
+        const OperatorID* operators;
+        int num_operators;
+        int begin;
+        int end;
+    };
+    std::vector<Visit> visits;
+    std::vector<int> state_indices;
+
+    void add_visit(
+        const OperatorID* operators,
+        int num_operators,
+        const int* indices_begin,
+        const int* indices_end)
+    {
+        int begin = state_indices.size();
+        state_indices.insert(state_indices.end(), indices_begin, indices_end);
+        visits.push_back({operators, num_operators, begin,
+                          static_cast<int>(state_indices.size())});
+    }
+};
+
 class GeneratorBase {
 public:
     virtual ~GeneratorBase() {}
@@ -17,6 +48,35 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const = 0;
+
+    /*
+      Batched version of generate_applicable_ops for the states with the
+      indices stack[begin], ..., stack[end - 1], which visits each node at
+      most once for the whole batch. Records the leaves reached by the
+      states in leaf_visits. Nodes push the indices for their children on
+      the stack and pop them before returning, so the whole batch gets by
+      with a single buffer.
+    */
+    virtual void generate_applicable_ops_batch(
+        const std::vector<const int*>& states,
+        std::vector<int>& stack,
+        int begin,
+        int end,
+        LeafVisits& leaf_visits) const = 0;
+
+    /*
+      Append the byte code of this node and its descendants to code (see
+      GeneratorByteCode) and return the reference to this node.
+    */
+    virtual int append_byte_code(std::vector<int>& code) const = 0;
+
+    /*
+      Return the expected number of nodes of this subtree visited for a
+      state whose variables have independent, uniformly distributed
+      values. Used to compare the cost with GeneratorBitset.
+    */
+    virtual double
+    get_expected_num_visits(const std::vector<int>& domain_sizes) const = 0;
 };
 
 class GeneratorForkBinary : public GeneratorBase {
@@ -30,6 +90,15 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+    virtual void generate_applicable_ops_batch(
+        const std::vector<const int*>& states,
+        std::vector<int>& stack,
+        int begin,
+        int end,
+        LeafVisits& leaf_visits) const override;
+    virtual int append_byte_code(std::vector<int>& code) const override;
+    virtual double get_expected_num_visits(
+        const std::vector<int>& domain_sizes) const override;
 };
 
 class GeneratorForkMulti : public GeneratorBase {
@@ -40,6 +109,15 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+    virtual void generate_applicable_ops_batch(
+        const std::vector<const int*>& states,
+        std::vector<int>& stack,
+        int begin,
+        int end,
+        LeafVisits& leaf_visits) const override;
+    virtual int append_byte_code(std::vector<int>& code) const override;
+    virtual double get_expected_num_visits(
+        const std::vector<int>& domain_sizes) const override;
 };
 
 class GeneratorSwitchVector : public GeneratorBase {
@@ -53,6 +131,15 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+    virtual void generate_applicable_ops_batch(
+        const std::vector<const int*>& states,
+        std::vector<int>& stack,
+        int begin,
+        int end,
+        LeafVisits& leaf_visits) const override;
+    virtual int append_byte_code(std::vector<int>& code) const override;
+    virtual double get_expected_num_visits(
+        const std::vector<int>& domain_sizes) const override;
 };
 
 class GeneratorSwitchHash : public GeneratorBase {
@@ -67,6 +154,15 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+    virtual void generate_applicable_ops_batch(
+        const std::vector<const int*>& states,
+        std::vector<int>& stack,
+        int begin,
+        int end,
+        LeafVisits& leaf_visits) const override;
+    virtual int append_byte_code(std::vector<int>& code) const override;
+    virtual double get_expected_num_visits(
+        const std::vector<int>& domain_sizes) const override;
 };
 
 class GeneratorSwitchSingle : public GeneratorBase {
@@ -82,6 +178,15 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+    virtual void generate_applicable_ops_batch(
+        const std::vector<const int*>& states,
+        std::vector<int>& stack,
+        int begin,
+        int end,
+        LeafVisits& leaf_visits) const override;
+    virtual int append_byte_code(std::vector<int>& code) const override;
+    virtual double get_expected_num_visits(
+        const std::vector<int>& domain_sizes) const override;
 };
 
 class GeneratorLeafVector : public GeneratorBase {
@@ -92,6 +197,15 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+    virtual void generate_applicable_ops_batch(
+        const std::vector<const int*>& states,
+        std::vector<int>& stack,
+        int begin,
+        int end,
+        LeafVisits& leaf_visits) const override;
+    virtual int append_byte_code(std::vector<int>& code) const override;
+    virtual double get_expected_num_visits(
+        const std::vector<int>& domain_sizes) const override;
 };
 
 class GeneratorLeafSingle : public GeneratorBase {
@@ -102,6 +216,120 @@ public:
     virtual void generate_applicable_ops(
         const std::vector<int>& state,
         std::vector<OperatorID>& applicable_ops) const override;
+    virtual void generate_applicable_ops_batch(
+        const std::vector<const int*>& states,
+        std::vector<int>& stack,
+        int begin,
+        int end,
+        LeafVisits& leaf_visits) const override;
+    virtual int append_byte_code(std::vector<int>& code) const override;
+    virtual double get_expected_num_visits(
+        const std::vector<int>& domain_sizes) const override;
+};
+
+/*
+  Flat representation of a successor generator tree in a single vector of
+  ints. There are five kinds of nodes, identified by a tag:
+
+  - fork: [FORK, n, child_1, ..., child_n]
+  - leaf: [LEAF, n, op_id_1, ..., op_id_n]
+  - vector switch: [VECTOR_SWITCH, var_id, child_0, ..., child_{d-1}]
+    where d is the domain size of var_id and child_i is the child for
+    value i (or NO_CHILD).
+  - single switch: [SINGLE_SWITCH, var_id, value, child]
+  - switch: [SWITCH, k, var_id, value_1, child_1, ..., value_k, child_k]
+    with value_1 < ... < value_k, so the child can be found by binary search.
+
+  A child (and the root) is referenced by its position in the code if it is
+  a node, and by -(id + 1) if it is a single operator with ID id, so single
+  operators need no leaf node.
+
+  The nodes are visited in the same order as in the tree it was built from,
+  so both generate the applicable operators in the same order.
+*/
+class GeneratorByteCode {
+    std::vector<int> code;
+    int root;
+
+    void generate_applicable_ops(
+        int ref,
+        const int* state,
+        std::vector<OperatorID>& applicable_ops) const;
+
+public:
+    enum Tag { FORK, LEAF, VECTOR_SWITCH, SINGLE_SWITCH, SWITCH };
+    static constexpr int NO_CHILD = std::numeric_limits<int>::min();
+
+    static int get_operator_ref(OperatorID op) { return -(op.get_index() + 1); }
+
+    explicit GeneratorByteCode(const GeneratorBase& tree);
+    GeneratorByteCode(std::vector<int>&& code, int root);
+
+    void generate_applicable_ops(
+        const std::vector<int>& state,
+        std::vector<OperatorID>& applicable_ops) const
+    {
+        generate_applicable_ops(root, state.data(), applicable_ops);
+    }
+
+    std::size_t get_size() const { return code.size(); }
+
+    const std::vector<int>& get_code() const { return code; }
+
+    int get_root() const { return root; }
+};
+
+/*
+  Applicability test with bitsets instead of a tree. The operators are
+  split into blocks of BLOCK_SIZE operators by ID. For each block and each
+  variable with a precondition in the block, there is one row of
+  BLOCK_SIZE bits per value of the variable, where the bit of an operator
+  is set iff the operator has no precondition on the variable or its
+  precondition is the variable with this value. The applicable operators
+  of a block are the AND of the rows selected by the state, so the cost
+  per state depends on the number of (block, variable) pairs rather than
+  the shape of the precondition tree. This pays off for tasks with many
+  operators with few preconditions each.
+
+  The AND over rows uses AVX2 if the CPU supports it and a scalar loop
+  otherwise. Unlike the tree, this generates the operators ordered by ID.
+*/
+class GeneratorBitset {
+public:
+    using Word = std::uint64_t;
+    static constexpr int WORDS_PER_BLOCK = 4;
+    static constexpr int BLOCK_SIZE = 64 * WORDS_PER_BLOCK;
+
+private:
+    int num_blocks;
+    /*
+      The rows are stored consecutively, each with WORDS_PER_BLOCK words.
+      Row b is the set of operators in block b. Block b selects the rows
+      row_for_value_0[i] + state[var[i]] for i in
+      [block_begin[b], block_begin[b + 1]).
+    */
+    std::vector<Word> rows;
+    std::vector<int> block_begin;
+    std::vector<int> var;
+    std::vector<int> row_for_value_0;
+    bool use_avx2;
+
+    void generate_applicable_ops_scalar(
+        const std::vector<int>& state,
+        std::vector<OperatorID>& applicable_ops) const;
+    void generate_applicable_ops_avx2(
+        const std::vector<int>& state,
+        std::vector<OperatorID>& applicable_ops) const;
+
+public:
+    explicit GeneratorBitset(const PlanningTaskProxy& task_proxy);
+
+    void generate_applicable_ops(
+        const std::vector<int>& state,
+        std::vector<OperatorID>& applicable_ops) const;
+
+    // Number of rows combined per state, including the block rows.
+    int get_num_row_accesses() const { return num_blocks + var.size(); }
 };
 } // namespace successor_generator
 
@@ -186,6 +186,15 @@ void dump_task(
 }
 
 extern PerTaskInformation<int_packer::IntPacker> g_state_packers;
+extern PerTaskInformation<int_packer::IntPacker> g_mixed_radix_state_packers;
+
+/*
+  Return the state packer of the task for the given encoding, i.e., the entry
+  of g_state_packers or g_mixed_radix_state_packers.
+*/
+extern const int_packer::IntPacker& get_state_packer(
+    const PlanningTaskProxy& task_proxy,
+    int_packer::Encoding encoding);
 } // namespace task_properties
 
 #endif
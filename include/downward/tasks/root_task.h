@@ -4,10 +4,29 @@
 #include "downward/planning_task.h"
 
 #include <memory>
+#include <string>
 
 namespace tasks {
 extern std::shared_ptr<ClassicalTask> g_root_task;
-extern std::unique_ptr<ClassicalTask> read_task_from_sas(std::istream& in);
-extern void read_root_task(std::istream& in);
+/*
+  Read a task from translator output. With num_threads > 1, the operators
+  of large tasks are parsed in parallel; the result is the same.
+*/
+extern std::unique_ptr<ClassicalTask>
+read_task_from_sas(std::istream& in, int num_threads = 1);
+extern void read_root_task(std::istream& in, int num_threads = 1);
+
+/*
+  Binary task files store a task read from translator output (see
+  write_binary_task) in a form that can be memory-mapped, which makes
+  reading a task much faster than parsing the translator output.
+  read_root_task_from_binary also installs the successor generator stored
+  in the file as the byte-code successor generator of the task.
+*/
+extern std::unique_ptr<ClassicalTask>
+read_task_from_binary(const std::string& filename);
+extern void read_root_task_from_binary(const std::string& filename);
+extern void
+write_binary_task(const ClassicalTask& task, const std::string& filename);
 } // namespace tasks
 #endif
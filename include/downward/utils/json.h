@@ -0,0 +1,48 @@
+#ifndef DOWNWARD_UTILS_JSON_H
+#define DOWNWARD_UTILS_JSON_H
+
+#include <cstddef>
+#include <ostream>
+#include <string_view>
+
+namespace utils {
+/*
+  Minimal streaming writer for JSON documents. Callers are responsible for
+  the structure: inside objects, every value must be preceded by key().
+  Non-finite doubles are written as null, since JSON cannot represent them.
+
+  Example:
+    JsonWriter json(os);
+    json.begin_object();
+    json.key("expanded");
+    json.value(42);
+    json.end_object();
+*/
+class JsonWriter {
+    std::ostream& os;
+    // True iff the next element of the enclosing container needs a comma.
+    bool needs_comma;
+
+    void write_separator();
+
+public:
+    explicit JsonWriter(std::ostream& os);
+
+    void begin_object();
+    void end_object();
+    void begin_array();
+    void end_array();
+    void key(std::string_view name);
+
+    void value(int value);
+    void value(long long value);
+    void value(std::size_t value);
+    void value(double value);
+    void value(bool value);
+    void value(std::string_view value);
+    void value(const char* value) { this->value(std::string_view(value)); }
+    void null();
+};
+} // namespace utils
+
+#endif
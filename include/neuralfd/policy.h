@@ -4,6 +4,8 @@
 #include "downward/per_state_information.h"
 #include "downward/task_proxy.h"
 
+#include "downward/algorithms/indexed_cache.h"
+
 #include <vector>
 
 namespace options {
@@ -61,6 +63,9 @@ class Policy {
         }
     };
 
+    // Small ID that is unique among all existing policies.
+    const indexed_cache::PooledId id;
+
 protected:
     /*
       Cache for saving policy results
@@ -93,6 +98,16 @@ public:
     explicit Policy(const options::Options& options);
     virtual ~Policy();
 
+    Policy(const Policy&) = delete;
+    Policy& operator=(const Policy&) = delete;
+
+    /*
+      Dense ID that can index arrays of per-policy data (see PolicyCache).
+      IDs are reused, so such data must be tagged with the serial number.
+    */
+    int get_id() const { return id.get_id(); }
+    std::uint64_t get_serial() const { return id.get_serial(); }
+
     virtual bool dead_ends_are_reliable() const = 0;
 
     static void add_options_to_parser(options::OptionParser& parser);
@@ -3,17 +3,15 @@
 
 #include "neuralfd/policy_result.h"
 
-#include <unordered_map>
+#include "downward/algorithms/indexed_cache.h"
 
 class Policy;
 
-using PolicyResults = std::unordered_map<Policy*, PolicyResult>;
-
 /*
-  Store evaluation results for evaluators.
+  Store policy results for policies, indexed by the policy IDs.
 */
 class PolicyCache {
-    PolicyResults policy_results;
+    indexed_cache::IndexedCache<Policy, PolicyResult, 2> policy_results;
 
 public:
     PolicyResult& operator[](Policy* policy);
@@ -21,11 +19,10 @@ public:
     template <class Callback>
     void for_each_policy_result(const Callback& callback) const
     {
-        for (const auto& element : policy_results) {
-            const Policy* policy = element.first;
-            const PolicyResult& result = element.second;
-            callback(policy, result);
-        }
+        policy_results.for_each(
+            [&callback](const Policy* policy, const PolicyResult& result) {
+                callback(policy, result);
+            });
     }
 };
 
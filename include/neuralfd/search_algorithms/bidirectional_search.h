@@ -0,0 +1,126 @@
+#ifndef NEURALFD_SEARCH_ALGORITHMS_BIDIRECTIONAL_SEARCH_H
+#define NEURALFD_SEARCH_ALGORITHMS_BIDIRECTIONAL_SEARCH_H
+
+#include "neuralfd/task_utils/partial_state_index.h"
+#include "neuralfd/task_utils/predecessor_generator.h"
+#include "neuralfd/task_utils/regression_task_proxy.h"
+
+#include "downward/search_algorithm.h"
+
+#include "downward/utils/hash.h"
+
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace options {
+class OptionParser;
+class Options;
+} // namespace options
+
+namespace bidirectional_search {
+/*
+  Bidirectional uniform-cost search.
+
+  The forward search expands states from the initial state. The backward
+  search regresses the goal and expands partial states, i.e., sets of states
+  from which the goal can be reached with known cost. Both directions store
+  their nodes in a PartialStateIndex. Whenever a node is generated or
+  reached on a cheaper path, the index of the other direction is queried
+  for the cheapest meeting node: a forward state s and a backward partial
+  state p meet if s satisfies p, and then the forward path to s followed by
+  the regression path from p to the goal is a plan.
+
+  Each step expands the cheapest node of the direction with the smaller open
+  list. The search stops when the cheapest plan found costs at most the sum
+  of the smallest g values in both open lists. No undiscovered plan can be
+  cheaper then, so the plan is optimal. It also stops when one direction
+  has no open nodes left.
+*/
+class BidirectionalSearch : public SearchAlgorithm {
+    struct BackwardNode {
+        // Points to the key in backward_ids.
+        const std::vector<int>* values;
+        int g;
+        int real_g;
+        // Node closer to the goal and the operator regressed to get here.
+        int parent;
+        OperatorID op_id;
+        bool closed;
+    };
+
+    using OpenEntry = std::pair<int, int>;
+    using OpenList = std::priority_queue<
+        OpenEntry,
+        std::vector<OpenEntry>,
+        std::greater<OpenEntry>>;
+
+    RegressionTaskProxy regression_task_proxy;
+    predecessor_generator::PredecessorGenerator predecessor_generator;
+    const bool prune_mutexes;
+
+    // The forward open list and index refer to states by their position in
+    // forward_states.
+    std::vector<StateID> forward_states;
+    OpenList forward_open;
+    partial_state_index::PartialStateIndex forward_index;
+    int num_forward_expansions;
+
+    std::vector<BackwardNode> backward_nodes;
+    utils::HashMap<std::vector<int>, int> backward_ids;
+    OpenList backward_open;
+    partial_state_index::PartialStateIndex backward_index;
+    int num_backward_expansions;
+    int num_mutex_pruned;
+
+    // The cheapest plan found so far and the nodes where its halves meet.
+    int best_cost;
+    int meet_forward;
+    int meet_backward;
+
+    void add_forward_node(const State& state, int g, int real_g);
+    void add_backward_node(
+        std::vector<int>&& values,
+        int g,
+        int real_g,
+        int parent,
+        OperatorID op_id);
+    void report_meet(int forward_entry, int backward_id, int cost);
+    bool prune_stale_forward_entries();
+    bool prune_stale_backward_entries();
+    void expand_forward();
+    void expand_backward();
+    SearchStatus finish();
+
+protected:
+    virtual void initialize() override;
+    virtual SearchStatus step() override;
+
+public:
+    explicit BidirectionalSearch(const options::Options& opts);
+    BidirectionalSearch(
+        std::shared_ptr<ClassicalTask> task,
+        utils::LogProxy log,
+        OperatorCost cost_type,
+        double max_time,
+        int bound,
+        bool prune_mutexes,
+        SearchNodeStorage node_storage = SearchNodeStorage::STRUCT,
+        std::shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory =
+            nullptr,
+        int_packer::Encoding state_encoding =
+            int_packer::Encoding::BIT_FIELDS,
+        successor_generator::Representation
+            successor_generator_representation =
+                successor_generator::Representation::TREE);
+    virtual ~BidirectionalSearch() override = default;
+
+    virtual void write_statistics_json(utils::JsonWriter& json) const override;
+    virtual void print_statistics() const override;
+};
+
+extern void add_options_to_parser(options::OptionParser& parser);
+} // namespace bidirectional_search
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef NEURALFD_TASK_UTILS_PARTIAL_STATE_INDEX_H
+#define NEURALFD_TASK_UTILS_PARTIAL_STATE_INDEX_H
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace partial_state_index {
+/*
+  Index over (partial) variable assignments, each stored with an entry id
+  and a cost. Unassigned variables have the value
+  PartialAssignment::UNASSIGNED (-1).
+
+  The assignments are stored in a trie that branches on the variables in
+  order of their ids. A subtree that holds a single assignment is collapsed
+  into one leaf that stores the remaining values, so storing an assignment
+  costs little more than a copy of its values. Every trie node knows the
+  cheapest entry below it, so the queries for the cheapest matching entry
+  can skip subtrees that cannot beat the best match found so far.
+*/
+class PartialStateIndex {
+    struct Node {
+        int min_cost;
+        // Entry of a leaf, or NO_ENTRY for inner nodes.
+        int entry;
+        // Values of a leaf for the variables from the node's depth onwards.
+        std::vector<int> tail;
+        // Pairs of value (or UNASSIGNED) and index of the child node.
+        std::vector<std::pair<int, int>> children;
+
+        Node();
+        int get_child(int value) const;
+        bool tail_generalizes(const std::vector<int>& state, int var) const;
+        bool tail_specializes(
+            const std::vector<int>& partial_state,
+            int var) const;
+    };
+
+    int num_variables;
+    std::vector<Node> nodes;
+    std::size_t num_entries;
+
+    int add_leaf(
+        const std::vector<int>& values,
+        int first,
+        int entry,
+        int cost);
+    void find_generalization(
+        const std::vector<int>& state,
+        int node_id,
+        int var,
+        std::pair<int, int>& best) const;
+    void find_specialization(
+        const std::vector<int>& partial_state,
+        int node_id,
+        int var,
+        std::pair<int, int>& best) const;
+
+public:
+    static constexpr int NO_ENTRY = -1;
+
+    explicit PartialStateIndex(int num_variables);
+
+    /*
+      Store the assignment with the given entry id and cost. If the
+      assignment is already stored, its entry id and cost are replaced if the
+      new cost is lower.
+    */
+    void insert(const std::vector<int>& values, int entry, int cost);
+
+    /*
+      Return the (entry, cost) pair of the cheapest stored assignment with
+      cost below cost_limit that the given state satisfies, i.e., that only
+      assigns values the state also has. Return (NO_ENTRY, cost_limit) if
+      there is none.
+    */
+    std::pair<int, int> find_cheapest_generalization(
+        const std::vector<int>& state,
+        int cost_limit) const;
+
+    /*
+      Return the (entry, cost) pair of the cheapest stored assignment with
+      cost below cost_limit that satisfies the given partial state, i.e.,
+      that has the same value for every variable the partial state assigns.
+      Return (NO_ENTRY, cost_limit) if there is none.
+    */
+    std::pair<int, int> find_cheapest_specialization(
+        const std::vector<int>& partial_state,
+        int cost_limit) const;
+
+    std::size_t size() const { return num_entries; }
+    std::size_t get_num_nodes() const { return nodes.size(); }
+};
+} // namespace partial_state_index
+
+#endif
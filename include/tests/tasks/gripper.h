@@ -5,8 +5,11 @@
 
 #include "downward/task_proxy.h"
 
+#include <memory>
 #include <vector>
 
+class StateRegistry;
+
 namespace tests {
 
 /**
@@ -61,6 +64,9 @@ public:
     // Construct a gripper problem instance.
     explicit GripperProblem(int num_rooms, int num_balls);
 
+    int get_num_rooms() const;
+    int get_num_balls() const;
+
     // Get the integer representation of a variable.
     int get_variable_robot_at() const;
     int get_variable_carry_left() const;
@@ -94,6 +100,37 @@ private:
     void verify_ball_index(int ball_idx) const;
 };
 
+/**
+ * @brief Construct a gripper task in which the robot and all balls are in
+ * room 0 and both grippers are empty initially.
+ */
+std::shared_ptr<ClassicalTask> create_gripper_task(
+    const GripperProblem& problem,
+    std::vector<FactPair> goal);
+
+/**
+ * @brief Construct a gripper task whose goal is to bring all balls from
+ * room 0 to room 1.
+ */
+std::shared_ptr<ClassicalTask>
+create_gripper_task(const GripperProblem& problem);
+
+/**
+ * @brief Construct a gripper task whose goal is to bring all balls from
+ * room 0 to room 1 and the robot back to room 0.
+ */
+std::shared_ptr<ClassicalTask>
+create_gripper_round_trip_task(const GripperProblem& problem);
+
+/**
+ * @brief Register the state that differs from the initial state of the task
+ * of the registry only in the room of the robot.
+ */
+State insert_state_with_robot_at(
+    StateRegistry& registry,
+    const GripperProblem& problem,
+    int room_idx);
+
 } // namespace tests
 
 #endif // TASKS_GRIPPER_H
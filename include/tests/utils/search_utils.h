@@ -1,9 +1,12 @@
 #ifndef SEARCH_UTILS_H
 #define SEARCH_UTILS_H
 
+#include "downward/plan_manager.h"
+
 #include <memory>
 
 class ClassicalTask;
+class ClassicalTaskProxy;
 class Evaluator;
 class SearchAlgorithm;
 
@@ -18,6 +21,14 @@ std::unique_ptr<SearchAlgorithm> create_astar_search_algorithm(
     std::shared_ptr<ClassicalTask> task,
     std::shared_ptr<Evaluator> evaluator);
 
+/**
+ * @brief Checks that the plan is applicable in the initial state of the task
+ * and leads to a goal state.
+ *
+ * @ingroup utils
+ */
+bool leads_to_goal(const ClassicalTaskProxy& task_proxy, const Plan& plan);
+
 } // namespace tests
 
 #endif // SEARCH_UTILS_H
@@ -0,0 +1,340 @@
+#include <benchmark/benchmark.h>
+
+#include "downward/heuristic.h"
+#include "downward/state.h"
+#include "downward/task_proxy.h"
+
+#include "downward/heuristics/blind_search_heuristic.h"
+#include "downward/heuristics/cliques_heuristic.h"
+#include "downward/heuristics/ff_heuristic.h"
+#include "downward/heuristics/goal_count_heuristic.h"
+#include "downward/heuristics/max_heuristic.h"
+#include "downward/heuristics/pdb_heuristic.h"
+
+#include "tests/tasks/blocksworld.h"
+#include "tests/tasks/gripper.h"
+#include "tests/tasks/nomystery.h"
+#include "tests/tasks/sokoban.h"
+#include "tests/tasks/visitall.h"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+/*
+  Time per state of compute_heuristic for the blind, goal-count, hmax, FF,
+  PDB and canonical PDB heuristics on the test tasks, each at three problem
+  sizes. The time per iteration is the latency of one evaluation, the items
+  per second are the throughput.
+
+  The states are random (not necessarily reachable) assignments, and the
+  heuristics are called directly, so that the per-state cache of Heuristic
+  does not hide the computation. Heuristics that are not implemented yet are
+  reported as skipped.
+
+  Save the results for regression tracking with
+    heuristic_benchmarks --benchmark_out=heuristic_benchmarks.json
+        --benchmark_out_format=json
+  or build the target heuristic_benchmarks_json, and compare two result
+  files with tools/compare.py from Google Benchmark.
+*/
+
+using namespace tests;
+
+static const int NUM_STATES = 1 << 10;
+// Maximum number of abstract states of the PDBs.
+static const int PDB_SIZE_LIMIT = 10000;
+
+namespace {
+struct Workload {
+    // The task refers to the problem, so the workload owns both.
+    std::unique_ptr<ClassicalPlanningProblem> problem;
+    std::shared_ptr<ClassicalTask> task;
+    ClassicalTaskProxy task_proxy;
+    std::vector<State> states;
+
+    Workload(
+        std::unique_ptr<ClassicalPlanningProblem> problem_,
+        std::vector<FactPair> goal)
+        : problem(std::move(problem_))
+        , task(create_task(*problem, std::move(goal)))
+        , task_proxy(*task)
+    {
+        std::mt19937 rng(2024);
+        for (int i = 0; i < NUM_STATES; ++i) {
+            std::vector<int> values;
+            for (VariableProxy var : task_proxy.get_variables()) {
+                std::uniform_int_distribution<int> dist(
+                    0,
+                    var.get_domain_size() - 1);
+                values.push_back(dist(rng));
+            }
+            states.emplace_back(*task, std::move(values));
+        }
+    }
+
+    // Only the operators and the goal matter, so any initial state will do.
+    static std::shared_ptr<ClassicalTask> create_task(
+        const ClassicalPlanningProblem& problem,
+        std::vector<FactPair> goal)
+    {
+        std::vector<FactPair> initial_state;
+        for (int var = 0; var < problem.get_num_variables(); ++var)
+            initial_state.emplace_back(var, 0);
+        return create_problem_task(problem, initial_state, std::move(goal));
+    }
+};
+
+using WorkloadCache = std::map<int, std::unique_ptr<Workload>>;
+} // namespace
+
+// Goal: a single tower with block 0 at the bottom.
+static const Workload& get_blocksworld(int num_blocks)
+{
+    static WorkloadCache workloads;
+    std::unique_ptr<Workload>& workload = workloads[num_blocks];
+    if (!workload) {
+        auto problem = std::make_unique<BlocksWorldProblem>(num_blocks);
+        std::vector<FactPair> goal = {problem->get_fact_location_on_table(0)};
+        for (int b = 1; b < num_blocks; ++b)
+            goal.push_back(problem->get_fact_location_on_block(b, b - 1));
+        workload = std::make_unique<Workload>(std::move(problem), goal);
+    }
+    return *workload;
+}
+
+// Goal: all balls in the second room.
+static const Workload& get_gripper(int num_balls)
+{
+    static WorkloadCache workloads;
+    std::unique_ptr<Workload>& workload = workloads[num_balls];
+    if (!workload) {
+        auto problem = std::make_unique<GripperProblem>(2, num_balls);
+        std::vector<FactPair> goal;
+        for (int b = 0; b < num_balls; ++b)
+            goal.push_back(problem->get_fact_ball_at_room(b, 1));
+        workload = std::make_unique<Workload>(std::move(problem), goal);
+    }
+    return *workload;
+}
+
+// Locations on a line, one package per location. Goal: package p at the
+// mirrored location.
+static const Workload& get_nomystery(int num_locations)
+{
+    static WorkloadCache workloads;
+    std::unique_ptr<Workload>& workload = workloads[num_locations];
+    if (!workload) {
+        std::set<RoadMapEdge> roadmap;
+        for (int l = 0; l + 1 < num_locations; ++l) {
+            roadmap.insert({l, l + 1});
+            roadmap.insert({l + 1, l});
+        }
+        auto problem = std::make_unique<NoMysteryProblem>(
+            num_locations,
+            num_locations,
+            2,
+            roadmap);
+        std::vector<FactPair> goal;
+        for (int p = 0; p < num_locations; ++p) {
+            int destination = num_locations - 1 - p;
+            goal.push_back(
+                problem->get_fact_package_at_location(p, destination));
+        }
+        workload = std::make_unique<Workload>(std::move(problem), goal);
+    }
+    return *workload;
+}
+
+// An open square of the given width with (width - 1) / 2 boxes and as many
+// goal squares in the middle row. Goal: all boxes on goal squares.
+static const Workload& get_sokoban(int width)
+{
+    static WorkloadCache workloads;
+    std::unique_ptr<Workload>& workload = workloads[width];
+    if (!workload) {
+        int num_boxes = (width - 1) / 2;
+        SokobanGrid grid(width, std::vector<char>(width, ' '));
+        for (int b = 0; b < num_boxes; ++b) grid[width / 2][1 + b] = 'G';
+        auto problem = std::make_unique<SokobanProblem>(grid, num_boxes);
+        std::vector<FactPair> goal;
+        for (int b = 0; b < num_boxes; ++b)
+            goal.push_back(problem->get_fact_box_at_goal(b, true));
+        workload = std::make_unique<Workload>(std::move(problem), goal);
+    }
+    return *workload;
+}
+
+// Goal: all squares of the square grid visited.
+static const Workload& get_visitall(int width)
+{
+    static WorkloadCache workloads;
+    std::unique_ptr<Workload>& workload = workloads[width];
+    if (!workload) {
+        auto problem = std::make_unique<VisitAllProblem>(width, width);
+        std::vector<FactPair> goal;
+        for (int x = 0; x < width; ++x) {
+            for (int y = 0; y < width; ++y)
+                goal.push_back(problem->get_fact_square_visited(x, y, true));
+        }
+        workload = std::make_unique<Workload>(std::move(problem), goal);
+    }
+    return *workload;
+}
+
+static void set_blocksworld_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgName("blocks")->Arg(4)->Arg(8)->Arg(12);
+}
+
+static void set_gripper_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgName("balls")->Arg(4)->Arg(12)->Arg(20);
+}
+
+static void set_nomystery_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgName("locations")->Arg(4)->Arg(8)->Arg(12);
+}
+
+static void set_sokoban_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgName("width")->Arg(5)->Arg(7)->Arg(9);
+}
+
+static void set_visitall_sizes(benchmark::internal::Benchmark* benchmark)
+{
+    benchmark->ArgName("width")->Arg(4)->Arg(8)->Arg(12);
+}
+
+/*
+  Add goal variables in order of domain size as long as the PDB stays within
+  PDB_SIZE_LIMIT abstract states.
+*/
+static pdbs::Pattern get_pdb_pattern(const ClassicalTaskProxy& task_proxy)
+{
+    VariablesProxy variables = task_proxy.get_variables();
+    std::vector<int> goal_vars;
+    for (FactProxy goal : task_proxy.get_goal())
+        goal_vars.push_back(goal.get_variable().get_id());
+    std::ranges::stable_sort(goal_vars, [&](int var1, int var2) {
+        return variables[var1].get_domain_size() <
+               variables[var2].get_domain_size();
+    });
+
+    pdbs::Pattern pattern;
+    int num_abstract_states = 1;
+    for (int var : goal_vars) {
+        int domain_size = variables[var].get_domain_size();
+        if (num_abstract_states > PDB_SIZE_LIMIT / domain_size) break;
+        num_abstract_states *= domain_size;
+        pattern.push_back(var);
+    }
+    std::ranges::sort(pattern);
+    return pattern;
+}
+
+// Disjoint patterns of two consecutive goal variables each.
+static pdbs::PatternCollection
+get_canonical_pdbs_patterns(const ClassicalTaskProxy& task_proxy)
+{
+    std::vector<int> goal_vars;
+    for (FactProxy goal : task_proxy.get_goal())
+        goal_vars.push_back(goal.get_variable().get_id());
+
+    pdbs::PatternCollection patterns;
+    for (size_t i = 0; i < goal_vars.size(); i += 2) {
+        pdbs::Pattern pattern = {goal_vars[i]};
+        if (i + 1 < goal_vars.size()) pattern.push_back(goal_vars[i + 1]);
+        std::ranges::sort(pattern);
+        patterns.push_back(std::move(pattern));
+    }
+    return patterns;
+}
+
+static std::unique_ptr<Heuristic> create_blind(const Workload& workload)
+{
+    return std::make_unique<blind_search_heuristic::BlindSearchHeuristic>(
+        workload.task);
+}
+
+static std::unique_ptr<Heuristic> create_goalcount(const Workload& workload)
+{
+    return std::make_unique<goal_count_heuristic::GoalCountHeuristic>(
+        workload.task);
+}
+
+static std::unique_ptr<Heuristic> create_hmax(const Workload& workload)
+{
+    return std::make_unique<max_heuristic::HSPMaxHeuristic>(workload.task);
+}
+
+static std::unique_ptr<Heuristic> create_ff(const Workload& workload)
+{
+    return std::make_unique<ff_heuristic::FFHeuristic>(workload.task);
+}
+
+static std::unique_ptr<Heuristic> create_pdb(const Workload& workload)
+{
+    return std::make_unique<pdbs::PDBHeuristic>(
+        workload.task,
+        get_pdb_pattern(workload.task_proxy));
+}
+
+static std::unique_ptr<Heuristic> create_cpdbs(const Workload& workload)
+{
+    return std::make_unique<pdbs::CliquesHeuristic>(
+        workload.task,
+        get_canonical_pdbs_patterns(workload.task_proxy));
+}
+
+template <
+    const Workload& (*get_workload)(int),
+    std::unique_ptr<Heuristic> (*create_heuristic)(const Workload&)>
+static void BM_ComputeHeuristic(benchmark::State& state)
+{
+    const Workload& workload = get_workload(state.range(0));
+    // Precomputation (e.g., of the PDBs) is not part of the measurement.
+    std::unique_ptr<Heuristic> heuristic;
+    try {
+        heuristic = create_heuristic(workload);
+        heuristic->compute_heuristic(workload.states[0]);
+    } catch (const std::runtime_error& error) {
+        // Heuristics left as exercises throw until they are implemented.
+        state.SkipWithError(error.what());
+        return;
+    }
+    int index = 0;
+    for (auto _ : state) {
+        int h = heuristic->compute_heuristic(workload.states[index]);
+        benchmark::DoNotOptimize(h);
+        if (++index == NUM_STATES) index = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+#define HEURISTIC_BENCHMARKS(get_workload, set_sizes)                          \
+    BENCHMARK_TEMPLATE(BM_ComputeHeuristic, get_workload, create_blind)        \
+        ->Apply(set_sizes);                                                    \
+    BENCHMARK_TEMPLATE(BM_ComputeHeuristic, get_workload, create_goalcount)    \
+        ->Apply(set_sizes);                                                    \
+    BENCHMARK_TEMPLATE(BM_ComputeHeuristic, get_workload, create_hmax)         \
+        ->Apply(set_sizes);                                                    \
+    BENCHMARK_TEMPLATE(BM_ComputeHeuristic, get_workload, create_ff)           \
+        ->Apply(set_sizes);                                                    \
+    BENCHMARK_TEMPLATE(BM_ComputeHeuristic, get_workload, create_pdb)          \
+        ->Apply(set_sizes);                                                    \
+    BENCHMARK_TEMPLATE(BM_ComputeHeuristic, get_workload, create_cpdbs)        \
+        ->Apply(set_sizes)
+
+HEURISTIC_BENCHMARKS(get_blocksworld, set_blocksworld_sizes);
+HEURISTIC_BENCHMARKS(get_gripper, set_gripper_sizes);
+HEURISTIC_BENCHMARKS(get_nomystery, set_nomystery_sizes);
+HEURISTIC_BENCHMARKS(get_sokoban, set_sokoban_sizes);
+HEURISTIC_BENCHMARKS(get_visitall, set_visitall_sizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,168 @@
+#include <benchmark/benchmark.h>
+
+#include "downward/concurrent_state_registry.h"
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <algorithm>
+#include <memory>
+#include <random>
+#include <vector>
+
+/*
+  Insertion throughput of the state registries. All benchmarks insert states
+  from a fixed set of distinct random states, so the first pass over the set
+  registers new states and later passes only detect duplicates.
+
+  Cache misses can be reported with Google Benchmark's perf counter support,
+  e.g. --benchmark_perf_counters=LLC-load-misses (requires libpfm).
+*/
+
+using namespace tests;
+
+static const int NUM_ROOMS = 4;
+static const int NUM_BALLS = 12;
+static const int NUM_DISTINCT_STATES = 1 << 18;
+
+namespace {
+struct Workload {
+    GripperProblem problem;
+    std::shared_ptr<ClassicalTask> task;
+    ClassicalTaskProxy task_proxy;
+    // NUM_DISTINCT_STATES states, stored consecutively.
+    std::vector<int> values;
+    int num_variables;
+
+    Workload()
+        : problem(NUM_ROOMS, NUM_BALLS)
+        , task(create_task(problem))
+        , task_proxy(*task)
+        , num_variables(task_proxy.get_variables().size())
+    {
+        std::mt19937 rng(2024);
+        for (int i = 0; i < NUM_DISTINCT_STATES; ++i) {
+            for (VariableProxy var : task_proxy.get_variables()) {
+                std::uniform_int_distribution<int> dist(
+                    0,
+                    var.get_domain_size() - 1);
+                values.push_back(dist(rng));
+            }
+        }
+    }
+
+    static std::shared_ptr<ClassicalTask>
+    create_task(const GripperProblem& problem)
+    {
+        std::vector<FactPair> initial_state = {
+            problem.get_fact_robot_at_room(0),
+            problem.get_fact_carry_left_none(),
+            problem.get_fact_carry_right_none()};
+        std::vector<FactPair> goal;
+        for (int b = 0; b < NUM_BALLS; ++b) {
+            initial_state.push_back(problem.get_fact_ball_at_room(b, 0));
+            goal.push_back(problem.get_fact_ball_at_room(b, 1));
+        }
+        return create_problem_task(problem, initial_state, goal);
+    }
+
+    std::span<const int> get_state(int index) const
+    {
+        return std::span<const int>(values).subspan(
+            index * num_variables,
+            num_variables);
+    }
+};
+} // namespace
+
+static const Workload& get_workload()
+{
+    static Workload workload;
+    return workload;
+}
+
+static void BM_StateRegistryInsert(benchmark::State& state)
+{
+    const Workload& workload = get_workload();
+    StateRegistry registry(workload.task_proxy);
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            registry.insert_states(workload.get_state(index), 1));
+        if (++index == NUM_DISTINCT_STATES) index = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.counters["registered_states"] = registry.size();
+}
+
+BENCHMARK(BM_StateRegistryInsert);
+
+/*
+  Duplicate detection only: all states are registered before the measurement
+  and then looked up in random order, so most probes of the hash set hit
+  buckets of other states.
+*/
+static void BM_StateRegistryFindDuplicates(benchmark::State& state)
+{
+    const Workload& workload = get_workload();
+    StateRegistry registry(workload.task_proxy);
+    registry.insert_states(workload.values, NUM_DISTINCT_STATES);
+    std::vector<int> order(NUM_DISTINCT_STATES);
+    for (int i = 0; i < NUM_DISTINCT_STATES; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), std::mt19937(2024));
+    int index = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            registry.find_state_id(workload.get_state(order[index])));
+        if (++index == NUM_DISTINCT_STATES) index = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_StateRegistryFindDuplicates);
+
+// Shared by all threads of a benchmark run.
+static std::unique_ptr<ConcurrentStateRegistry> shared_registry;
+
+static void set_up_shared_registry(const benchmark::State&)
+{
+    shared_registry = std::make_unique<ConcurrentStateRegistry>(
+        get_workload().task_proxy,
+        NUM_DISTINCT_STATES);
+}
+
+static void tear_down_shared_registry(const benchmark::State&)
+{
+    shared_registry.reset();
+}
+
+static void BM_ConcurrentStateRegistryInsert(benchmark::State& state)
+{
+    const Workload& workload = get_workload();
+    ConcurrentStateRegistry::ThreadHandle handle =
+        shared_registry->create_thread_handle();
+    // Spread the threads over the set of states.
+    int index = static_cast<int>(
+        static_cast<long long>(state.thread_index()) * NUM_DISTINCT_STATES /
+        state.threads());
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(
+            handle.insert_state(workload.get_state(index)));
+        if (++index == NUM_DISTINCT_STATES) index = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+    if (state.thread_index() == 0)
+        state.counters["registered_states"] = shared_registry->size();
+}
+
+BENCHMARK(BM_ConcurrentStateRegistryInsert)
+    ->Setup(set_up_shared_registry)
+    ->Teardown(tear_down_shared_registry)
+    ->Threads(1)
+    ->Threads(4)
+    ->Threads(16)
+    ->Threads(32)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,182 @@
+#include <benchmark/benchmark.h>
+
+#include "downward/state.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/successor_generator.h"
+
+#include "tests/tasks/blocksworld.h"
+#include "tests/tasks/gripper.h"
+#include "tests/tasks/nomystery.h"
+#include "tests/tasks/sokoban.h"
+#include "tests/tasks/visitall.h"
+
+#include <memory>
+#include <random>
+#include <set>
+#include <span>
+#include <vector>
+
+/*
+  Time per state of generate_applicable_ops for the tree, byte-code and
+  bitset successor generators on the test tasks. The states are random (not
+  necessarily reachable) assignments, so that the generators cannot profit
+  from consecutive states being similar.
+
+  BM_GenerateApplicableOpsBatch measures the time per state of
+  generate_applicable_ops_batch for batches of BATCH_SIZE states.
+*/
+
+using namespace tests;
+using successor_generator::Representation;
+
+static const int NUM_STATES = 1 << 12;
+static const int BATCH_SIZE = 256;
+
+namespace {
+struct Workload {
+    // The task refers to the problem, so the workload owns both.
+    std::unique_ptr<ClassicalPlanningProblem> problem;
+    std::shared_ptr<ClassicalTask> task;
+    ClassicalTaskProxy task_proxy;
+    std::vector<State> states;
+
+    explicit Workload(std::unique_ptr<ClassicalPlanningProblem> problem_)
+        : problem(std::move(problem_))
+        , task(create_task(*problem))
+        , task_proxy(*task)
+    {
+        std::mt19937 rng(2024);
+        for (int i = 0; i < NUM_STATES; ++i) {
+            std::vector<int> values;
+            for (VariableProxy var : task_proxy.get_variables()) {
+                std::uniform_int_distribution<int> dist(
+                    0,
+                    var.get_domain_size() - 1);
+                values.push_back(dist(rng));
+            }
+            states.emplace_back(*task, std::move(values));
+        }
+    }
+
+    // Only the operators matter, so any initial state and goal will do.
+    static std::shared_ptr<ClassicalTask>
+    create_task(const ClassicalPlanningProblem& problem)
+    {
+        std::vector<FactPair> initial_state;
+        for (int var = 0; var < problem.get_num_variables(); ++var)
+            initial_state.emplace_back(var, 0);
+        return create_problem_task(problem, initial_state, {});
+    }
+};
+} // namespace
+
+static const Workload& get_blocksworld()
+{
+    static Workload workload(std::make_unique<BlocksWorldProblem>(12));
+    return workload;
+}
+
+static const Workload& get_gripper()
+{
+    static Workload workload(std::make_unique<GripperProblem>(6, 20));
+    return workload;
+}
+
+static const Workload& get_nomystery()
+{
+    static const int num_locations = 12;
+    static Workload workload = []() {
+        std::set<RoadMapEdge> roadmap;
+        for (int l = 0; l + 1 < num_locations; ++l) {
+            roadmap.insert({l, l + 1});
+            roadmap.insert({l + 1, l});
+        }
+        return Workload(std::make_unique<NoMysteryProblem>(
+            num_locations,
+            10,
+            4,
+            roadmap));
+    }();
+    return workload;
+}
+
+static const Workload& get_sokoban()
+{
+    const SokobanGrid playarea = {
+        {' ', ' ', ' ', ' ', ' ', ' '},
+        {' ', 'G', ' ', ' ', 'G', ' '},
+        {' ', ' ', '#', '#', ' ', ' '},
+        {' ', 'G', ' ', ' ', 'G', ' '},
+        {' ', ' ', ' ', ' ', ' ', ' '}};
+    static Workload workload(std::make_unique<SokobanProblem>(playarea, 4));
+    return workload;
+}
+
+static const Workload& get_visitall()
+{
+    static Workload workload(std::make_unique<VisitAllProblem>(20, 20));
+    return workload;
+}
+
+template <const Workload& (*get_workload)(), Representation representation>
+static void BM_GenerateApplicableOps(benchmark::State& state)
+{
+    const Workload& workload = get_workload();
+    successor_generator::SuccessorGenerator generator(
+        workload.task_proxy,
+        representation);
+    std::vector<OperatorID> applicable_ops;
+    int index = 0;
+    for (auto _ : state) {
+        applicable_ops.clear();
+        generator.generate_applicable_ops(
+            workload.states[index],
+            applicable_ops);
+        benchmark::DoNotOptimize(applicable_ops.data());
+        if (++index == NUM_STATES) index = 0;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <const Workload& (*get_workload)()>
+static void BM_GenerateApplicableOpsBatch(benchmark::State& state)
+{
+    const Workload& workload = get_workload();
+    successor_generator::SuccessorGenerator generator(workload.task_proxy);
+    std::span<const State> states(workload.states);
+    successor_generator::ApplicableOpsBatch result;
+    int index = 0;
+    for (auto _ : state) {
+        generator.generate_applicable_ops_batch(
+            states.subspan(index, BATCH_SIZE),
+            result);
+        benchmark::DoNotOptimize(result.operators.data());
+        index += BATCH_SIZE;
+        if (index == NUM_STATES) index = 0;
+    }
+    state.SetItemsProcessed(state.iterations() * BATCH_SIZE);
+}
+
+#define SUCCESSOR_GENERATOR_BENCHMARKS(get_workload)                           \
+    BENCHMARK_TEMPLATE(                                                        \
+        BM_GenerateApplicableOps,                                              \
+        get_workload,                                                          \
+        Representation::TREE);                                                 \
+    BENCHMARK_TEMPLATE(                                                        \
+        BM_GenerateApplicableOps,                                              \
+        get_workload,                                                          \
+        Representation::BYTE_CODE);                                            \
+    BENCHMARK_TEMPLATE(                                                        \
+        BM_GenerateApplicableOps,                                              \
+        get_workload,                                                          \
+        Representation::BITSET);                                               \
+    BENCHMARK_TEMPLATE(BM_GenerateApplicableOpsBatch, get_workload)
+
+SUCCESSOR_GENERATOR_BENCHMARKS(get_blocksworld);
+SUCCESSOR_GENERATOR_BENCHMARKS(get_gripper);
+SUCCESSOR_GENERATOR_BENCHMARKS(get_nomystery);
+SUCCESSOR_GENERATOR_BENCHMARKS(get_sokoban);
+SUCCESSOR_GENERATOR_BENCHMARKS(get_visitall);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,58 @@
+#include "downward/algorithms/indexed_cache.h"
+
+#include <algorithm>
+#include <atomic>
+#include <utility>
+
+using namespace std;
+
+namespace indexed_cache {
+int IdPool::allocate()
+{
+    lock_guard<std::mutex> lock(mutex);
+    auto it = find(used.begin(), used.end(), false);
+    int id = it - used.begin();
+    if (it == used.end()) {
+        used.push_back(true);
+    } else {
+        *it = true;
+    }
+    return id;
+}
+
+void IdPool::release(int id)
+{
+    lock_guard<std::mutex> lock(mutex);
+    assert(used[id]);
+    used[id] = false;
+}
+
+static uint64_t create_serial()
+{
+    static atomic<uint64_t> next_serial(1);
+    return next_serial.fetch_add(1, memory_order_relaxed);
+}
+
+PooledId::PooledId(shared_ptr<IdPool> pool)
+    : pool(std::move(pool))
+    , id(this->pool->allocate())
+    , serial(create_serial())
+{
+}
+
+PooledId::~PooledId()
+{
+    pool->release(id);
+}
+
+IdPoolScope::IdPoolScope(shared_ptr<IdPool>& current)
+    : current(current)
+    , previous(exchange(current, make_shared<IdPool>()))
+{
+}
+
+IdPoolScope::~IdPoolScope()
+{
+    current = std::move(previous);
+}
+} // namespace indexed_cache
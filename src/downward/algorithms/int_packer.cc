@@ -1,6 +1,8 @@
 #include "downward/algorithms/int_packer.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstdint>
 
 using namespace std;
 
@@ -37,23 +39,38 @@ class IntPacker::VariableInfo {
     int shift;
     Bin read_mask;
     Bin clear_mask;
+    // Place value of the variable in a mixed-radix bin, 0 for bit fields.
+    Bin multiplier;
 
 public:
     VariableInfo(int range_, int bin_index_, int shift_)
         : range(range_)
         , bin_index(bin_index_)
         , shift(shift_)
+        , multiplier(0)
     {
         int bit_size = get_bit_size_for_range(range);
         read_mask = get_bit_mask(shift, shift + bit_size);
         clear_mask = ~read_mask;
     }
 
+    VariableInfo(int range_, int bin_index_, Bin multiplier_)
+        : range(range_)
+        , bin_index(bin_index_)
+        , shift(0)
+        , read_mask(0)
+        , clear_mask(0)
+        , multiplier(multiplier_)
+    {
+        assert(multiplier > 0);
+    }
+
     VariableInfo()
         : bin_index(-1)
         , shift(0)
         , read_mask(0)
         , clear_mask(0)
+        , multiplier(0)
     {
         // Default constructor needed for resize() in pack_bins.
     }
@@ -62,6 +79,7 @@ public:
 
     int get(const Bin* buffer) const
     {
+        if (multiplier) return buffer[bin_index] / multiplier % range;
         return (buffer[bin_index] & read_mask) >> shift;
     }
 
@@ -69,14 +87,25 @@ public:
     {
         assert(value >= 0 && value < range);
         Bin& bin = buffer[bin_index];
-        bin = (bin & clear_mask) | (value << shift);
+        if (multiplier) {
+            /*
+              The difference may be negative, but the result is exact because
+              unsigned arithmetic wraps around and the final bin value fits.
+            */
+            bin += (Bin(value) - Bin(get(buffer))) * multiplier;
+        } else {
+            bin = (bin & clear_mask) | (value << shift);
+        }
     }
 };
 
-IntPacker::IntPacker(const vector<int>& ranges)
+IntPacker::IntPacker(const vector<int>& ranges, Encoding encoding)
     : num_bins(0)
 {
-    pack_bins(ranges);
+    if (encoding == Encoding::MIXED_RADIX)
+        pack_bins_mixed_radix(ranges);
+    else
+        pack_bins(ranges);
 }
 
 IntPacker::~IntPacker()
@@ -117,6 +146,48 @@ void IntPacker::pack_bins(const vector<int>& ranges)
         packed_vars += pack_one_bin(ranges, bits_to_vars);
 }
 
+void IntPacker::pack_bins_mixed_radix(const vector<int>& ranges)
+{
+    assert(var_infos.empty());
+
+    int num_vars = ranges.size();
+    var_infos.resize(num_vars);
+
+    /*
+      First-fit decreasing: consider the variables in order of decreasing
+      range (preferring low indices in case of ties) and put each variable
+      into the first bin where the product of the ranges still fits. Large
+      variables are placed first, so that the small ones can fill the gaps.
+    */
+    vector<int> vars(num_vars);
+    for (int var = 0; var < num_vars; ++var)
+        vars[var] = var;
+    stable_sort(vars.begin(), vars.end(), [&](int var1, int var2) {
+        return ranges[var1] > ranges[var2];
+    });
+
+    const uint64_t max_capacity = uint64_t(1) << BITS_PER_BIN;
+    // Product of the ranges of the variables packed into each bin.
+    vector<uint64_t> bin_capacities;
+    for (int var : vars) {
+        uint64_t range = ranges[var];
+        assert(range >= 1);
+        int bin_index = 0;
+        // A full bin leaves no room for a multiplier, even for range 1.
+        while (bin_index < num_bins &&
+               (bin_capacities[bin_index] == max_capacity ||
+                bin_capacities[bin_index] * range > max_capacity))
+            ++bin_index;
+        if (bin_index == num_bins) {
+            ++num_bins;
+            bin_capacities.push_back(1);
+        }
+        Bin multiplier = bin_capacities[bin_index];
+        var_infos[var] = VariableInfo(ranges[var], bin_index, multiplier);
+        bin_capacities[bin_index] *= range;
+    }
+}
+
 int IntPacker::pack_one_bin(
     const vector<int>& ranges,
     vector<vector<int>>& bits_to_vars)
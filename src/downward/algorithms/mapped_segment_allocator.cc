@@ -0,0 +1,192 @@
+#include "downward/algorithms/mapped_segment_allocator.h"
+
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace mapped_segment_allocator {
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+static size_t get_page_size()
+{
+    static const size_t page_size = sysconf(_SC_PAGESIZE);
+    return page_size;
+}
+
+static size_t round_up_to_pages(size_t bytes)
+{
+    size_t page_size = get_page_size();
+    return (bytes + page_size - 1) / page_size * page_size;
+}
+
+MappedArena::MappedArena(
+    const string& directory,
+    size_t chunk_bytes,
+    size_t num_hot_chunks)
+    : chunk_bytes(round_up_to_pages(chunk_bytes))
+    , num_hot_chunks(num_hot_chunks)
+    , file_descriptor(-1)
+    , file_size(0)
+    , used_bytes(0)
+{
+    string path_template =
+        (directory.empty() ? string(".") : directory) + "/fd-states-XXXXXX";
+    vector<char> path(path_template.begin(), path_template.end());
+    path.push_back('\0');
+    file_descriptor = mkstemp(path.data());
+    if (file_descriptor == -1) {
+        cerr << "Could not create state storage file in " << directory << ": "
+             << strerror(errno) << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    // The file is deleted as soon as it is closed.
+    unlink(path.data());
+}
+
+MappedArena::~MappedArena()
+{
+    for (const Chunk& chunk : chunks) munmap(chunk.address, chunk.bytes);
+    close(file_descriptor);
+}
+
+void MappedArena::map_chunk(size_t min_bytes)
+{
+    size_t bytes = max(chunk_bytes, round_up_to_pages(min_bytes));
+    if (ftruncate(file_descriptor, file_size + bytes) == -1) {
+        cerr << "Could not grow state storage file: " << strerror(errno)
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    void* address = mmap(
+        nullptr,
+        bytes,
+        PROT_READ | PROT_WRITE,
+        MAP_SHARED,
+        file_descriptor,
+        file_size);
+    if (address == MAP_FAILED) {
+        cerr << "Could not map state storage file: " << strerror(errno)
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    file_size += bytes;
+    chunks.push_back({static_cast<char*>(address), bytes});
+    used_bytes = 0;
+    mark_cold_chunks();
+}
+
+void MappedArena::mark_cold_chunks()
+{
+#ifdef MADV_COLD
+    /*
+      Only the chunk that just dropped out of the hot window needs a hint;
+      older chunks have been marked before.
+    */
+    if (chunks.size() > num_hot_chunks) {
+        const Chunk& chunk = chunks[chunks.size() - num_hot_chunks - 1];
+        madvise(chunk.address, chunk.bytes, MADV_COLD);
+    }
+#endif
+}
+
+void* MappedArena::allocate(size_t bytes, size_t alignment)
+{
+    assert(alignment <= get_page_size());
+    size_t offset = (used_bytes + alignment - 1) / alignment * alignment;
+    if (chunks.empty() || offset + bytes > chunks.back().bytes) {
+        map_chunk(bytes);
+        offset = 0;
+    }
+    used_bytes = offset + bytes;
+    return chunks.back().address + offset;
+}
+
+size_t MappedArena::get_mapped_bytes() const
+{
+    return file_size;
+}
+
+size_t MappedArena::get_resident_bytes() const
+{
+    // The type of the page flags differs between Linux and OSX.
+#if OPERATING_SYSTEM == OSX
+    using PageFlags = char;
+#else
+    using PageFlags = unsigned char;
+#endif
+    size_t page_size = get_page_size();
+    size_t resident_pages = 0;
+    vector<PageFlags> page_flags;
+    for (const Chunk& chunk : chunks) {
+        page_flags.resize(chunk.bytes / page_size);
+        if (mincore(chunk.address, chunk.bytes, page_flags.data()) == 0) {
+            for (PageFlags flags : page_flags) resident_pages += flags & 1;
+        }
+    }
+    return resident_pages * page_size;
+}
+#else
+/*
+  Memory-mapped files are not supported on this platform, so the arena
+  allocates its chunks on the heap and all memory counts as resident.
+*/
+MappedArena::MappedArena(const string&, size_t chunk_bytes, size_t)
+    : chunk_bytes(chunk_bytes)
+    , num_hot_chunks(0)
+    , file_descriptor(-1)
+    , file_size(0)
+    , used_bytes(0)
+{
+    cerr << "Warning: memory-mapped state storage is not supported on this "
+         << "platform. Using the heap instead." << endl;
+}
+
+MappedArena::~MappedArena()
+{
+    for (const Chunk& chunk : chunks) delete[] chunk.address;
+}
+
+void MappedArena::map_chunk(size_t min_bytes)
+{
+    size_t bytes = max(chunk_bytes, min_bytes);
+    chunks.push_back({new char[bytes], bytes});
+    file_size += bytes;
+    used_bytes = 0;
+}
+
+void MappedArena::mark_cold_chunks()
+{
+}
+
+void* MappedArena::allocate(size_t bytes, size_t alignment)
+{
+    size_t offset = (used_bytes + alignment - 1) / alignment * alignment;
+    if (chunks.empty() || offset + bytes > chunks.back().bytes) {
+        map_chunk(bytes);
+        offset = 0;
+    }
+    used_bytes = offset + bytes;
+    return chunks.back().address + offset;
+}
+
+size_t MappedArena::get_mapped_bytes() const
+{
+    return file_size;
+}
+
+size_t MappedArena::get_resident_bytes() const
+{
+    return file_size;
+}
+#endif
+} // namespace mapped_segment_allocator
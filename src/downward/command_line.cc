@@ -143,6 +143,34 @@ static shared_ptr<SearchAlgorithm> parse_cmd_line_aux(
     return algorithm;
 }
 
+static bool is_task_input_option(const string& arg)
+{
+    return arg == "--binary-task" || arg == "--write-binary-task" ||
+           arg == "--sas-parser-threads";
+}
+
+TaskInputOptions parse_task_input_options(int argc, const char** argv)
+{
+    TaskInputOptions options;
+    for (int i = 1; i < argc; ++i) {
+        string arg = sanitize_arg_string(argv[i]);
+        if (!is_task_input_option(arg)) continue;
+        if (i == argc - 1) throw ArgError("missing argument after " + arg);
+        ++i;
+        if (arg == "--binary-task") {
+            options.binary_task_filename = argv[i];
+        } else if (arg == "--write-binary-task") {
+            options.write_binary_task_filename = argv[i];
+        } else {
+            options.sas_parser_threads = parse_int_arg(arg, argv[i]);
+            if (options.sas_parser_threads < 1)
+                throw ArgError(
+                    "argument for --sas-parser-threads must be positive");
+        }
+    }
+    return options;
+}
+
 shared_ptr<SearchAlgorithm> parse_cmd_line(
     int argc,
     const char** argv,
@@ -155,7 +183,10 @@ shared_ptr<SearchAlgorithm> parse_cmd_line(
     for (int i = 1; i < argc; ++i) {
         string arg = sanitize_arg_string(argv[i]);
 
-        if (arg == "--if-unit-cost") {
+        if (is_task_input_option(arg)) {
+            // Handled by parse_task_input_options.
+            ++i;
+        } else if (arg == "--if-unit-cost") {
             active = is_unit_cost;
         } else if (arg == "--if-non-unit-cost") {
             active = !is_unit_cost;
@@ -187,6 +218,18 @@ string usage(const string& progname)
            "--evaluator EVALUATOR_PREDEFINITION\n"
            "    Predefines an evaluator that can afterwards be referenced\n"
            "    by the name that is specified in the definition.\n"
+           "--binary-task FILENAME\n"
+           "    Read the task from the binary task file FILENAME instead "
+           "of OUTPUT.\n"
+           "    The successor generator stored in the file is used for\n"
+           "    successor_generator=byte_code.\n"
+           "--write-binary-task FILENAME\n"
+           "    Write the task read from OUTPUT to the binary task file "
+           "FILENAME.\n"
+           "    Without --search, the planner stops after writing it.\n"
+           "--sas-parser-threads N\n"
+           "    Parse the operators of large tasks in OUTPUT with N "
+           "threads.\n"
            "--internal-plan-file FILENAME\n"
            "    Plan will be output to a file called FILENAME\n\n"
            "--internal-previous-portfolio-plans COUNTER\n"
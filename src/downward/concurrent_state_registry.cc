@@ -0,0 +1,264 @@
+#include "downward/concurrent_state_registry.h"
+
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/hash.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <limits>
+
+using namespace std;
+
+/*
+  Every thread handle may leave the tail of its current pool segment unused.
+  We reserve enough IDs for this many partially filled segments in addition to
+  the maximum number of states.
+*/
+static const size_t MAX_PARTIAL_SEGMENTS = 1024;
+
+static const uint64_t EMPTY_BUCKET = 0;
+
+/*
+  The low bits of the 64-bit hash select the bucket, the high 32 bits are
+  stored in it to skip most comparisons with states of other buckets.
+*/
+static uint32_t get_fingerprint(uint64_t hash)
+{
+    return static_cast<uint32_t>(hash >> 32);
+}
+
+static uint64_t make_bucket(uint32_t fingerprint, int id_value)
+{
+    assert(id_value >= 0);
+    return (static_cast<uint64_t>(fingerprint) << 32) |
+           static_cast<uint32_t>(id_value + 1);
+}
+
+static uint32_t get_bucket_fingerprint(uint64_t bucket)
+{
+    return static_cast<uint32_t>(bucket >> 32);
+}
+
+static int get_bucket_id_value(uint64_t bucket)
+{
+    return static_cast<int>(static_cast<uint32_t>(bucket)) - 1;
+}
+
+static size_t compute_pool_capacity(size_t max_states, int bins_per_state)
+{
+    size_t arrays_per_segment = concurrent_segmented_vector::
+        ConcurrentSegmentedArrayVector<PackedStateBin>::
+            compute_arrays_per_segment(bins_per_state);
+    size_t capacity = max_states + MAX_PARTIAL_SEGMENTS * arrays_per_segment;
+    // IDs must fit into an int and leave room for the empty marker.
+    if (capacity >= static_cast<size_t>(numeric_limits<int>::max())) {
+        cerr << "Concurrent state registry cannot hold " << max_states
+             << " states." << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    return capacity;
+}
+
+ConcurrentStateRegistry::ThreadHandle::ThreadHandle(
+    ConcurrentStateRegistry& registry)
+    : registry(&registry)
+    , reserved_index(0)
+    , segment_end(0)
+    , reserved_buffer(nullptr)
+{
+}
+
+PackedStateBin* ConcurrentStateRegistry::ThreadHandle::reserve_slot()
+{
+    if (!reserved_buffer) {
+        if (reserved_index == segment_end) registry->claim_segment(*this);
+        reserved_buffer = registry->state_data_pool[reserved_index];
+    }
+    return reserved_buffer;
+}
+
+StateID
+ConcurrentStateRegistry::ThreadHandle::insert_state(span<const int> values)
+{
+    assert(values.size() == static_cast<size_t>(registry->num_variables));
+    PackedStateBin* buffer = reserve_slot();
+    // Avoid garbage values in half-full bins.
+    fill_n(buffer, registry->bins_per_state, 0);
+    for (int var = 0; var < registry->num_variables; ++var) {
+        registry->state_packer.set(buffer, var, values[var]);
+    }
+    return registry->register_reserved_slot(*this);
+}
+
+ConcurrentStateRegistry::ConcurrentStateRegistry(
+    const PlanningTaskProxy& task_proxy,
+    size_t max_states)
+    : task_proxy(task_proxy)
+    , state_packer(task_properties::g_state_packers[task_proxy])
+    , num_variables(task_proxy.get_variables().size())
+    , bins_per_state(state_packer.get_num_bins())
+    , max_states(max_states)
+    , state_data_pool(
+          bins_per_state,
+          compute_pool_capacity(max_states, bins_per_state))
+    , num_claimed_segments(0)
+    , buckets(nullptr)
+    , bucket_mask(bit_ceil(max<size_t>(2 * max_states, 16)) - 1)
+    , num_registered_states(0)
+{
+    buckets.reset(new atomic<uint64_t>[bucket_mask + 1]);
+    for (size_t i = 0; i <= bucket_mask; ++i)
+        buckets[i].store(EMPTY_BUCKET, memory_order_relaxed);
+}
+
+ConcurrentStateRegistry::ThreadHandle
+ConcurrentStateRegistry::create_thread_handle()
+{
+    return ThreadHandle(*this);
+}
+
+void ConcurrentStateRegistry::claim_segment(ThreadHandle& handle)
+{
+    size_t segment = num_claimed_segments.fetch_add(1, memory_order_relaxed);
+    if (segment >= state_data_pool.get_max_segments()) {
+        cerr << "Concurrent state registry ran out of state IDs." << endl;
+        utils::oom_exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+    }
+    size_t arrays_per_segment = state_data_pool.get_arrays_per_segment();
+    handle.reserved_index = segment * arrays_per_segment;
+    handle.segment_end = handle.reserved_index + arrays_per_segment;
+}
+
+uint64_t ConcurrentStateRegistry::compute_hash(
+    const PackedStateBin* buffer) const
+{
+    utils::HashState hash_state;
+    for (int i = 0; i < bins_per_state; ++i) {
+        hash_state.feed(buffer[i]);
+    }
+    return hash_state.get_hash64();
+}
+
+StateID
+ConcurrentStateRegistry::find_packed_state(const PackedStateBin* buffer) const
+{
+    uint64_t hash = compute_hash(buffer);
+    uint32_t fingerprint = get_fingerprint(hash);
+    for (size_t i = hash & bucket_mask;; i = (i + 1) & bucket_mask) {
+        uint64_t bucket = buckets[i].load(memory_order_acquire);
+        if (bucket == EMPTY_BUCKET) return StateID::no_state;
+        if (get_bucket_fingerprint(bucket) == fingerprint) {
+            int id_value = get_bucket_id_value(bucket);
+            const PackedStateBin* data = state_data_pool.lookup(id_value);
+            if (equal(buffer, buffer + bins_per_state, data))
+                return StateID(id_value);
+        }
+    }
+}
+
+StateID ConcurrentStateRegistry::register_reserved_slot(ThreadHandle& handle)
+{
+    assert(handle.reserved_buffer);
+    const PackedStateBin* buffer = handle.reserved_buffer;
+    uint64_t hash = compute_hash(buffer);
+    uint32_t fingerprint = get_fingerprint(hash);
+    int id_value = static_cast<int>(handle.reserved_index);
+    uint64_t new_bucket = make_bucket(fingerprint, id_value);
+
+    size_t num_probes = 0;
+    for (size_t i = hash & bucket_mask;; i = (i + 1) & bucket_mask) {
+        uint64_t bucket = buckets[i].load(memory_order_acquire);
+        if (bucket == EMPTY_BUCKET) {
+            /*
+              The release order publishes the packed state together with the
+              bucket. On failure, another thread has just filled this bucket,
+              which we then check like any other occupied bucket.
+            */
+            if (buckets[i].compare_exchange_strong(
+                    bucket,
+                    new_bucket,
+                    memory_order_release,
+                    memory_order_acquire)) {
+                size_t num_states =
+                    num_registered_states.fetch_add(1, memory_order_relaxed) +
+                    1;
+                if (num_states > max_states) {
+                    cerr << "Concurrent state registry is full ("
+                         << max_states << " states)." << endl;
+                    utils::oom_exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+                }
+                ++handle.reserved_index;
+                handle.reserved_buffer = nullptr;
+                return StateID(id_value);
+            }
+        }
+        if (get_bucket_fingerprint(bucket) == fingerprint) {
+            int other_id_value = get_bucket_id_value(bucket);
+            const PackedStateBin* data = state_data_pool.lookup(other_id_value);
+            if (equal(buffer, buffer + bins_per_state, data))
+                return StateID(other_id_value);
+        }
+        if (++num_probes > bucket_mask) {
+            cerr << "Concurrent state registry is full (" << max_states
+                 << " states)." << endl;
+            utils::oom_exit_with(utils::ExitCode::SEARCH_OUT_OF_MEMORY);
+        }
+    }
+}
+
+const PackedStateBin* ConcurrentStateRegistry::lookup_packed_state(
+    StateID id) const
+{
+    assert(id != StateID::no_state);
+    const PackedStateBin* data = state_data_pool.lookup(id.value);
+    assert(data);
+    return data;
+}
+
+vector<int> ConcurrentStateRegistry::lookup_state_values(StateID id) const
+{
+    const PackedStateBin* buffer = lookup_packed_state(id);
+    vector<int> values(num_variables);
+    for (int var = 0; var < num_variables; ++var) {
+        values[var] = state_packer.get(buffer, var);
+    }
+    return values;
+}
+
+StateID ConcurrentStateRegistry::find_state_id(span<const int> values) const
+{
+    assert(values.size() == static_cast<size_t>(num_variables));
+    vector<PackedStateBin> buffer(bins_per_state, 0);
+    for (int var = 0; var < num_variables; ++var) {
+        state_packer.set(buffer.data(), var, values[var]);
+    }
+    return find_packed_state(buffer.data());
+}
+
+size_t ConcurrentStateRegistry::get_id_bound() const
+{
+    return min(
+               num_claimed_segments.load(memory_order_relaxed),
+               state_data_pool.get_max_segments()) *
+           state_data_pool.get_arrays_per_segment();
+}
+
+int ConcurrentStateRegistry::get_state_size_in_bytes() const
+{
+    return bins_per_state * sizeof(PackedStateBin);
+}
+
+void ConcurrentStateRegistry::print_statistics(utils::LogProxy& log) const
+{
+    log << "Number of registered states: " << size() << endl;
+    log << "Concurrent state registry buckets: " << bucket_mask + 1 << endl;
+    log << "Concurrent state registry load factor: "
+        << static_cast<double>(size()) / (bucket_mask + 1) << endl;
+    log << "Concurrent state registry pool: "
+        << state_data_pool.get_allocated_bytes() / 1024 << " KB in "
+        << num_claimed_segments.load(memory_order_relaxed) << " segments"
+        << endl;
+}
@@ -7,21 +7,20 @@
 #include "neuralfd/policy.h"
 
 #include <cassert>
+#include <chrono>
 
 using namespace std;
 
 EvaluationContext::EvaluationContext(
-    const EvaluatorCache& cache,
-    const PolicyCache& policy_cache,
-    const State& state,
+    const EvaluationContext& other,
     int g_value,
     bool is_preferred,
     SearchStatistics* statistics,
     bool calculate_preferred,
     bool report_confidence)
-    : cache(cache)
-    , policy_cache(policy_cache)
-    , state(state)
+    : cache(other.cache)
+    , policy_cache(other.policy_cache)
+    , state(other.state)
     , g_value(g_value)
     , preferred(is_preferred)
     , statistics(statistics)
@@ -30,25 +29,6 @@ EvaluationContext::EvaluationContext(
 {
 }
 
-EvaluationContext::EvaluationContext(
-    const EvaluationContext& other,
-    int g_value,
-    bool is_preferred,
-    SearchStatistics* statistics,
-    bool calculate_preferred,
-    bool report_confidence)
-    : EvaluationContext(
-          other.cache,
-          other.policy_cache,
-          other.state,
-          g_value,
-          is_preferred,
-          statistics,
-          calculate_preferred,
-          report_confidence)
-{
-}
-
 EvaluationContext::EvaluationContext(
     const State& state,
     int g_value,
@@ -56,15 +36,12 @@ EvaluationContext::EvaluationContext(
     SearchStatistics* statistics,
     bool calculate_preferred,
     bool report_confidence)
-    : EvaluationContext(
-          EvaluatorCache(),
-          PolicyCache(),
-          state,
-          g_value,
-          is_preferred,
-          statistics,
-          calculate_preferred,
-          report_confidence)
+    : state(state)
+    , g_value(g_value)
+    , preferred(is_preferred)
+    , statistics(statistics)
+    , calculate_preferred(calculate_preferred)
+    , report_confidence(report_confidence)
 {
 }
 
@@ -74,8 +51,6 @@ EvaluationContext::EvaluationContext(
     bool calculate_preferred,
     bool report_confidence)
     : EvaluationContext(
-          EvaluatorCache(),
-          PolicyCache(),
           state,
           INVALID,
           false,
@@ -89,7 +64,15 @@ const EvaluationResult& EvaluationContext::get_result(Evaluator* evaluator)
 {
     EvaluationResult& result = cache[evaluator];
     if (result.is_uninitialized()) {
-        result = evaluator->compute_result(*this);
+        if (statistics && statistics->is_timing_evaluators()) {
+            auto start = chrono::steady_clock::now();
+            result = evaluator->compute_result(*this);
+            chrono::duration<double> elapsed =
+                chrono::steady_clock::now() - start;
+            statistics->report_evaluator_call(evaluator, elapsed.count());
+        } else {
+            result = evaluator->compute_result(*this);
+        }
         if (statistics && result.get_count_evaluation()) {
             statistics->inc_evaluations();
         }
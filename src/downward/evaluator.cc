@@ -5,24 +5,45 @@
 
 #include "downward/evaluation_context.h"
 
+#include "downward/algorithms/indexed_cache.h"
+
 #include "downward/utils/system.h"
 
 #include <cassert>
+#include <memory>
 
 using namespace std;
 
+static shared_ptr<indexed_cache::IdPool>& get_evaluator_ids()
+{
+    // The pool that new evaluators of this thread take their IDs from.
+    static const shared_ptr<indexed_cache::IdPool> shared_ids =
+        make_shared<indexed_cache::IdPool>();
+    thread_local shared_ptr<indexed_cache::IdPool> evaluator_ids = shared_ids;
+    return evaluator_ids;
+}
+
+EvaluatorIdScope::EvaluatorIdScope()
+    : scope(get_evaluator_ids())
+{
+}
+
 Evaluator::Evaluator(const options::Options& opts)
     : description(opts.get_unparsed_config())
+    , id(get_evaluator_ids())
     , log(utils::get_log_from_options(opts))
 {
 }
 
 Evaluator::Evaluator(std::string description, utils::LogProxy log)
     : description(std::move(description))
+    , id(get_evaluator_ids())
     , log(log)
 {
 }
 
+Evaluator::~Evaluator() = default;
+
 bool Evaluator::dead_ends_are_reliable() const
 {
     return true;
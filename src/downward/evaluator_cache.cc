@@ -1,5 +1,7 @@
 #include "downward/evaluator_cache.h"
 
+#include "downward/evaluator.h"
+
 using namespace std;
 
 EvaluationResult& EvaluatorCache::operator[](Evaluator* eval)
@@ -17,20 +17,23 @@ using namespace std;
 
 Heuristic::Heuristic(const Options& opts)
     : Evaluator(opts)
-    , heuristic_cache(HEntry(NO_VALUE, true))
+    , cache_evaluator_values(opts.get<bool>("cache_estimates"))
     , task(opts.get<shared_ptr<ClassicalTask>>("transform"))
     , task_proxy(*task)
+    , compiled_task(compiled_task::g_compiled_tasks[task_proxy])
 {
 }
 
 Heuristic::Heuristic(
     std::string description,
     utils::LogProxy log,
-    std::shared_ptr<ClassicalTask> task)
+    std::shared_ptr<ClassicalTask> task,
+    bool cache_estimates)
     : Evaluator(std::move(description), log)
-    , heuristic_cache(HEntry(NO_VALUE, true))
+    , cache_evaluator_values(cache_estimates)
     , task(std::move(task))
     , task_proxy(*this->task)
+    , compiled_task(compiled_task::g_compiled_tasks[task_proxy])
 {
 }
 
@@ -46,6 +49,11 @@ void Heuristic::add_options_to_parser(OptionParser& parser)
         "Optional task transformation for the heuristic."
         " Currently, adapt_costs() and no_transform() are available.",
         "no_transform()");
+    parser.add_option<bool>(
+        "cache_estimates",
+        "cache heuristic estimates of registered states; turning this off "
+        "pays off for heuristics that are cheaper to compute than to look up",
+        "true");
 }
 
 std::pair<int, double>
@@ -69,13 +77,23 @@ EvaluationResult Heuristic::compute_result(EvaluationContext& eval_context)
 
     int heuristic = NO_VALUE;
 
-    if (!calculate_preferred && heuristic_cache[state].h != NO_VALUE &&
-        !heuristic_cache[state].dirty) {
-        heuristic = heuristic_cache[state].h;
-        result.set_count_evaluation(false);
+    /*
+      Unregistered states (e.g. in IDA*) have no slot in the cache, so we
+      compute their estimates from scratch every time. The cache entry is
+      looked up once and then read and written through the same handle.
+    */
+    if (cache_evaluator_values && state.get_id() != StateID::no_state) {
+        auto entry = heuristic_cache[state];
+        if (!calculate_preferred && entry.has_value() && !entry.is_dirty()) {
+            heuristic = entry.get_value();
+            result.set_count_evaluation(false);
+        } else {
+            heuristic = compute_heuristic(state);
+            entry.set_value(heuristic);
+            result.set_count_evaluation(true);
+        }
     } else {
         heuristic = compute_heuristic(state);
-        heuristic_cache[state] = HEntry(heuristic, false);
         result.set_count_evaluation(true);
     }
 
@@ -111,15 +129,23 @@ EvaluationResult Heuristic::compute_result(EvaluationContext& eval_context)
     return result;
 }
 
+bool Heuristic::does_cache_estimates() const
+{
+    return cache_evaluator_values;
+}
+
 bool Heuristic::is_estimate_cached(const State& state) const
 {
-    return heuristic_cache[state].h != NO_VALUE;
+    if (!cache_evaluator_values || state.get_id() == StateID::no_state) {
+        return false;
+    }
+    return heuristic_cache.get_value(state) != NO_VALUE;
 }
 
 int Heuristic::get_cached_estimate(const State& state) const
 {
     assert(is_estimate_cached(state));
-    return heuristic_cache[state].h;
+    return heuristic_cache.get_value(state);
 }
 
 static PluginTypePlugin<Heuristic> _type_plugin(
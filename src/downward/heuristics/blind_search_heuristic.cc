@@ -14,14 +14,16 @@ namespace blind_search_heuristic {
 BlindSearchHeuristic::BlindSearchHeuristic(const Options& opts)
     : BlindSearchHeuristic(
           opts.get<std::shared_ptr<ClassicalTask>>("transform"),
-          utils::get_log_from_options(opts))
+          utils::get_log_from_options(opts),
+          opts.get<bool>("cache_estimates"))
 {
 }
 
 BlindSearchHeuristic::BlindSearchHeuristic(
     std::shared_ptr<ClassicalTask> task,
-    utils::LogProxy log)
-    : Heuristic("blind", log, std::move(task))
+    utils::LogProxy log,
+    bool cache_estimates)
+    : Heuristic("blind", log, std::move(task), cache_estimates)
 {
     // TODO Initialize the heuristic, if needed.
 }
@@ -13,15 +13,17 @@ CliquesHeuristic::CliquesHeuristic(const Options& opts)
     : CliquesHeuristic(
           opts.get<std::shared_ptr<ClassicalTask>>("transform"),
           opts.get_list<Pattern>("patterns"),
-          utils::get_log_from_options(opts))
+          utils::get_log_from_options(opts),
+          opts.get<bool>("cache_estimates"))
 {
 }
 
 CliquesHeuristic::CliquesHeuristic(
     std::shared_ptr<ClassicalTask> task,
     PatternCollection pattern_collection,
-    utils::LogProxy log)
-    : Heuristic("cpdbs", log, task)
+    utils::LogProxy log,
+    bool cache_estimates)
+    : Heuristic("cpdbs", log, task, cache_estimates)
 {
     // TODO construct the pattern database lookup tables for each pattern here.
     // Afterwards, compute the maximal additive pattern subcollections (maximum
@@ -10,14 +10,20 @@ namespace ff_heuristic {
 FFHeuristic::FFHeuristic(const Options& opts)
     : FFHeuristic(
           opts.get<std::shared_ptr<ClassicalTask>>("transform"),
-          utils::get_log_from_options(opts))
+          utils::get_log_from_options(opts),
+          opts.get<bool>("cache_estimates"))
 {
 }
 
 FFHeuristic::FFHeuristic(
     std::shared_ptr<ClassicalTask> task,
-    utils::LogProxy log)
-    : RelaxationHeuristic("hFF", std::move(task), std::move(log))
+    utils::LogProxy log,
+    bool cache_estimates)
+    : RelaxationHeuristic(
+          "hFF",
+          std::move(task),
+          std::move(log),
+          cache_estimates)
 {
     // TODO Initialize the heuristic, if needed.
     utils::throw_not_implemented();
@@ -9,34 +9,23 @@ namespace goal_count_heuristic {
 GoalCountHeuristic::GoalCountHeuristic(const Options& opts)
     : GoalCountHeuristic(
           opts.get<std::shared_ptr<ClassicalTask>>("transform"),
-          utils::get_log_from_options(opts))
+          utils::get_log_from_options(opts),
+          opts.get<bool>("cache_estimates"))
 {
 }
 
 GoalCountHeuristic::GoalCountHeuristic(
     std::shared_ptr<ClassicalTask> task,
-    utils::LogProxy log)
-    : Heuristic("goal_counting", log, task)
+    utils::LogProxy log,
+    bool cache_estimates)
+    : Heuristic("goal_counting", log, task, cache_estimates)
 {
     // TODO Initialize the heuristic, if needed.
 }
 
 int GoalCountHeuristic::compute_heuristic(const State& state)
 {
-    // TODO Return number of missing goal facts.
-
-     GoalProxy goal = task_proxy.get_goal();
-
-     int h = 0;
-     for (int i = 0; i < goal.size(); i++) {
-         // Do something with the goal fact...
-         FactProxy goal_fact = goal[i];
-         int index = goal_fact.get_variable().get_id();
-            if(!(state[index].get_value() == goal_fact.get_value())){
-                h++;
-        }
-    }
-    return h;
+    return compiled_task.get_num_unsatisfied_goals(state.get_unpacked_values());
 }
 
 static std::shared_ptr<Heuristic> _parse(OptionParser& parser)
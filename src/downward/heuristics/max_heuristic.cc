@@ -10,14 +10,20 @@ namespace max_heuristic {
 HSPMaxHeuristic::HSPMaxHeuristic(const Options& opts)
     : HSPMaxHeuristic(
           opts.get<std::shared_ptr<ClassicalTask>>("transform"),
-          utils::get_log_from_options(opts))
+          utils::get_log_from_options(opts),
+          opts.get<bool>("cache_estimates"))
 {
 }
 
 HSPMaxHeuristic::HSPMaxHeuristic(
     std::shared_ptr<ClassicalTask> task,
-    utils::LogProxy log)
-    : RelaxationHeuristic("hmax", std::move(task), std::move(log))
+    utils::LogProxy log,
+    bool cache_estimates)
+    : RelaxationHeuristic(
+          "hmax",
+          std::move(task),
+          std::move(log),
+          cache_estimates)
 {
     // TODO Initialize the heuristic, if needed.
 }
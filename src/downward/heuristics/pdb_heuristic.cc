@@ -15,7 +15,8 @@ PDBHeuristic::PDBHeuristic(const Options& opts)
     : PDBHeuristic(
           opts.get<std::shared_ptr<ClassicalTask>>("transform"),
           opts.get_list<int>("pattern"),
-          utils::get_log_from_options(opts))
+          utils::get_log_from_options(opts),
+          opts.get<bool>("cache_estimates"))
 {
 }
 
@@ -58,8 +59,9 @@ int PDBHeuristic::find_successor(const State& state, const std::vector<FactPair>
 PDBHeuristic::PDBHeuristic(
     std::shared_ptr<ClassicalTask> task,
     Pattern pattern,
-    utils::LogProxy log)
-    : Heuristic("pdb", log, task)
+    utils::LogProxy log,
+    bool cache_estimates)
+    : Heuristic("pdb", log, task, cache_estimates)
 {
     std::vector<State> A_States;
     std::vector<bool> visited;
@@ -11,15 +11,17 @@ RelaxationHeuristic::RelaxationHeuristic(const options::Options& opts)
     : RelaxationHeuristic(
           opts.get_unparsed_config(),
           opts.get<std::shared_ptr<ClassicalTask>>("transform"),
-          utils::get_log_from_options(opts))
+          utils::get_log_from_options(opts),
+          opts.get<bool>("cache_estimates"))
 {
 }
 
 RelaxationHeuristic::RelaxationHeuristic(
     std::string description,
     std::shared_ptr<ClassicalTask> task,
-    utils::LogProxy log)
-    : Heuristic(std::move(description), log, task)
+    utils::LogProxy log,
+    bool cache_estimates)
+    : Heuristic(std::move(description), log, task, cache_estimates)
 {
     // TODO Initialize the heuristic, if needed.
 }
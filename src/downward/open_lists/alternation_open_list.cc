@@ -0,0 +1,169 @@
+#include "downward/open_lists/alternation_open_list.h"
+
+#include "downward/open_list.h"
+#include "downward/option_parser.h"
+#include "downward/plugin.h"
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+using namespace std;
+
+namespace alternation_open_list {
+template <class Entry>
+class AlternationOpenList : public OpenList<Entry> {
+    vector<unique_ptr<OpenList<Entry>>> open_lists;
+    // The non-empty sublist with the lowest priority value is used next.
+    vector<int> priorities;
+
+    const int boost_amount;
+
+protected:
+    virtual void
+    do_insertion(EvaluationContext& eval_context, const Entry& entry) override;
+
+public:
+    explicit AlternationOpenList(const Options& opts);
+    virtual ~AlternationOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void boost_preferred() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator*>& evals) override;
+    virtual bool is_dead_end(EvaluationContext& eval_context) const override;
+    virtual bool
+    is_reliable_dead_end(EvaluationContext& eval_context) const override;
+};
+
+template <class Entry>
+AlternationOpenList<Entry>::AlternationOpenList(const Options& opts)
+    : boost_amount(opts.get<int>("boost"))
+{
+    vector<shared_ptr<OpenListFactory>> open_list_factories(
+        opts.get_list<shared_ptr<OpenListFactory>>("sublists"));
+    open_lists.reserve(open_list_factories.size());
+    for (const shared_ptr<OpenListFactory>& factory : open_list_factories)
+        open_lists.push_back(factory->create_open_list<Entry>());
+
+    priorities.resize(open_lists.size(), 0);
+}
+
+template <class Entry>
+void AlternationOpenList<Entry>::do_insertion(
+    EvaluationContext& eval_context,
+    const Entry& entry)
+{
+    for (const unique_ptr<OpenList<Entry>>& sublist : open_lists)
+        sublist->insert(eval_context, entry);
+}
+
+template <class Entry>
+Entry AlternationOpenList<Entry>::remove_min()
+{
+    int best = -1;
+    for (size_t i = 0; i < open_lists.size(); ++i) {
+        if (!open_lists[i]->empty() &&
+            (best == -1 || priorities[i] < priorities[best])) {
+            best = i;
+        }
+    }
+    assert(best != -1);
+    const unique_ptr<OpenList<Entry>>& best_list = open_lists[best];
+    assert(!best_list->empty());
+    ++priorities[best];
+    return best_list->remove_min();
+}
+
+template <class Entry>
+bool AlternationOpenList<Entry>::empty() const
+{
+    for (const unique_ptr<OpenList<Entry>>& sublist : open_lists)
+        if (!sublist->empty()) return false;
+    return true;
+}
+
+template <class Entry>
+void AlternationOpenList<Entry>::clear()
+{
+    for (const unique_ptr<OpenList<Entry>>& sublist : open_lists)
+        sublist->clear();
+}
+
+template <class Entry>
+void AlternationOpenList<Entry>::boost_preferred()
+{
+    for (size_t i = 0; i < open_lists.size(); ++i)
+        if (open_lists[i]->only_contains_preferred_entries())
+            priorities[i] -= boost_amount;
+}
+
+template <class Entry>
+void AlternationOpenList<Entry>::get_path_dependent_evaluators(
+    set<Evaluator*>& evals)
+{
+    for (const unique_ptr<OpenList<Entry>>& sublist : open_lists)
+        sublist->get_path_dependent_evaluators(evals);
+}
+
+template <class Entry>
+bool AlternationOpenList<Entry>::is_dead_end(
+    EvaluationContext& eval_context) const
+{
+    // If one sublist is sure we have a dead end, return true.
+    if (is_reliable_dead_end(eval_context)) return true;
+    // Otherwise, return true if all sublists agree this is a dead end.
+    for (const unique_ptr<OpenList<Entry>>& sublist : open_lists)
+        if (!sublist->is_dead_end(eval_context)) return false;
+    return true;
+}
+
+template <class Entry>
+bool AlternationOpenList<Entry>::is_reliable_dead_end(
+    EvaluationContext& eval_context) const
+{
+    for (const unique_ptr<OpenList<Entry>>& sublist : open_lists)
+        if (sublist->is_reliable_dead_end(eval_context)) return true;
+    return false;
+}
+
+AlternationOpenListFactory::AlternationOpenListFactory(const Options& options)
+    : options(options)
+{
+}
+
+unique_ptr<StateOpenList> AlternationOpenListFactory::create_state_open_list()
+{
+    return std::make_unique<AlternationOpenList<StateOpenListEntry>>(options);
+}
+
+unique_ptr<EdgeOpenList> AlternationOpenListFactory::create_edge_open_list()
+{
+    return std::make_unique<AlternationOpenList<EdgeOpenListEntry>>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser& parser)
+{
+    parser.document_synopsis(
+        "Alternation open list",
+        "alternates between several open lists.");
+    parser.add_list_option<shared_ptr<OpenListFactory>>(
+        "sublists",
+        "open lists between which this one alternates");
+    parser.add_option<int>(
+        "boost",
+        "boost value for contained open lists that are restricted "
+        "to preferred successors",
+        "0");
+
+    Options opts = parser.parse();
+    opts.verify_list_non_empty<shared_ptr<OpenListFactory>>("sublists");
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<AlternationOpenListFactory>(opts);
+}
+
+static Plugin<OpenListFactory> _plugin("alt", _parse);
+} // namespace alternation_open_list
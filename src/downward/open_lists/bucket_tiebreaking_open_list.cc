@@ -0,0 +1,298 @@
+#include "downward/open_lists/bucket_tiebreaking_open_list.h"
+
+#include "downward/evaluator.h"
+#include "downward/open_list.h"
+#include "downward/option_parser.h"
+#include "downward/plugin.h"
+
+#include "downward/open_lists/tiebreaking_open_list.h"
+
+#include <array>
+#include <cassert>
+#include <map>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+namespace bucket_tiebreaking_open_list {
+/*
+  Evaluator values in [0, MAX_DENSE_VALUE) are used as direct indices into
+  bucket arrays. All other values are kept in an ordered map.
+*/
+static const int MAX_DENSE_VALUE = 1 << 16;
+
+/*
+  FIFO queue of entries. Popped entries are only physically removed once they
+  make up at least half of the buffer, so that pushing and popping take
+  amortized constant time and the buffer capacity is reused.
+*/
+template <class Entry>
+class Bucket {
+    vector<Entry> entries;
+    size_t head = 0;
+
+public:
+    void insert(const int*, const Entry& entry) { entries.push_back(entry); }
+
+    Entry remove_min()
+    {
+        assert(!empty());
+        Entry result = entries[head++];
+        if (head == entries.size()) {
+            entries.clear();
+            head = 0;
+        } else if (head >= 64 && 2 * head >= entries.size()) {
+            entries.erase(entries.begin(), entries.begin() + head);
+            head = 0;
+        }
+        return result;
+    }
+
+    bool empty() const { return head == entries.size(); }
+
+    void clear()
+    {
+        entries.clear();
+        head = 0;
+    }
+};
+
+/*
+  Buckets for keys of length Dim, indexed by the first key component. Each
+  child holds the entries with the given first component, organized by the
+  remaining Dim - 1 components.
+*/
+template <class Entry, int Dim>
+class BucketLevel {
+    using Child = conditional_t<
+        Dim == 1,
+        Bucket<Entry>,
+        BucketLevel<Entry, Dim - 1>>;
+
+    vector<Child> dense;
+    // All dense buckets below this index are empty.
+    size_t first_dense = 0;
+    map<int, Child> sparse;
+    int size = 0;
+
+    static bool is_dense(int value)
+    {
+        return value >= 0 && value < MAX_DENSE_VALUE;
+    }
+
+public:
+    void insert(const int* key, const Entry& entry)
+    {
+        int value = key[0];
+        if (is_dense(value)) {
+            size_t index = value;
+            if (index >= dense.size()) dense.resize(index + 1);
+            dense[index].insert(key + 1, entry);
+            if (index < first_dense) first_dense = index;
+        } else {
+            sparse[value].insert(key + 1, entry);
+        }
+        ++size;
+    }
+
+    Entry remove_min()
+    {
+        assert(!empty());
+        --size;
+        /*
+          Negative values come before all dense buckets, non-negative sparse
+          values after them.
+        */
+        auto sparse_it = sparse.begin();
+        if (sparse_it == sparse.end() || sparse_it->first >= 0) {
+            while (first_dense < dense.size() && dense[first_dense].empty())
+                ++first_dense;
+            if (first_dense < dense.size())
+                return dense[first_dense].remove_min();
+        }
+        assert(sparse_it != sparse.end());
+        Entry result = sparse_it->second.remove_min();
+        if (sparse_it->second.empty()) sparse.erase(sparse_it);
+        return result;
+    }
+
+    bool empty() const { return size == 0; }
+
+    void clear()
+    {
+        dense.clear();
+        first_dense = 0;
+        sparse.clear();
+        size = 0;
+    }
+};
+
+template <class Entry, int Dim>
+class BucketTieBreakingOpenList : public OpenList<Entry> {
+    BucketLevel<Entry, Dim> buckets;
+
+    vector<shared_ptr<Evaluator>> evaluators;
+    /*
+      If allow_unsafe_pruning is true, we ignore (don't insert) states
+      which the first evaluator considers a dead end, even if it is
+      not a safe heuristic.
+    */
+    bool allow_unsafe_pruning;
+
+protected:
+    virtual void
+    do_insertion(EvaluationContext& eval_context, const Entry& entry) override;
+
+public:
+    explicit BucketTieBreakingOpenList(const Options& opts);
+    virtual ~BucketTieBreakingOpenList() override = default;
+
+    virtual Entry remove_min() override;
+    virtual bool empty() const override;
+    virtual void clear() override;
+    virtual void get_path_dependent_evaluators(set<Evaluator*>& evals) override;
+    virtual bool is_dead_end(EvaluationContext& eval_context) const override;
+    virtual bool
+    is_reliable_dead_end(EvaluationContext& eval_context) const override;
+};
+
+template <class Entry, int Dim>
+BucketTieBreakingOpenList<Entry, Dim>::BucketTieBreakingOpenList(
+    const Options& opts)
+    : OpenList<Entry>(opts.get<bool>("pref_only"))
+    , evaluators(opts.get_list<shared_ptr<Evaluator>>("evals"))
+    , allow_unsafe_pruning(opts.get<bool>("unsafe_pruning"))
+{
+    assert(evaluators.size() == Dim);
+}
+
+template <class Entry, int Dim>
+void BucketTieBreakingOpenList<Entry, Dim>::do_insertion(
+    EvaluationContext& eval_context,
+    const Entry& entry)
+{
+    array<int, Dim> key;
+    for (int i = 0; i < Dim; ++i) {
+        key[i] = eval_context.get_evaluator_value_or_infinity(
+            evaluators[i].get());
+    }
+    buckets.insert(key.data(), entry);
+}
+
+template <class Entry, int Dim>
+Entry BucketTieBreakingOpenList<Entry, Dim>::remove_min()
+{
+    return buckets.remove_min();
+}
+
+template <class Entry, int Dim>
+bool BucketTieBreakingOpenList<Entry, Dim>::empty() const
+{
+    return buckets.empty();
+}
+
+template <class Entry, int Dim>
+void BucketTieBreakingOpenList<Entry, Dim>::clear()
+{
+    buckets.clear();
+}
+
+template <class Entry, int Dim>
+void BucketTieBreakingOpenList<Entry, Dim>::get_path_dependent_evaluators(
+    set<Evaluator*>& evals)
+{
+    for (const shared_ptr<Evaluator>& evaluator : evaluators)
+        evaluator->get_path_dependent_evaluators(evals);
+}
+
+template <class Entry, int Dim>
+bool BucketTieBreakingOpenList<Entry, Dim>::is_dead_end(
+    EvaluationContext& eval_context) const
+{
+    // Same behaviour as the regular tie-breaking open list.
+    if (is_reliable_dead_end(eval_context)) return true;
+    if (allow_unsafe_pruning &&
+        eval_context.is_evaluator_value_infinite(evaluators[0].get()))
+        return true;
+    for (const shared_ptr<Evaluator>& evaluator : evaluators)
+        if (!eval_context.is_evaluator_value_infinite(evaluator.get()))
+            return false;
+    return true;
+}
+
+template <class Entry, int Dim>
+bool BucketTieBreakingOpenList<Entry, Dim>::is_reliable_dead_end(
+    EvaluationContext& eval_context) const
+{
+    for (const shared_ptr<Evaluator>& evaluator : evaluators)
+        if (eval_context.is_evaluator_value_infinite(evaluator.get()) &&
+            evaluator->dead_ends_are_reliable())
+            return true;
+    return false;
+}
+
+template <class Entry>
+static unique_ptr<OpenList<Entry>>
+create_bucket_open_list(const Options& options)
+{
+    switch (options.get_list<shared_ptr<Evaluator>>("evals").size()) {
+    case 1:
+        return make_unique<BucketTieBreakingOpenList<Entry, 1>>(options);
+    case 2:
+        return make_unique<BucketTieBreakingOpenList<Entry, 2>>(options);
+    case 3:
+        return make_unique<BucketTieBreakingOpenList<Entry, 3>>(options);
+    default:
+        return tiebreaking_open_list::TieBreakingOpenListFactory(options)
+            .create_open_list<Entry>();
+    }
+}
+
+BucketTieBreakingOpenListFactory::BucketTieBreakingOpenListFactory(
+    const Options& options)
+    : options(options)
+{
+}
+
+unique_ptr<StateOpenList>
+BucketTieBreakingOpenListFactory::create_state_open_list()
+{
+    return create_bucket_open_list<StateOpenListEntry>(options);
+}
+
+unique_ptr<EdgeOpenList>
+BucketTieBreakingOpenListFactory::create_edge_open_list()
+{
+    return create_bucket_open_list<EdgeOpenListEntry>(options);
+}
+
+static shared_ptr<OpenListFactory> _parse(OptionParser& parser)
+{
+    parser.document_synopsis(
+        "Bucket-based tie-breaking open list",
+        "Orders entries like the tie-breaking open list, but stores them in "
+        "nested bucket arrays indexed by the evaluator values instead of a "
+        "tree. Specialized for up to three evaluators; with more, the "
+        "regular tie-breaking open list is used.");
+    parser.add_list_option<shared_ptr<Evaluator>>("evals", "evaluators");
+    parser.add_option<bool>(
+        "pref_only",
+        "insert only nodes generated by preferred operators",
+        "false");
+    parser.add_option<bool>(
+        "unsafe_pruning",
+        "allow unsafe pruning when the main evaluator regards a state a dead "
+        "end",
+        "true");
+    Options opts = parser.parse();
+    opts.verify_list_non_empty<shared_ptr<Evaluator>>("evals");
+    if (parser.dry_run())
+        return nullptr;
+    else
+        return make_shared<BucketTieBreakingOpenListFactory>(opts);
+}
+
+static Plugin<OpenListFactory> _plugin("bucket_tiebreaking", _parse);
+} // namespace bucket_tiebreaking_open_list
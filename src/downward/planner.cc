@@ -24,11 +24,32 @@ int main(int argc, const char** argv)
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
     }
 
+    TaskInputOptions task_input;
+    try {
+        task_input = parse_task_input_options(argc, argv);
+    } catch (const ArgError& error) {
+        error.print();
+        usage(argv[0]);
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+
     bool unit_cost = false;
     if (static_cast<string>(argv[1]) != "--help") {
         utils::g_log << "reading input..." << endl;
-        tasks::read_root_task(cin);
+        if (task_input.binary_task_filename.empty()) {
+            tasks::read_root_task(cin, task_input.sas_parser_threads);
+        } else {
+            tasks::read_root_task_from_binary(
+                task_input.binary_task_filename);
+        }
         utils::g_log << "done reading input!" << endl;
+        if (!task_input.write_binary_task_filename.empty()) {
+            tasks::write_binary_task(
+                *tasks::g_root_task,
+                task_input.write_binary_task_filename);
+            utils::g_log << "wrote binary task file "
+                         << task_input.write_binary_task_filename << endl;
+        }
         ClassicalTaskProxy task_proxy(*tasks::g_root_task);
         unit_cost = task_properties::is_unit_cost(task_proxy);
     }
@@ -54,6 +75,11 @@ int main(int argc, const char** argv)
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
     }
 
+    if (!algorithm && !task_input.write_binary_task_filename.empty()) {
+        // Only the binary task file was requested.
+        utils::exit_with(ExitCode::SUCCESS);
+    }
+
     utils::Timer search_timer;
     algorithm->search();
     search_timer.stop();
@@ -63,6 +89,7 @@ int main(int argc, const char** argv)
     algorithm->print_statistics();
     utils::g_log << "Search time: " << search_timer << endl;
     utils::g_log << "Total time: " << utils::g_timer << endl;
+    algorithm->save_statistics_if_necessary();
 
     ExitCode exitcode = algorithm->found_solution()
                             ? ExitCode::SUCCESS
@@ -10,11 +10,14 @@
 #include "downward/task_utils/task_properties.h"
 #include "downward/tasks/root_task.h"
 #include "downward/utils/countdown_timer.h"
+#include "downward/utils/json.h"
 #include "downward/utils/rng_options.h"
 #include "downward/utils/system.h"
 #include "downward/utils/timer.h"
 
 #include <cassert>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <limits>
 
@@ -23,6 +26,7 @@ using utils::ExitCode;
 
 static successor_generator::SuccessorGenerator& get_successor_generator(
     const ClassicalTaskProxy& task_proxy,
+    successor_generator::Representation representation,
     utils::LogProxy& log)
 {
     if (log.is_at_least_normal()) {
@@ -31,7 +35,9 @@ static successor_generator::SuccessorGenerator& get_successor_generator(
     int peak_memory_before = utils::get_peak_memory_in_kb();
     utils::Timer successor_generator_timer;
     successor_generator::SuccessorGenerator& successor_generator =
-        successor_generator::g_successor_generators[task_proxy];
+        successor_generator::get_successor_generator(
+            task_proxy,
+            representation);
     successor_generator_timer.stop();
     if (log.is_at_least_normal()) {
         log << "done!" << endl;
@@ -47,14 +53,36 @@ static successor_generator::SuccessorGenerator& get_successor_generator(
     return successor_generator;
 }
 
+shared_ptr<mapped_segment_allocator::MappedArena>
+create_mapped_state_storage(const Options& opts)
+{
+    if (opts.get<StateStorage>("state_storage", StateStorage::HEAP) ==
+        StateStorage::HEAP) {
+        return nullptr;
+    }
+    return make_shared<mapped_segment_allocator::MappedArena>(
+        opts.get<string>("state_storage_directory", "."));
+}
+
 SearchAlgorithm::SearchAlgorithm(const Options& opts)
     : SearchAlgorithm(
           opts.get<shared_ptr<ClassicalTask>>("transform"),
           utils::get_log_from_options(opts),
           opts.get<OperatorCost>("cost_type"),
           opts.get<double>("max_time"),
-          opts.get<int>("bound"))
+          opts.get<int>("bound"),
+          opts.get<SearchNodeStorage>(
+              "search_node_storage",
+              SearchNodeStorage::STRUCT),
+          create_mapped_state_storage(opts),
+          opts.get<int_packer::Encoding>(
+              "state_encoding",
+              int_packer::Encoding::BIT_FIELDS),
+          opts.get<successor_generator::Representation>(
+              "successor_generator",
+              successor_generator::Representation::TREE))
 {
+    read_statistics_options(opts);
 }
 
 SearchAlgorithm::SearchAlgorithm(
@@ -62,19 +90,34 @@ SearchAlgorithm::SearchAlgorithm(
     utils::LogProxy log,
     OperatorCost cost_type,
     double max_time,
-    int bound)
+    int bound,
+    SearchNodeStorage node_storage,
+    shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory,
+    int_packer::Encoding state_encoding,
+    successor_generator::Representation successor_generator_representation)
     : status(IN_PROGRESS)
     , solution_found(false)
     , task(task)
     , task_proxy(*task)
     , log(log)
-    , state_registry(task_proxy)
-    , successor_generator(get_successor_generator(task_proxy, this->log))
-    , search_space(state_registry, this->log)
+    , state_registry(task_proxy, std::move(mapped_memory), state_encoding)
+    , successor_generator(get_successor_generator(
+          task_proxy,
+          successor_generator_representation,
+          this->log))
+    , compiled_task(compiled_task::g_compiled_tasks[task_proxy])
+    , search_space(
+          state_registry,
+          successor_generator,
+          this->log,
+          node_storage,
+          cost_type)
     , statistics(this->log)
     , cost_type(cost_type)
     , is_unit_cost(task_properties::is_unit_cost(task_proxy))
     , max_time(max_time)
+    , statistics_snapshot_interval(numeric_limits<double>::infinity())
+    , next_statistics_snapshot(numeric_limits<double>::infinity())
 {
     if (bound < 0) {
         cerr << "error: negative cost bound " << bound << endl;
@@ -146,6 +189,12 @@ void SearchAlgorithm::search()
             status = TIMEOUT;
             break;
         }
+        if (!statistics_file.empty() &&
+            next_statistics_snapshot < numeric_limits<double>::infinity() &&
+            timer->get_elapsed_time() >= next_statistics_snapshot) {
+            save_statistics_if_necessary();
+            next_statistics_snapshot += statistics_snapshot_interval;
+        }
     }
     // TODO: Revise when and which search times are logged.
     if (log.is_at_least_normal())
@@ -154,7 +203,7 @@ void SearchAlgorithm::search()
 
 bool SearchAlgorithm::check_goal_and_set_plan(const State& state)
 {
-    if (task_properties::is_goal_state(task_proxy, state)) {
+    if (compiled_task.is_goal_state(state.get_unpacked_values())) {
         if (log.is_at_least_normal()) log << "Solution found!" << endl;
         goal_id = state.get_id();
         Plan plan;
@@ -172,9 +221,97 @@ void SearchAlgorithm::save_plan_if_necessary()
     }
 }
 
+static const char* get_status_name(SearchStatus status)
+{
+    switch (status) {
+    case IN_PROGRESS: return "in_progress";
+    case TIMEOUT: return "timeout";
+    case FAILED: return "failed";
+    case SOLVED: return "solved";
+    }
+    utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+}
+
+void SearchAlgorithm::write_statistics_json(utils::JsonWriter& json) const
+{
+    json.key("status");
+    json.value(get_status_name(status));
+    json.key("solution_found");
+    json.value(solution_found);
+    if (solution_found) {
+        json.key("plan_length");
+        json.value(plan.size());
+    }
+    statistics.write_json(json);
+    json.key("registered_states");
+    json.value(get_num_registered_states());
+    json.key("bytes_per_state");
+    json.value(state_registry.get_state_size_in_bytes());
+    json.key("peak_memory_kb");
+    json.value(utils::get_peak_memory_in_kb());
+    json.key("search_time");
+    if (timer) {
+        json.value(static_cast<double>(timer->get_elapsed_time()));
+    } else {
+        json.null();
+    }
+    json.key("total_time");
+    json.value(static_cast<double>(utils::g_timer()));
+}
+
+void SearchAlgorithm::write_statistics_json(ostream& os) const
+{
+    utils::JsonWriter json(os);
+    json.begin_object();
+    write_statistics_json(json);
+    json.end_object();
+    os << endl;
+}
+
+void SearchAlgorithm::read_statistics_options(const Options& opts)
+{
+    statistics_file = opts.get<string>("statistics_file", "none");
+    if (statistics_file == "none") {
+        statistics_file.clear();
+    }
+    statistics.set_time_evaluators(!statistics_file.empty());
+    statistics_snapshot_interval = opts.get<double>(
+        "statistics_snapshot_interval",
+        numeric_limits<double>::infinity());
+    if (statistics_snapshot_interval <= 0) {
+        cerr << "error: statistics_snapshot_interval must be positive" << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    next_statistics_snapshot = statistics_snapshot_interval;
+}
+
+void SearchAlgorithm::save_statistics_if_necessary() const
+{
+    if (statistics_file.empty()) return;
+    /*
+      Snapshots overwrite the file while the search is running, so write to
+      a temporary file first. Readers then always see a complete document.
+    */
+    string tmp_file = statistics_file + ".tmp";
+    {
+        ofstream os(tmp_file);
+        write_statistics_json(os);
+        if (!os) {
+            cerr << "error: could not write statistics to " << tmp_file
+                 << endl;
+            utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+        }
+    }
+    if (rename(tmp_file.c_str(), statistics_file.c_str()) != 0) {
+        cerr << "error: could not rename " << tmp_file << " to "
+             << statistics_file << endl;
+        utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+}
+
 int SearchAlgorithm::get_adjusted_cost(const OperatorProxy& op) const
 {
-    return get_adjusted_action_cost(op, cost_type, is_unit_cost);
+    return get_adjusted_cost(OperatorID(op.get_id()));
 }
 
 double SearchAlgorithm::get_max_time()
@@ -198,6 +335,15 @@ void SearchAlgorithm::reduce_max_time(double new_max_time)
 }
 
 void SearchAlgorithm::add_options_to_parser(OptionParser& parser)
+{
+    add_common_options_to_parser(parser);
+    add_search_node_storage_option_to_parser(parser);
+    add_state_storage_options_to_parser(parser);
+    add_state_encoding_option_to_parser(parser);
+    add_successor_generator_option_to_parser(parser);
+}
+
+void SearchAlgorithm::add_common_options_to_parser(OptionParser& parser)
 {
     ::add_cost_type_option_to_parser(parser);
     parser.add_option<int>(
@@ -224,9 +370,80 @@ void SearchAlgorithm::add_options_to_parser(OptionParser& parser)
         "are "
         "available.",
         "no_transform()");
+    parser.add_option<string>(
+        "statistics_file",
+        "write the search statistics as a JSON object to this file when the "
+        "search ends (and for every snapshot). 'none' to disable",
+        "none");
+    parser.add_option<double>(
+        "statistics_snapshot_interval",
+        "seconds of search time between snapshots of the statistics file. "
+        "Snapshots are only taken between search steps",
+        "infinity");
     utils::add_log_options_to_parser(parser);
 }
 
+void SearchAlgorithm::add_search_node_storage_option_to_parser(
+    OptionParser& parser)
+{
+    parser.add_enum_option<SearchNodeStorage>(
+        "search_node_storage",
+        {"struct", "compact"},
+        "Memory layout of the search nodes.",
+        "struct",
+        {"one struct per state holding all node information",
+         "separate arrays for status, g-values and parents; creating "
+         "operators are recomputed when tracing the solution and real g-values "
+         "are only stored if cost_type is not normal"});
+}
+
+void SearchAlgorithm::add_state_storage_options_to_parser(OptionParser& parser)
+{
+    parser.add_enum_option<StateStorage>(
+        "state_storage",
+        {"heap", "mapped"},
+        "Where registered states and per-state information are stored.",
+        "heap",
+        {"regular heap memory",
+         "a memory-mapped temporary file. The operating system can write old "
+         "states to disk and evict them from memory when memory runs short. "
+         "Mapped memory still counts towards address space limits."});
+    parser.add_option<string>(
+        "state_storage_directory",
+        "directory for the temporary file used by state_storage=mapped",
+        ".");
+}
+
+void SearchAlgorithm::add_state_encoding_option_to_parser(OptionParser& parser)
+{
+    parser.add_enum_option<int_packer::Encoding>(
+        "state_encoding",
+        {"bit_fields", "mixed_radix"},
+        "How the variables of registered states are packed.",
+        "bit_fields",
+        {"each variable takes a whole number of bits",
+         "the variables in each 32-bit bin are ranked as one mixed-radix "
+         "number. Needs fewer bytes per state if many domain sizes are not "
+         "powers of two, but reading a variable costs a division"});
+}
+
+void SearchAlgorithm::add_successor_generator_option_to_parser(
+    OptionParser& parser)
+{
+    parser.add_enum_option<successor_generator::Representation>(
+        "successor_generator",
+        {"tree", "byte_code", "bitset", "automatic"},
+        "Representation of the successor generator. All generate the same "
+        "applicable operators, tree and byte_code also in the same order.",
+        "tree",
+        {"a tree of polymorphic nodes",
+         "the same tree flattened into a single vector of ints, without "
+         "virtual calls or pointers",
+         "bitsets of the operators compatible with each fact, combined with "
+         "AVX2 where available. Generates the operators ordered by ID",
+         "tree or bitset, whichever is estimated to be faster for the task"});
+}
+
 /* Method doesn't belong here because it's only useful for certain derived
    classes.
    TODO: Figure out where it belongs and move it there. */
@@ -0,0 +1,329 @@
+#include "downward/search_algorithms/anytime_astar_search.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluation_result.h"
+#include "downward/evaluator.h"
+#include "downward/option_parser.h"
+
+#include "downward/utils/json.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <cassert>
+#include <set>
+
+using namespace std;
+
+namespace anytime_astar_search {
+AnytimeAStarSearch::AnytimeAStarSearch(const Options& opts)
+    : AnytimeAStarSearch(
+          opts.get<shared_ptr<ClassicalTask>>("transform"),
+          utils::get_log_from_options(opts),
+          opts.get<OperatorCost>("cost_type"),
+          opts.get<double>("max_time"),
+          opts.get<int>("bound"),
+          opts.get<shared_ptr<Evaluator>>("eval"),
+          opts.get_list<int>("weights"),
+          opts.get<SearchNodeStorage>("search_node_storage"),
+          create_mapped_state_storage(opts),
+          opts.get<int_packer::Encoding>("state_encoding"),
+          opts.get<successor_generator::Representation>(
+              "successor_generator"))
+{
+    read_statistics_options(opts);
+}
+
+AnytimeAStarSearch::AnytimeAStarSearch(
+    shared_ptr<ClassicalTask> task,
+    utils::LogProxy log,
+    OperatorCost cost_type,
+    double max_time,
+    int bound,
+    shared_ptr<Evaluator> evaluator,
+    vector<int> weights,
+    SearchNodeStorage node_storage,
+    shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory,
+    int_packer::Encoding state_encoding,
+    successor_generator::Representation successor_generator_representation)
+    : SearchAlgorithm(
+          task,
+          log,
+          cost_type,
+          max_time,
+          bound,
+          node_storage,
+          std::move(mapped_memory),
+          state_encoding,
+          successor_generator_representation)
+    , evaluator(std::move(evaluator))
+    , weights(std::move(weights))
+    , expansion_iteration(-1)
+    , iteration(0)
+    , incumbent_id(StateID::no_state)
+    , incumbent_cost(EvaluationResult::INFTY)
+    , published_cost(EvaluationResult::INFTY)
+{
+    assert(!this->weights.empty());
+}
+
+void AnytimeAStarSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting anytime A* search with weight " << get_weight()
+            << ", (real) bound = " << bound << endl;
+    }
+
+    set<Evaluator*> path_dependent_evaluators;
+    evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "Anytime A* does not support path-dependent evaluators"
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+
+    const State& initial_state = state_registry.get_initial_state();
+    EvaluationContext eval_context(initial_state, 0, true, &statistics);
+    statistics.inc_evaluated_states();
+
+    if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+        log << "Initial state is a dead end." << endl;
+        statistics.inc_dead_ends();
+    } else {
+        search_space.get_node(initial_state).open_initial();
+        insert(
+            initial_state.get_id(),
+            0,
+            eval_context.get_evaluator_value(evaluator.get()));
+        handle_goal(initial_state, 0);
+    }
+
+    print_initial_evaluator_values(eval_context);
+}
+
+void AnytimeAStarSearch::insert(StateID id, int g, int h)
+{
+    open_list.push(OpenEntry{g + get_weight() * h, h, g, id});
+}
+
+bool AnytimeAStarSearch::prune_stale_entries()
+{
+    while (!open_list.empty()) {
+        const OpenEntry& entry = open_list.top();
+        State state = state_registry.lookup_state(entry.id);
+        SearchNode node = search_space.get_node(state);
+        if (node.is_open() && node.get_g() == entry.g) {
+            return true;
+        }
+        open_list.pop();
+    }
+    return false;
+}
+
+int AnytimeAStarSearch::evaluate(const State& state, int g)
+{
+    EvaluationContext eval_context(state, g, false, &statistics);
+    return eval_context.get_evaluator_value_or_infinity(evaluator.get());
+}
+
+void AnytimeAStarSearch::handle_goal(const State& state, int g)
+{
+    if (g < incumbent_cost &&
+        compiled_task.is_goal_state(state.get_unpacked_values())) {
+        incumbent_id = state.get_id();
+        incumbent_cost = g;
+        publish_incumbent();
+    }
+}
+
+void AnytimeAStarSearch::expand(const OpenEntry& entry)
+{
+    State state = state_registry.lookup_state(entry.id);
+    SearchNode node = search_space.get_node(state);
+    node.close();
+    expansion_iteration[state] = iteration;
+    statistics.inc_expanded();
+
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(state, applicable_ops);
+    for (OperatorID op_id : applicable_ops) {
+        if (node.get_real_g() + compiled_task.get_cost(op_id) >= bound)
+            continue;
+
+        State succ_state = state_registry.get_successor_state(
+            state,
+            compiled_task.get_effects(op_id));
+        statistics.inc_generated();
+        SearchNode succ_node = search_space.get_node(succ_state);
+        if (succ_node.is_dead_end()) continue;
+
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        int adjusted_cost = get_adjusted_cost(op_id);
+        int succ_g = node.get_g() + adjusted_cost;
+
+        if (succ_node.is_new()) {
+            int succ_h = evaluate(succ_state, succ_g);
+            statistics.inc_evaluated_states();
+            if (succ_h == EvaluationResult::INFTY) {
+                succ_node.mark_as_dead_end();
+                statistics.inc_dead_ends();
+                continue;
+            }
+            succ_node.open(node, op, adjusted_cost);
+            insert(succ_state.get_id(), succ_g, succ_h);
+        } else if (succ_g < succ_node.get_g()) {
+            // The heuristic value is cached, so this does not recompute it.
+            int succ_h = evaluate(succ_state, succ_g);
+            if (succ_node.is_open()) {
+                succ_node.update_parent(node, op, adjusted_cost);
+                insert(succ_state.get_id(), succ_g, succ_h);
+            } else if (expansion_iteration[succ_state] == iteration) {
+                // Delay the re-expansion to the next iteration.
+                succ_node.update_parent(node, op, adjusted_cost);
+                inconsistent_states.emplace_back(succ_state.get_id(), succ_h);
+            } else {
+                succ_node.reopen(node, op, adjusted_cost);
+                statistics.inc_reopened();
+                insert(succ_state.get_id(), succ_g, succ_h);
+            }
+        } else {
+            continue;
+        }
+        handle_goal(succ_state, succ_g);
+    }
+}
+
+void AnytimeAStarSearch::publish_incumbent()
+{
+    /*
+      Ancestors of the incumbent may have been reached more cheaply since it
+      was generated, so the traced plan can be cheaper than its g value.
+    */
+    Plan plan;
+    search_space.trace_path(state_registry.lookup_state(incumbent_id), plan);
+    int cost = 0;
+    for (OperatorID op_id : plan) {
+        cost += get_adjusted_cost(op_id);
+    }
+    assert(cost <= incumbent_cost);
+    incumbent_cost = cost;
+    if (cost >= published_cost) {
+        return;
+    }
+    published_cost = cost;
+
+    set_plan(plan);
+    plan_costs.push_back(calculate_plan_cost(plan, task_proxy));
+    if (log.is_at_least_normal()) {
+        log << "Found plan of cost " << plan_costs.back() << " with weight "
+            << get_weight() << " [" << statistics.get_expanded()
+            << " expanded states]" << endl;
+    }
+    plan_manager.save_plan(plan, task_proxy, true);
+}
+
+void AnytimeAStarSearch::start_next_iteration()
+{
+    ++iteration;
+    if (log.is_at_least_normal()) {
+        log << "Continuing search with weight " << get_weight() << endl;
+    }
+
+    // Recompute the f values of all open states with the new weight.
+    vector<OpenEntry> entries;
+    entries.reserve(open_list.size() + inconsistent_states.size());
+    while (prune_stale_entries()) {
+        OpenEntry entry = open_list.top();
+        open_list.pop();
+        entry.f = entry.g + get_weight() * entry.h;
+        entries.push_back(entry);
+    }
+
+    for (const auto& [id, h] : inconsistent_states) {
+        State state = state_registry.lookup_state(id);
+        SearchNode node = search_space.get_node(state);
+        // States may occur several times in inconsistent_states.
+        if (node.is_closed()) {
+            node.reopen();
+            statistics.inc_reopened();
+            int g = node.get_g();
+            entries.push_back(OpenEntry{g + get_weight() * h, h, g, id});
+        }
+    }
+    inconsistent_states.clear();
+
+    open_list = OpenList(OpenEntryCompare(), std::move(entries));
+}
+
+SearchStatus AnytimeAStarSearch::step()
+{
+    bool has_open_states = prune_stale_entries();
+    if (has_open_states && open_list.top().f < incumbent_cost) {
+        OpenEntry entry = open_list.top();
+        open_list.pop();
+        expand(entry);
+        return IN_PROGRESS;
+    }
+
+    // No open state can lead to a plan cheaper than w times the incumbent.
+    if (incumbent_cost == EvaluationResult::INFTY) {
+        assert(!has_open_states);
+        log << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    publish_incumbent();
+
+    if (!has_open_states && inconsistent_states.empty()) {
+        if (log.is_at_least_normal()) {
+            log << "Completely explored state space -- plan is optimal."
+                << endl;
+        }
+        return SOLVED;
+    }
+    if (iteration + 1 == static_cast<int>(weights.size())) {
+        return SOLVED;
+    }
+    start_next_iteration();
+    return IN_PROGRESS;
+}
+
+void AnytimeAStarSearch::save_plan_if_necessary()
+{
+    if (incumbent_id != StateID::no_state) {
+        publish_incumbent();
+    }
+}
+
+void AnytimeAStarSearch::write_statistics_json(utils::JsonWriter& json) const
+{
+    SearchAlgorithm::write_statistics_json(json);
+    json.key("iterations");
+    json.value(iteration + 1);
+    json.key("final_weight");
+    json.value(get_weight());
+    json.key("plan_costs");
+    json.begin_array();
+    for (int cost : plan_costs) {
+        json.value(cost);
+    }
+    json.end_array();
+}
+
+void AnytimeAStarSearch::print_statistics() const
+{
+    statistics.print_detailed_statistics();
+    search_space.print_statistics();
+    log << "Iterations: " << iteration + 1 << endl;
+    log << "Final weight: " << get_weight() << endl;
+    log << "Plans found: " << plan_costs.size() << endl;
+}
+
+void add_options_to_parser(OptionParser& parser)
+{
+    parser.add_list_option<int>(
+        "weights",
+        "weights of the heuristic in the successive iterations; must be "
+        "positive and decreasing",
+        "[5, 3, 2, 1]");
+    SearchAlgorithm::add_options_to_parser(parser);
+}
+} // namespace anytime_astar_search
@@ -31,8 +31,14 @@ EagerSearch::EagerSearch(const Options& opts)
               ->create_state_open_list(),
           opts.get<shared_ptr<Evaluator>>("f_eval", nullptr),
           opts.get_list<shared_ptr<Evaluator>>("preferred"),
-          opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr))
+          opts.get<shared_ptr<Evaluator>>("lazy_evaluator", nullptr),
+          opts.get<SearchNodeStorage>("search_node_storage"),
+          create_mapped_state_storage(opts),
+          opts.get<int_packer::Encoding>("state_encoding"),
+          opts.get<successor_generator::Representation>(
+              "successor_generator"))
 {
+    read_statistics_options(opts);
     if (lazy_evaluator && !lazy_evaluator->does_cache_estimates()) {
         cerr << "lazy_evaluator must cache its estimates" << endl;
         utils::exit_with(utils::ExitCode::SEARCH_INPUT_ERROR);
@@ -49,8 +55,21 @@ EagerSearch::EagerSearch(
     std::unique_ptr<StateOpenList> open_list,
     std::shared_ptr<Evaluator> f_eval,
     std::vector<std::shared_ptr<Evaluator>> preferred,
-    std::shared_ptr<Evaluator> lazy_evaluator)
-    : SearchAlgorithm(task, log, cost_type, max_time, bound)
+    std::shared_ptr<Evaluator> lazy_evaluator,
+    SearchNodeStorage node_storage,
+    shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory,
+    int_packer::Encoding state_encoding,
+    successor_generator::Representation successor_generator_representation)
+    : SearchAlgorithm(
+          task,
+          log,
+          cost_type,
+          max_time,
+          bound,
+          node_storage,
+          std::move(mapped_memory),
+          state_encoding,
+          successor_generator_representation)
     , reopen_closed_nodes(reopen_closed)
     , open_list(std::move(open_list))
     , f_evaluator(f_eval)
@@ -216,11 +235,14 @@ SearchStatus EagerSearch::step()
     }
 
     for (OperatorID op_id : applicable_ops) {
-        OperatorProxy op = task_proxy.get_operators()[op_id];
-        if ((node->get_real_g() + op.get_cost()) >= bound) continue;
+        if ((node->get_real_g() + compiled_task.get_cost(op_id)) >= bound)
+            continue;
 
-        State succ_state =
-            state_registry.get_successor_state(s, op.get_effect());
+        State succ_state = state_registry.get_successor_state(
+            s,
+            compiled_task.get_effects(op_id));
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        int adjusted_cost = get_adjusted_cost(op_id);
         statistics.inc_generated();
         bool is_preferred = preferred_operators.contains(op_id);
 
@@ -240,7 +262,7 @@ SearchStatus EagerSearch::step()
             // Careful: succ_node.get_g() is not available here yet,
             // hence the stupid computation of succ_g.
             // TODO: Make this less fragile.
-            int succ_g = node->get_g() + get_adjusted_cost(op);
+            int succ_g = node->get_g() + adjusted_cost;
 
             EvaluationContext succ_eval_context(
                 succ_state,
@@ -254,14 +276,14 @@ SearchStatus EagerSearch::step()
                 statistics.inc_dead_ends();
                 continue;
             }
-            succ_node.open(*node, op, get_adjusted_cost(op));
+            succ_node.open(*node, op, adjusted_cost);
 
             open_list->insert(succ_eval_context, succ_state.get_id());
             if (search_progress.check_progress(succ_eval_context)) {
                 statistics.print_checkpoint_line(succ_node.get_g());
                 reward_progress();
             }
-        } else if (succ_node.get_g() > node->get_g() + get_adjusted_cost(op)) {
+        } else if (succ_node.get_g() > node->get_g() + adjusted_cost) {
             // We found a new cheapest path to an open or closed state.
             if (reopen_closed_nodes) {
                 if (succ_node.is_closed()) {
@@ -274,7 +296,7 @@ SearchStatus EagerSearch::step()
                     */
                     statistics.inc_reopened();
                 }
-                succ_node.reopen(*node, op, get_adjusted_cost(op));
+                succ_node.reopen(*node, op, adjusted_cost);
 
                 EvaluationContext succ_eval_context(
                     succ_state,
@@ -304,7 +326,7 @@ SearchStatus EagerSearch::step()
                 // If we do not reopen closed nodes, we just update the parent
                 // pointers. Note that this could cause an incompatibility
                 // between the g-value and the actual path that is traced back.
-                succ_node.update_parent(*node, op, get_adjusted_cost(op));
+                succ_node.update_parent(*node, op, adjusted_cost);
             }
         }
     }
@@ -0,0 +1,575 @@
+#include "downward/search_algorithms/external_bfs_search.h"
+
+#include "downward/option_parser.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "downward/utils/json.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+using namespace std;
+
+namespace external_bfs_search {
+// Files are read and written in blocks of roughly this size.
+static const size_t BLOCK_BYTES = 4 << 20;
+
+static size_t get_block_bins(int num_bins)
+{
+    return max<size_t>(1, BLOCK_BYTES / (num_bins * sizeof(Bin))) * num_bins;
+}
+
+static double get_mib(long long bytes)
+{
+    return bytes / (1024.0 * 1024.0);
+}
+
+PackedStateWriter::PackedStateWriter(
+    const string& path,
+    int num_bins,
+    IOStatistics& io_statistics)
+    : file(fopen(path.c_str(), "wb"))
+    , num_bins(num_bins)
+    , num_states(0)
+    , io_statistics(io_statistics)
+{
+    if (!file) {
+        cerr << "Could not create " << path << ": " << strerror(errno)
+             << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    buffer.reserve(get_block_bins(num_bins));
+}
+
+PackedStateWriter::~PackedStateWriter()
+{
+    flush();
+    fclose(file);
+}
+
+void PackedStateWriter::flush()
+{
+    if (buffer.empty()) return;
+    utils::TimerScope scope(io_statistics.timer);
+    if (fwrite(buffer.data(), sizeof(Bin), buffer.size(), file) !=
+        buffer.size()) {
+        cerr << "Could not write packed states: " << strerror(errno) << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    io_statistics.bytes_written += buffer.size() * sizeof(Bin);
+    buffer.clear();
+}
+
+void PackedStateWriter::write(const Bin* state)
+{
+    buffer.insert(buffer.end(), state, state + num_bins);
+    ++num_states;
+    if (buffer.size() >= get_block_bins(num_bins)) {
+        flush();
+    }
+}
+
+PackedStateReader::PackedStateReader(
+    const string& path,
+    int num_bins,
+    IOStatistics& io_statistics)
+    : file(fopen(path.c_str(), "rb"))
+    , num_bins(num_bins)
+    , position(0)
+    , io_statistics(io_statistics)
+{
+    if (!file) {
+        cerr << "Could not open " << path << ": " << strerror(errno) << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    fill();
+}
+
+PackedStateReader::~PackedStateReader()
+{
+    fclose(file);
+}
+
+void PackedStateReader::fill()
+{
+    utils::TimerScope scope(io_statistics.timer);
+    buffer.resize(get_block_bins(num_bins));
+    size_t num_read = fread(buffer.data(), sizeof(Bin), buffer.size(), file);
+    if (ferror(file)) {
+        cerr << "Could not read packed states: " << strerror(errno) << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_CRITICAL_ERROR);
+    }
+    assert(num_read % num_bins == 0);
+    buffer.resize(num_read);
+    position = 0;
+    io_statistics.bytes_read += num_read * sizeof(Bin);
+}
+
+void PackedStateReader::advance()
+{
+    assert(get());
+    position += num_bins;
+    if (position == buffer.size()) {
+        fill();
+    }
+}
+
+ExternalBFSSearch::ExternalBFSSearch(const Options& opts)
+    : ExternalBFSSearch(
+          opts.get<shared_ptr<ClassicalTask>>("transform"),
+          utils::get_log_from_options(opts),
+          opts.get<OperatorCost>("cost_type"),
+          opts.get<double>("max_time"),
+          opts.get<int>("bound"),
+          opts.get<int_packer::Encoding>("state_encoding"),
+          opts.get<string>("directory"),
+          opts.get<int>("buffer_size"),
+          opts.get<int>("locality"),
+          opts.get<bool>("keep_layers"),
+          opts.get<successor_generator::Representation>(
+              "successor_generator"))
+{
+    read_statistics_options(opts);
+}
+
+ExternalBFSSearch::ExternalBFSSearch(
+    shared_ptr<ClassicalTask> task,
+    utils::LogProxy log,
+    OperatorCost cost_type,
+    double max_time,
+    int bound,
+    int_packer::Encoding state_encoding,
+    const string& directory,
+    int buffer_size_in_mb,
+    int locality,
+    bool keep_layers,
+    successor_generator::Representation successor_generator_representation)
+    : SearchAlgorithm(
+          task,
+          log,
+          cost_type,
+          max_time,
+          bound,
+          SearchNodeStorage::STRUCT,
+          nullptr,
+          state_encoding,
+          successor_generator_representation)
+    , directory(directory.empty() ? string(".") : directory)
+    , locality(locality)
+    , keep_layers(keep_layers)
+    , state_packer(
+          task_properties::get_state_packer(task_proxy, state_encoding))
+    , num_bins(state_packer.get_num_bins())
+    , max_buffered_states(min<size_t>(
+          numeric_limits<uint32_t>::max(),
+          max<size_t>(
+              1,
+              // Sorting needs one additional index per buffered state.
+              static_cast<size_t>(buffer_size_in_mb) * 1024 * 1024 /
+                  (num_bins * sizeof(Bin) + sizeof(uint32_t)))))
+    , bytes_on_disk(0)
+    , peak_bytes_on_disk(0)
+    , current_layer(0)
+{
+    for (FactProxy goal : task_proxy.get_goal()) {
+        goals.push_back(goal.get_pair());
+    }
+    if (!is_unit_cost && this->bound != numeric_limits<int>::max()) {
+        cerr << "External breadth-first search only supports cost bounds "
+             << "for unit-cost tasks" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+}
+
+ExternalBFSSearch::~ExternalBFSSearch()
+{
+    layer_reader.reset();
+    for (size_t run = 0; run < run_sizes.size(); ++run) {
+        remove_file(get_run_path(run), run_sizes[run]);
+    }
+    if (!keep_layers) {
+        for (size_t layer = 0; layer < layer_sizes.size(); ++layer) {
+            remove_file(get_layer_path(layer), layer_sizes[layer]);
+        }
+    }
+}
+
+string ExternalBFSSearch::get_layer_path(int layer) const
+{
+    return directory + "/bfs-layer-" + to_string(layer);
+}
+
+string ExternalBFSSearch::get_run_path(int run) const
+{
+    return directory + "/bfs-run-" + to_string(run);
+}
+
+void ExternalBFSSearch::remove_file(const string& path, long long num_states)
+{
+    remove(path.c_str());
+    bytes_on_disk -= num_states * num_bins * sizeof(Bin);
+}
+
+bool ExternalBFSSearch::is_goal(const Bin* state) const
+{
+    for (const FactPair& goal : goals) {
+        if (state_packer.get(state, goal.var) != goal.value) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool ExternalBFSSearch::less(const Bin* lhs, const Bin* rhs) const
+{
+    return lexicographical_compare(lhs, lhs + num_bins, rhs, rhs + num_bins);
+}
+
+bool ExternalBFSSearch::equal(const Bin* lhs, const Bin* rhs) const
+{
+    return std::equal(lhs, lhs + num_bins, rhs);
+}
+
+void ExternalBFSSearch::generate_applicable_ops(const Bin* state)
+{
+    for (size_t var = 0; var < values.size(); ++var) {
+        values[var] = state_packer.get(state, var);
+    }
+    applicable_ops.clear();
+    successor_generator.generate_applicable_ops(
+        task_proxy.create_state(vector<int>(values)),
+        applicable_ops);
+}
+
+void ExternalBFSSearch::apply(OperatorID op_id, Bin* state) const
+{
+    for (const FactPair& effect : compiled_task.get_effects(op_id)) {
+        state_packer.set(state, effect.var, effect.value);
+    }
+}
+
+void ExternalBFSSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting external breadth-first search in " << directory
+            << ", (real) bound = " << bound << endl;
+        log << "Bytes per state on disk: " << num_bins * sizeof(Bin) << endl;
+        log << "Successor buffer: " << max_buffered_states << " states"
+            << endl;
+        if (!is_unit_cost) {
+            log << "Warning: the task has non-unit costs, but plans are "
+                << "only shortest in the number of operators." << endl;
+        }
+    }
+
+    values = task_proxy.get_initial_state().get_unpacked_values();
+    vector<Bin> initial_state(num_bins, 0);
+    for (size_t var = 0; var < values.size(); ++var) {
+        state_packer.set(initial_state.data(), var, values[var]);
+    }
+    {
+        PackedStateWriter writer(get_layer_path(0), num_bins, io_statistics);
+        writer.write(initial_state.data());
+    }
+    layer_sizes.push_back(1);
+    bytes_on_disk += num_bins * sizeof(Bin);
+    peak_bytes_on_disk = bytes_on_disk;
+
+    if (is_goal(initial_state.data())) {
+        goal_state = initial_state;
+    } else {
+        layer_reader = make_unique<PackedStateReader>(
+            get_layer_path(0),
+            num_bins,
+            io_statistics);
+    }
+}
+
+void ExternalBFSSearch::expand(const Bin* state)
+{
+    statistics.inc_expanded();
+    if (current_layer + 1 >= bound) return;
+
+    generate_applicable_ops(state);
+    for (OperatorID op_id : applicable_ops) {
+        size_t offset = successor_buffer.size();
+        successor_buffer.insert(
+            successor_buffer.end(),
+            state,
+            state + num_bins);
+        apply(op_id, &successor_buffer[offset]);
+        statistics.inc_generated();
+        if (successor_buffer.size() >= max_buffered_states * num_bins) {
+            write_run();
+        }
+    }
+}
+
+void ExternalBFSSearch::write_run()
+{
+    if (successor_buffer.empty()) return;
+
+    vector<uint32_t> order(successor_buffer.size() / num_bins);
+    iota(order.begin(), order.end(), 0);
+    /*
+      The indices fit into 32 bits, but their offsets in the buffer may not,
+      so we compute them with size_t.
+    */
+    const Bin* states = successor_buffer.data();
+    auto get_state = [&](uint32_t index) {
+        return states + static_cast<size_t>(index) * num_bins;
+    };
+    sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+        return less(get_state(lhs), get_state(rhs));
+    });
+
+    PackedStateWriter writer(
+        get_run_path(run_sizes.size()),
+        num_bins,
+        io_statistics);
+    const Bin* last = nullptr;
+    for (uint32_t index : order) {
+        const Bin* state = get_state(index);
+        if (!last || !equal(last, state)) {
+            writer.write(state);
+            last = state;
+        }
+    }
+    run_sizes.push_back(writer.get_num_states());
+    bytes_on_disk += writer.get_num_states() * num_bins * sizeof(Bin);
+    peak_bytes_on_disk = max(peak_bytes_on_disk, bytes_on_disk);
+    successor_buffer.clear();
+}
+
+void ExternalBFSSearch::merge_runs()
+{
+    write_run();
+    int new_layer = current_layer + 1;
+
+    vector<unique_ptr<PackedStateReader>> runs;
+    for (size_t run = 0; run < run_sizes.size(); ++run) {
+        runs.push_back(make_unique<PackedStateReader>(
+            get_run_path(run),
+            num_bins,
+            io_statistics));
+    }
+    int first_layer = locality == 0 ? 0 : max(0, new_layer - locality);
+    vector<unique_ptr<PackedStateReader>> previous_layers;
+    for (int layer = first_layer; layer < new_layer; ++layer) {
+        previous_layers.push_back(make_unique<PackedStateReader>(
+            get_layer_path(layer),
+            num_bins,
+            io_statistics));
+    }
+
+    // Min-heap of the runs ordered by their current states.
+    auto greater = [&](int lhs, int rhs) {
+        return less(runs[rhs]->get(), runs[lhs]->get());
+    };
+    vector<int> heap;
+    for (size_t run = 0; run < runs.size(); ++run) {
+        if (runs[run]->get()) heap.push_back(run);
+    }
+    make_heap(heap.begin(), heap.end(), greater);
+
+    long long layer_size = 0;
+    {
+        PackedStateWriter writer(
+            get_layer_path(new_layer),
+            num_bins,
+            io_statistics);
+        vector<Bin> last;
+        // The layer is completed even after a goal is found, so that every
+        // layer file holds all states of its layer.
+        while (!heap.empty()) {
+            pop_heap(heap.begin(), heap.end(), greater);
+            PackedStateReader& run = *runs[heap.back()];
+            const Bin* state = run.get();
+            if (last.empty() || !equal(last.data(), state)) {
+                last.assign(state, state + num_bins);
+                bool is_new = true;
+                for (const auto& layer : previous_layers) {
+                    while (layer->get() && less(layer->get(), state)) {
+                        layer->advance();
+                    }
+                    if (layer->get() && equal(layer->get(), state)) {
+                        is_new = false;
+                        break;
+                    }
+                }
+                if (is_new) {
+                    writer.write(state);
+                    if (goal_state.empty() && is_goal(state)) {
+                        goal_state = last;
+                    }
+                }
+            }
+            run.advance();
+            if (run.get()) {
+                push_heap(heap.begin(), heap.end(), greater);
+            } else {
+                heap.pop_back();
+            }
+        }
+        layer_size = writer.get_num_states();
+    }
+    layer_sizes.push_back(layer_size);
+    bytes_on_disk += layer_size * num_bins * sizeof(Bin);
+    peak_bytes_on_disk = max(peak_bytes_on_disk, bytes_on_disk);
+
+    runs.clear();
+    for (size_t run = 0; run < run_sizes.size(); ++run) {
+        remove_file(get_run_path(run), run_sizes[run]);
+    }
+    run_sizes.clear();
+
+    if (log.is_at_least_normal()) {
+        log << "Layer " << new_layer << ": " << layer_size << " states, "
+            << get_mib(bytes_on_disk) << " MiB on disk" << endl;
+    }
+}
+
+void ExternalBFSSearch::extract_plan()
+{
+    Plan plan;
+    vector<Bin> state = goal_state;
+    vector<Bin> successor(num_bins);
+    for (int layer = layer_sizes.size() - 2; layer >= 0; --layer) {
+        PackedStateReader reader(
+            get_layer_path(layer),
+            num_bins,
+            io_statistics);
+        bool found_predecessor = false;
+        for (const Bin* predecessor = reader.get();
+             predecessor && !found_predecessor;
+             reader.advance(), predecessor = reader.get()) {
+            generate_applicable_ops(predecessor);
+            for (OperatorID op_id : applicable_ops) {
+                copy(predecessor, predecessor + num_bins, successor.begin());
+                apply(op_id, successor.data());
+                if (equal(successor.data(), state.data())) {
+                    plan.push_back(op_id);
+                    state.assign(predecessor, predecessor + num_bins);
+                    found_predecessor = true;
+                    break;
+                }
+            }
+        }
+        assert(found_predecessor);
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+SearchStatus ExternalBFSSearch::step()
+{
+    if (goal_state.empty()) {
+        if (const Bin* state = layer_reader->get()) {
+            expand(state);
+            layer_reader->advance();
+            return IN_PROGRESS;
+        }
+
+        layer_reader.reset();
+        merge_runs();
+        if (goal_state.empty()) {
+            if (layer_sizes.back() == 0) {
+                log << "Completely explored state space -- no solution!"
+                    << endl;
+                return FAILED;
+            }
+            ++current_layer;
+            layer_reader = make_unique<PackedStateReader>(
+                get_layer_path(current_layer),
+                num_bins,
+                io_statistics);
+            return IN_PROGRESS;
+        }
+    }
+
+    if (log.is_at_least_normal()) log << "Solution found!" << endl;
+    extract_plan();
+    return SOLVED;
+}
+
+void ExternalBFSSearch::write_statistics_json(utils::JsonWriter& json) const
+{
+    SearchAlgorithm::write_statistics_json(json);
+    json.key("layer_sizes");
+    json.begin_array();
+    for (long long layer_size : layer_sizes) {
+        json.value(layer_size);
+    }
+    json.end_array();
+    json.key("bytes_read");
+    json.value(io_statistics.bytes_read);
+    json.key("bytes_written");
+    json.value(io_statistics.bytes_written);
+    json.key("peak_bytes_on_disk");
+    json.value(peak_bytes_on_disk);
+    json.key("io_time");
+    json.value(static_cast<double>(io_statistics.timer()));
+}
+
+void ExternalBFSSearch::print_statistics() const
+{
+    statistics.print_detailed_statistics();
+    log << "Layers: " << layer_sizes.size() << endl;
+    log << "States in all layers: "
+        << accumulate(layer_sizes.begin(), layer_sizes.end(), 0LL) << endl;
+    log << "Bytes read: " << io_statistics.bytes_read << endl;
+    log << "Bytes written: " << io_statistics.bytes_written << endl;
+    log << "Peak disk usage: " << get_mib(peak_bytes_on_disk) << " MiB"
+        << endl;
+    double io_time = io_statistics.timer();
+    log << "I/O time: " << io_time << "s" << endl;
+    if (io_time > 0) {
+        log << "I/O throughput: "
+            << get_mib(
+                   io_statistics.bytes_read + io_statistics.bytes_written) /
+                   io_time
+            << " MiB/s" << endl;
+    }
+}
+
+void add_options_to_parser(OptionParser& parser)
+{
+    parser.add_option<string>(
+        "directory",
+        "directory for the layer files (bfs-layer-0, bfs-layer-1, ...) and "
+        "the temporary sorted runs (bfs-run-0, ...). Must not be shared "
+        "with another external search running at the same time",
+        ".");
+    parser.add_option<int>(
+        "buffer_size",
+        "memory for buffering successors before they are sorted and "
+        "written to disk, in MiB",
+        "512",
+        Bounds("1", "infinity"));
+    parser.add_option<int>(
+        "locality",
+        "number of preceding layers against which new states are checked "
+        "for duplicates. 0 checks all layers. Smaller values save I/O, but "
+        "are only exact if no operator sequence leads back more layers "
+        "than this, e.g., 2 if every operator can be undone",
+        "0",
+        Bounds("0", "infinity"));
+    parser.add_option<bool>(
+        "keep_layers",
+        "keep the layer files after the search, e.g., as labels of all "
+        "states with their distance from the initial state",
+        "false");
+    // States are stored in the layer files, not in a state registry.
+    SearchAlgorithm::add_common_options_to_parser(parser);
+    SearchAlgorithm::add_state_encoding_option_to_parser(parser);
+    SearchAlgorithm::add_successor_generator_option_to_parser(parser);
+}
+} // namespace external_bfs_search
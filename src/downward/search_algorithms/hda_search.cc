@@ -0,0 +1,514 @@
+#include "downward/search_algorithms/hda_search.h"
+
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluator.h"
+#include "downward/open_list.h"
+#include "downward/open_list_factory.h"
+#include "downward/option_parser.h"
+#include "downward/per_state_information.h"
+
+#include "downward/algorithms/mapped_segment_allocator.h"
+#include "downward/task_utils/successor_generator.h"
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/countdown_timer.h"
+#include "downward/utils/hash.h"
+#include "downward/utils/logging.h"
+
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <condition_variable>
+#include <limits>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+namespace hda_search {
+// Number of expansions between two checks of the time limit.
+static const int TIMER_CHECK_INTERVAL = 1024;
+
+/*
+  A successor generated by one worker and handed to the worker owning it.
+  We send the unpacked variable values because registries (and hence packed
+  buffers and state IDs) are local to their worker.
+*/
+struct Message {
+    vector<int> values;
+    int g;
+    int real_g;
+    int parent_worker;
+    StateID parent_id;
+    OperatorID creating_operator;
+};
+
+struct NodeInfo {
+    int g = -1;
+    int real_g = -1;
+    int h = -1;
+    int parent_worker = -1;
+    StateID parent_id = StateID::no_state;
+    OperatorID creating_operator = OperatorID::no_operator;
+    bool closed = false;
+    bool dead_end = false;
+
+    bool is_new() const { return g == -1 && !dead_end; }
+};
+
+class HDASearch::Worker {
+    HDASearch& search;
+    const int id;
+
+    utils::LogProxy silent_log;
+
+public:
+    shared_ptr<Evaluator> evaluator;
+    unique_ptr<StateOpenList> open_list;
+    StateRegistry state_registry;
+    PerStateInformation<NodeInfo> node_infos;
+    SearchStatistics statistics;
+
+    mutex inbox_mutex;
+    condition_variable inbox_cv;
+    vector<Message> inbox;
+    vector<vector<Message>> outboxes;
+
+    Worker(HDASearch& search, int id, shared_ptr<Evaluator> evaluator);
+
+    void insert_initial_state();
+    void run();
+
+private:
+    bool expand_one();
+    void process_message(Message& message);
+    void process_state(
+        vector<int>&& values,
+        int g,
+        int real_g,
+        int parent_worker,
+        StateID parent_id,
+        OperatorID op_id);
+    void flush_outboxes();
+    bool wait_for_messages(vector<Message>& messages);
+};
+
+HDASearch::Worker::Worker(
+    HDASearch& search,
+    int id,
+    shared_ptr<Evaluator> evaluator)
+    : search(search)
+    , id(id)
+    , silent_log(utils::get_silent_log())
+    , evaluator(evaluator)
+    , open_list(search_common::create_astar_open_list_factory_and_f_eval(
+                    utils::Verbosity::SILENT,
+                    evaluator)
+                    .first->create_state_open_list())
+    , state_registry(
+          search.task_proxy,
+          search.create_worker_arena(),
+          search.state_encoding)
+    , statistics(silent_log)
+    , outboxes(search.get_num_threads())
+{
+}
+
+void HDASearch::Worker::insert_initial_state()
+{
+    vector<int> values =
+        search.task_proxy.get_initial_state().get_unpacked_values();
+    process_state(
+        std::move(values),
+        0,
+        0,
+        -1,
+        StateID::no_state,
+        OperatorID::no_operator);
+}
+
+void HDASearch::Worker::process_state(
+    vector<int>&& values,
+    int g,
+    int real_g,
+    int parent_worker,
+    StateID parent_id,
+    OperatorID op_id)
+{
+    State state = state_registry.insert_state(std::move(values));
+    NodeInfo& info = node_infos[state];
+    if (info.dead_end) return;
+
+    bool is_new = info.is_new();
+    if (!is_new && info.g <= g) return;
+
+    EvaluationContext eval_context(state, g, false, &statistics);
+    if (is_new) {
+        statistics.inc_evaluated_states();
+        if (open_list->is_dead_end(eval_context)) {
+            info.dead_end = true;
+            statistics.inc_dead_ends();
+            return;
+        }
+        info.h = eval_context.get_evaluator_value(evaluator.get());
+    } else if (info.closed) {
+        statistics.inc_reopened();
+    }
+
+    info.g = g;
+    info.real_g = real_g;
+    info.parent_worker = parent_worker;
+    info.parent_id = parent_id;
+    info.creating_operator = op_id;
+    info.closed = false;
+
+    if (g + info.h >= search.incumbent_cost.load(memory_order_relaxed)) return;
+    open_list->insert(eval_context, state.get_id());
+}
+
+void HDASearch::Worker::process_message(Message& message)
+{
+    process_state(
+        std::move(message.values),
+        message.g,
+        message.real_g,
+        message.parent_worker,
+        message.parent_id,
+        message.creating_operator);
+}
+
+bool HDASearch::Worker::expand_one()
+{
+    while (!open_list->empty()) {
+        StateID state_id = open_list->remove_min();
+        NodeInfo& info = node_infos[state_registry.lookup_state(state_id)];
+        // Skip stale entries of states that have been expanded since.
+        if (info.closed) continue;
+        // Nodes that cannot improve on the incumbent are pruned.
+        int incumbent = search.incumbent_cost.load(memory_order_relaxed);
+        if (info.g + info.h >= incumbent) continue;
+
+        info.closed = true;
+        statistics.inc_expanded();
+        statistics.report_f_value_progress(info.g + info.h);
+
+        State state = state_registry.lookup_state(state_id);
+        if (task_properties::is_goal_state(search.task_proxy, state)) {
+            search.report_goal(id, state_id, info.g);
+            return true;
+        }
+
+        int g = info.g;
+        int real_g = info.real_g;
+        vector<OperatorID> applicable_ops;
+        search.successor_generator.generate_applicable_ops(
+            state,
+            applicable_ops);
+        statistics.inc_generated_ops(applicable_ops.size());
+
+        const vector<int>& values = state.get_unpacked_values();
+        for (OperatorID op_id : applicable_ops) {
+            OperatorProxy op = search.task_proxy.get_operators()[op_id];
+            if (real_g + op.get_cost() >= search.bound) continue;
+
+            vector<int> succ_values = values;
+            for (FactProxy effect : op.get_effect()) {
+                FactPair fact = effect.get_pair();
+                succ_values[fact.var] = fact.value;
+            }
+            statistics.inc_generated();
+
+            int succ_g = g + search.get_adjusted_cost(op);
+            int succ_real_g = real_g + op.get_cost();
+            int owner = search.get_owner(succ_values);
+            if (owner == id) {
+                process_state(
+                    std::move(succ_values),
+                    succ_g,
+                    succ_real_g,
+                    id,
+                    state_id,
+                    op_id);
+            } else {
+                outboxes[owner].push_back(Message{
+                    std::move(succ_values),
+                    succ_g,
+                    succ_real_g,
+                    id,
+                    state_id,
+                    op_id});
+            }
+        }
+        flush_outboxes();
+        return true;
+    }
+    return false;
+}
+
+void HDASearch::Worker::flush_outboxes()
+{
+    for (size_t receiver_id = 0; receiver_id < outboxes.size();
+         ++receiver_id) {
+        vector<Message>& outbox = outboxes[receiver_id];
+        if (outbox.empty()) continue;
+        /*
+          Account for the messages before they become visible to the
+          receiver. Otherwise the receiver could process them and drop the
+          work counter to zero while we still have messages to send.
+        */
+        search.outstanding_work.fetch_add(outbox.size());
+        Worker& receiver = *search.workers[receiver_id];
+        {
+            lock_guard<mutex> lock(receiver.inbox_mutex);
+            receiver.inbox.insert(
+                receiver.inbox.end(),
+                make_move_iterator(outbox.begin()),
+                make_move_iterator(outbox.end()));
+        }
+        receiver.inbox_cv.notify_one();
+        outbox.clear();
+    }
+}
+
+/*
+  Block until messages arrive or the search terminates. Returns false if the
+  search terminated. Must only be called by an idle worker, i.e., one whose
+  share of the work counter has already been given up.
+*/
+bool HDASearch::Worker::wait_for_messages(vector<Message>& messages)
+{
+    unique_lock<mutex> lock(inbox_mutex);
+    while (inbox.empty()) {
+        if (search.terminated.load()) return false;
+        inbox_cv.wait_for(lock, chrono::milliseconds(10));
+        if (id == 0 && search.timer->is_expired()) {
+            search.timed_out.store(true);
+            search.terminated.store(true);
+        }
+    }
+    // Become busy again before consuming the messages' share of the counter.
+    search.outstanding_work.fetch_add(1);
+    messages.swap(inbox);
+    return true;
+}
+
+void HDASearch::Worker::run()
+{
+    vector<Message> messages;
+    int steps = 0;
+    while (!search.terminated.load(memory_order_relaxed)) {
+        {
+            lock_guard<mutex> lock(inbox_mutex);
+            messages.swap(inbox);
+        }
+        for (Message& message : messages) {
+            process_message(message);
+        }
+        if (!messages.empty()) {
+            search.outstanding_work.fetch_sub(messages.size());
+            messages.clear();
+        }
+
+        if (id == 0 && ++steps % TIMER_CHECK_INTERVAL == 0 &&
+            search.timer->is_expired()) {
+            search.timed_out.store(true);
+            search.terminated.store(true);
+        }
+
+        if (expand_one()) continue;
+
+        // Go idle. If we were the last source of work, the search is over.
+        if (search.outstanding_work.fetch_sub(1) == 1) {
+            search.terminated.store(true);
+        }
+        if (!wait_for_messages(messages)) break;
+        for (Message& message : messages) {
+            process_message(message);
+        }
+        search.outstanding_work.fetch_sub(messages.size());
+        messages.clear();
+    }
+
+    // Wake up everyone else so they notice the termination.
+    for (const unique_ptr<Worker>& worker : search.workers) {
+        lock_guard<mutex> lock(worker->inbox_mutex);
+        worker->inbox_cv.notify_all();
+    }
+}
+
+HDASearch::HDASearch(
+    shared_ptr<ClassicalTask> task,
+    utils::LogProxy log,
+    OperatorCost cost_type,
+    double max_time,
+    int bound,
+    const vector<shared_ptr<Evaluator>>& evaluators,
+    StateStorage state_storage,
+    const string& state_storage_directory,
+    int_packer::Encoding state_encoding,
+    successor_generator::Representation successor_generator_representation)
+    : SearchAlgorithm(
+          task,
+          log,
+          cost_type,
+          max_time,
+          bound,
+          SearchNodeStorage::STRUCT,
+          nullptr,
+          state_encoding,
+          successor_generator_representation)
+    , state_storage(state_storage)
+    , state_storage_directory(state_storage_directory)
+    , state_encoding(state_encoding)
+    , outstanding_work(0)
+    , terminated(false)
+    , timed_out(false)
+    , incumbent_cost(numeric_limits<int>::max())
+    , goal_worker(-1)
+    , goal_id(StateID::no_state)
+{
+    assert(!evaluators.empty());
+    workers.resize(evaluators.size());
+    for (size_t i = 0; i < evaluators.size(); ++i) {
+        workers[i] = make_unique<Worker>(*this, i, evaluators[i]);
+    }
+}
+
+HDASearch::~HDASearch() = default;
+
+int HDASearch::get_num_threads() const
+{
+    return workers.size();
+}
+
+shared_ptr<mapped_segment_allocator::MappedArena>
+HDASearch::create_worker_arena() const
+{
+    if (state_storage == StateStorage::HEAP) return nullptr;
+    // Arenas are not thread-safe, so the workers cannot share one.
+    return make_shared<mapped_segment_allocator::MappedArena>(
+        state_storage_directory);
+}
+
+int HDASearch::get_owner(const vector<int>& values) const
+{
+    return utils::get_hash(values) % workers.size();
+}
+
+void HDASearch::report_goal(int worker_id, StateID id, int g)
+{
+    lock_guard<mutex> lock(incumbent_mutex);
+    if (g < incumbent_cost.load()) {
+        incumbent_cost.store(g);
+        goal_worker = worker_id;
+        goal_id = id;
+    }
+}
+
+void HDASearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting hash-distributed A* search with "
+            << workers.size() << " thread(s), (real) bound = " << bound
+            << endl;
+    }
+
+    for (const unique_ptr<Worker>& worker : workers) {
+        worker->statistics.set_time_evaluators(
+            statistics.is_timing_evaluators());
+        set<Evaluator*> evals;
+        worker->evaluator->get_path_dependent_evaluators(evals);
+        if (!evals.empty()) {
+            cerr << "parallel_astar does not support path-dependent "
+                 << "evaluators" << endl;
+            utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+        }
+    }
+
+    vector<int> initial_values =
+        task_proxy.get_initial_state().get_unpacked_values();
+    Worker& owner = *workers[get_owner(initial_values)];
+    owner.insert_initial_state();
+    if (owner.open_list->empty()) {
+        log << "Initial state is a dead end." << endl;
+    }
+}
+
+SearchStatus HDASearch::step()
+{
+    // Every worker starts out busy.
+    outstanding_work.store(workers.size());
+
+    vector<thread> threads;
+    threads.reserve(workers.size());
+    for (const unique_ptr<Worker>& worker : workers) {
+        threads.emplace_back(&Worker::run, worker.get());
+    }
+    for (thread& t : threads) {
+        t.join();
+    }
+
+    vector<int> thread_expansions;
+    for (const unique_ptr<Worker>& worker : workers) {
+        statistics.merge(worker->statistics);
+        thread_expansions.push_back(worker->statistics.get_expanded());
+    }
+    statistics.report_thread_expansions(thread_expansions);
+
+    if (timed_out.load()) return TIMEOUT;
+    if (goal_worker == -1) {
+        log << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+    extract_plan();
+    return SOLVED;
+}
+
+void HDASearch::extract_plan()
+{
+    if (log.is_at_least_normal()) log << "Solution found!" << endl;
+    Plan plan;
+    int worker_id = goal_worker;
+    StateID id = goal_id;
+    while (true) {
+        Worker& worker = *workers[worker_id];
+        const NodeInfo& info =
+            worker.node_infos[worker.state_registry.lookup_state(id)];
+        if (info.creating_operator == OperatorID::no_operator) {
+            assert(info.parent_id == StateID::no_state);
+            break;
+        }
+        plan.push_back(info.creating_operator);
+        worker_id = info.parent_worker;
+        id = info.parent_id;
+    }
+    reverse(plan.begin(), plan.end());
+    set_plan(plan);
+}
+
+size_t HDASearch::get_num_registered_states() const
+{
+    size_t num_registered = 0;
+    for (const unique_ptr<Worker>& worker : workers) {
+        num_registered += worker->state_registry.size();
+    }
+    return num_registered;
+}
+
+void HDASearch::print_statistics() const
+{
+    statistics.print_detailed_statistics();
+    log << "Number of registered states: " << get_num_registered_states()
+        << endl;
+}
+
+void add_options_to_parser(OptionParser& parser)
+{
+    // The workers keep their own per-state information, not search nodes.
+    SearchAlgorithm::add_common_options_to_parser(parser);
+    SearchAlgorithm::add_state_storage_options_to_parser(parser);
+    SearchAlgorithm::add_state_encoding_option_to_parser(parser);
+    SearchAlgorithm::add_successor_generator_option_to_parser(parser);
+}
+} // namespace hda_search
@@ -0,0 +1,302 @@
+#include "downward/search_algorithms/idastar_search.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluation_result.h"
+#include "downward/evaluator.h"
+#include "downward/option_parser.h"
+
+#include "downward/utils/json.h"
+#include "downward/utils/logging.h"
+#include "downward/utils/system.h"
+
+#include <algorithm>
+#include <cassert>
+#include <set>
+
+using namespace std;
+
+namespace idastar_search {
+TranspositionTable::TranspositionTable(int size_in_mb)
+    : entries(
+          max<size_t>(
+              1,
+              static_cast<size_t>(size_in_mb) * 1024 * 1024 / sizeof(Entry)),
+          Entry{0, 0, -1})
+    , num_hits(0)
+{
+}
+
+bool TranspositionTable::check(uint64_t key, int g, int iteration)
+{
+    const Entry& entry = get_entry(key);
+    if (entry.iteration == iteration && entry.key == key && entry.g <= g) {
+        ++num_hits;
+        return true;
+    }
+    return false;
+}
+
+bool TranspositionTable::check_and_update(uint64_t key, int g, int iteration)
+{
+    if (check(key, g, iteration)) {
+        return true;
+    }
+    get_entry(key) = Entry{key, g, iteration};
+    return false;
+}
+
+IDAStarSearch::IDAStarSearch(const Options& opts)
+    : IDAStarSearch(
+          opts.get<shared_ptr<ClassicalTask>>("transform"),
+          utils::get_log_from_options(opts),
+          opts.get<OperatorCost>("cost_type"),
+          opts.get<double>("max_time"),
+          opts.get<int>("bound"),
+          opts.get<shared_ptr<Evaluator>>("eval"),
+          opts.get<int>("transposition_table_size"),
+          opts.get<successor_generator::Representation>(
+              "successor_generator"))
+{
+    read_statistics_options(opts);
+}
+
+IDAStarSearch::IDAStarSearch(
+    shared_ptr<ClassicalTask> task,
+    utils::LogProxy log,
+    OperatorCost cost_type,
+    double max_time,
+    int bound,
+    shared_ptr<Evaluator> evaluator,
+    int transposition_table_size_in_mb,
+    successor_generator::Representation successor_generator_representation)
+    : SearchAlgorithm(
+          task,
+          log,
+          cost_type,
+          max_time,
+          bound,
+          SearchNodeStorage::STRUCT,
+          nullptr,
+          int_packer::Encoding::BIT_FIELDS,
+          successor_generator_representation)
+    , evaluator(std::move(evaluator))
+    , f_bound(0)
+    , next_f_bound(0)
+    , iteration(-1)
+    , initial_state_is_dead_end(false)
+{
+    if (transposition_table_size_in_mb > 0) {
+        transposition_table = make_unique<TranspositionTable>(
+            transposition_table_size_in_mb);
+    }
+}
+
+IDAStarSearch::~IDAStarSearch() = default;
+
+void IDAStarSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting IDA* search, (real) bound = " << bound << endl;
+        if (transposition_table) {
+            log << "Transposition table entries: "
+                << transposition_table->size() << endl;
+        }
+    }
+
+    set<Evaluator*> path_dependent_evaluators;
+    evaluator->get_path_dependent_evaluators(path_dependent_evaluators);
+    if (!path_dependent_evaluators.empty()) {
+        cerr << "IDA* does not support path-dependent evaluators" << endl;
+        utils::exit_with(utils::ExitCode::SEARCH_UNSUPPORTED);
+    }
+
+    State initial_state = task_proxy.get_initial_state();
+    EvaluationContext eval_context(initial_state, 0, true, &statistics);
+    statistics.inc_evaluated_states();
+    print_initial_evaluator_values(eval_context);
+
+    if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+        log << "Initial state is a dead end." << endl;
+        initial_state_is_dead_end = true;
+        statistics.inc_dead_ends();
+    } else {
+        next_f_bound = eval_context.get_evaluator_value(evaluator.get());
+    }
+}
+
+uint64_t IDAStarSearch::get_key(const vector<int>& values) const
+{
+    return transposition_table ? utils::get_hash64(values) : 0;
+}
+
+void IDAStarSearch::start_iteration()
+{
+    assert(path.empty());
+    f_bound = next_f_bound;
+    next_f_bound = EvaluationResult::INFTY;
+    ++iteration;
+    statistics.report_f_value_progress(f_bound);
+
+    State initial_state = task_proxy.get_initial_state();
+    uint64_t key = get_key(initial_state.get_unpacked_values());
+    push(std::move(initial_state), OperatorID::no_operator, 0, 0, key);
+}
+
+bool IDAStarSearch::push(
+    State&& state,
+    OperatorID op_id,
+    int g,
+    int real_g,
+    uint64_t key)
+{
+    if (transposition_table &&
+        transposition_table->check_and_update(key, g, iteration)) {
+        return false;
+    }
+
+    path.push_back(Frame{std::move(state), op_id, g, real_g, {}, 0});
+    Frame& frame = path.back();
+    states_on_path.insert(frame.state.get_unpacked_values());
+
+    if (compiled_task.is_goal_state(frame.state.get_unpacked_values())) {
+        if (log.is_at_least_normal()) log << "Solution found!" << endl;
+        extract_plan();
+        return true;
+    }
+
+    statistics.inc_expanded();
+    applicable_ops.clear();
+    successor_generator.generate_applicable_ops(frame.state, applicable_ops);
+    for (OperatorID succ_op_id : applicable_ops) {
+        int succ_real_g = real_g + compiled_task.get_cost(succ_op_id);
+        if (succ_real_g >= bound) continue;
+        statistics.inc_generated();
+
+        vector<int> succ_values = frame.state.get_unpacked_values();
+        for (const FactPair& effect : compiled_task.get_effects(succ_op_id)) {
+            succ_values[effect.var] = effect.value;
+        }
+        if (states_on_path.contains(succ_values)) continue;
+
+        int succ_g = g + get_adjusted_cost(succ_op_id);
+        uint64_t succ_key = get_key(succ_values);
+        if (transposition_table &&
+            transposition_table->check(succ_key, succ_g, iteration)) {
+            continue;
+        }
+
+        State succ_state = task_proxy.create_state(std::move(succ_values));
+        EvaluationContext eval_context(succ_state, succ_g, false, &statistics);
+        statistics.inc_evaluated_states();
+        if (eval_context.is_evaluator_value_infinite(evaluator.get())) {
+            statistics.inc_dead_ends();
+            continue;
+        }
+        int succ_h = eval_context.get_evaluator_value(evaluator.get());
+        int succ_f = succ_g + succ_h;
+        if (succ_f > f_bound) {
+            next_f_bound = min(next_f_bound, succ_f);
+            continue;
+        }
+        frame.successors.push_back(Successor{succ_op_id, succ_h, succ_key});
+    }
+
+    stable_sort(
+        frame.successors.begin(),
+        frame.successors.end(),
+        [](const Successor& lhs, const Successor& rhs) {
+            return lhs.h < rhs.h;
+        });
+    return false;
+}
+
+void IDAStarSearch::pop()
+{
+    assert(!path.empty());
+    states_on_path.erase(path.back().state.get_unpacked_values());
+    path.pop_back();
+}
+
+void IDAStarSearch::extract_plan()
+{
+    Plan plan;
+    for (size_t i = 1; i < path.size(); ++i) {
+        plan.push_back(path[i].op_id);
+    }
+    set_plan(plan);
+}
+
+SearchStatus IDAStarSearch::step()
+{
+    if (initial_state_is_dead_end) {
+        return FAILED;
+    }
+
+    if (path.empty()) {
+        if (next_f_bound == EvaluationResult::INFTY) {
+            log << "Completely explored state space -- no solution!" << endl;
+            return FAILED;
+        }
+        start_iteration();
+        return found_solution() ? SOLVED : IN_PROGRESS;
+    }
+
+    Frame& frame = path.back();
+    if (frame.next_successor == frame.successors.size()) {
+        pop();
+        return IN_PROGRESS;
+    }
+
+    Successor succ = frame.successors[frame.next_successor++];
+    vector<int> succ_values = frame.state.get_unpacked_values();
+    for (const FactPair& effect : compiled_task.get_effects(succ.op_id)) {
+        succ_values[effect.var] = effect.value;
+    }
+    int succ_g = frame.g + get_adjusted_cost(succ.op_id);
+    int succ_real_g = frame.real_g + compiled_task.get_cost(succ.op_id);
+    if (push(
+            task_proxy.create_state(std::move(succ_values)),
+            succ.op_id,
+            succ_g,
+            succ_real_g,
+            succ.key)) {
+        return SOLVED;
+    }
+    return IN_PROGRESS;
+}
+
+void IDAStarSearch::write_statistics_json(utils::JsonWriter& json) const
+{
+    SearchAlgorithm::write_statistics_json(json);
+    json.key("iterations");
+    json.value(get_num_iterations());
+    json.key("transposition_table_hits");
+    if (transposition_table) {
+        json.value(transposition_table->get_num_hits());
+    } else {
+        json.null();
+    }
+}
+
+void IDAStarSearch::print_statistics() const
+{
+    statistics.print_detailed_statistics();
+    log << "Iterations: " << get_num_iterations() << endl;
+    if (transposition_table) {
+        log << "Transposition table hits: "
+            << transposition_table->get_num_hits() << endl;
+    }
+}
+
+void add_options_to_parser(OptionParser& parser)
+{
+    parser.add_option<int>(
+        "transposition_table_size",
+        "size of the transposition table in MiB (0 disables the table)",
+        "0",
+        Bounds("0", "infinity"));
+    // IDA* neither registers states nor stores search nodes.
+    SearchAlgorithm::add_common_options_to_parser(parser);
+    SearchAlgorithm::add_successor_generator_option_to_parser(parser);
+}
+} // namespace idastar_search
@@ -0,0 +1,53 @@
+#include "downward/search_algorithms/anytime_astar_search.h"
+
+#include "downward/option_parser.h"
+#include "downward/plugin.h"
+
+using namespace std;
+
+namespace plugin_anytime_astar {
+static shared_ptr<SearchAlgorithm> _parse(OptionParser& parser)
+{
+    parser.document_synopsis(
+        "Anytime A* search",
+        "Anytime repairing A* (ARA*): weighted A* with f = g + w * h for a "
+        "decreasing sequence of weights w. Each iteration continues from the "
+        "search space of the previous one instead of starting from scratch, "
+        "and every plan that is cheaper than the previous one is written as "
+        "soon as it is found. The plan at the end of the iteration with "
+        "weight w costs at most w times the optimal cost if the heuristic is "
+        "consistent.");
+    parser.document_note(
+        "Plan files",
+        "All plans are saved as numbered plan files (e.g., sas_plan.1, "
+        "sas_plan.2, ...), so the last plan file always holds the cheapest "
+        "plan found so far, even if the search is interrupted.");
+    parser.document_note(
+        "Evaluators",
+        "Heuristic values are looked up in the evaluator caches when a state "
+        "is reached on a cheaper path or the weight changes. Path-dependent "
+        "evaluators are not supported.");
+    parser.add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+
+    anytime_astar_search::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    shared_ptr<anytime_astar_search::AnytimeAStarSearch> algorithm;
+    if (!parser.dry_run()) {
+        opts.verify_list_non_empty<int>("weights");
+        vector<int> weights = opts.get_list<int>("weights");
+        for (size_t i = 0; i < weights.size(); ++i) {
+            if (weights[i] < 1 || (i > 0 && weights[i] >= weights[i - 1])) {
+                parser.error(
+                    "anytime_astar needs positive, strictly decreasing "
+                    "weights");
+            }
+        }
+        algorithm =
+            make_shared<anytime_astar_search::AnytimeAStarSearch>(opts);
+    }
+    return algorithm;
+}
+
+static Plugin<SearchAlgorithm> _plugin("anytime_astar", _parse);
+} // namespace plugin_anytime_astar
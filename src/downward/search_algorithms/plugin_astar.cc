@@ -26,7 +26,7 @@ static shared_ptr<SearchAlgorithm> _parse(OptionParser& parser)
         "\n```\n--search astar(evaluator)\n```\n"
         "is equivalent to\n"
         "```\n--evaluator h=evaluator\n"
-        "--search eager(tiebreaking([sum([g(), h]), h], "
+        "--search eager(bucket_tiebreaking([sum([g(), h]), h], "
         "unsafe_pruning=false),\n"
         "               reopen_closed=true, f_eval=sum([g(), h]))\n"
         "```\n",
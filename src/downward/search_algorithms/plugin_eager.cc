@@ -0,0 +1,40 @@
+#include "downward/search_algorithms/eager_search.h"
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/open_list_factory.h"
+#include "downward/option_parser.h"
+#include "downward/plugin.h"
+
+using namespace std;
+
+namespace plugin_eager {
+static shared_ptr<SearchAlgorithm> _parse(OptionParser& parser)
+{
+    parser.document_synopsis("Eager best-first search", "");
+
+    parser.add_option<shared_ptr<OpenListFactory>>("open", "open list");
+    parser.add_option<bool>("reopen_closed", "reopen closed nodes", "false");
+    parser.add_option<shared_ptr<Evaluator>>(
+        "f_eval",
+        "set evaluator for jump statistics. "
+        "(Optional; if no evaluator is used, jump statistics will not be "
+        "displayed.)",
+        OptionParser::NONE);
+    parser.add_list_option<shared_ptr<Evaluator>>(
+        "preferred",
+        "use preferred operators of these evaluators",
+        "[]");
+
+    eager_search::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    shared_ptr<eager_search::EagerSearch> algorithm;
+    if (!parser.dry_run()) {
+        algorithm = make_shared<eager_search::EagerSearch>(opts);
+    }
+
+    return algorithm;
+}
+
+static Plugin<SearchAlgorithm> _plugin("eager", _parse);
+} // namespace plugin_eager
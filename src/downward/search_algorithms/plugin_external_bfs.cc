@@ -0,0 +1,42 @@
+#include "downward/search_algorithms/external_bfs_search.h"
+
+#include "downward/option_parser.h"
+#include "downward/plugin.h"
+
+using namespace std;
+
+namespace plugin_external_bfs {
+static shared_ptr<SearchAlgorithm> _parse(OptionParser& parser)
+{
+    parser.document_synopsis(
+        "External breadth-first search",
+        "Breadth-first search that stores its layers as sorted files of "
+        "packed states on disk and detects duplicates by merging them with "
+        "the previous layers (delayed duplicate detection). It can explore "
+        "state spaces that do not fit into memory, e.g., to prove that a "
+        "task is unsolvable or to compute the distances of all reachable "
+        "states.");
+    parser.document_note(
+        "Plans",
+        "The plan has the fewest operators among all plans, so it is "
+        "optimal for unit-cost tasks. Cost bounds are only supported for "
+        "unit-cost tasks.");
+    parser.document_note(
+        "Disk usage",
+        "All layers stay on disk until the search ends, since they are "
+        "needed to reconstruct the plan. Each state takes as many bytes as "
+        "a registered state, so state_encoding=mixed_radix can reduce the "
+        "disk usage and the amount of I/O.");
+
+    external_bfs_search::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    shared_ptr<external_bfs_search::ExternalBFSSearch> algorithm;
+    if (!parser.dry_run()) {
+        algorithm = make_shared<external_bfs_search::ExternalBFSSearch>(opts);
+    }
+    return algorithm;
+}
+
+static Plugin<SearchAlgorithm> _plugin("external_bfs", _parse);
+} // namespace plugin_external_bfs
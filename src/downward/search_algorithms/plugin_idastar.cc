@@ -0,0 +1,45 @@
+#include "downward/search_algorithms/idastar_search.h"
+
+#include "downward/option_parser.h"
+#include "downward/plugin.h"
+
+using namespace std;
+
+namespace plugin_idastar {
+static shared_ptr<SearchAlgorithm> _parse(OptionParser& parser)
+{
+    parser.document_synopsis(
+        "IDA* search",
+        "Iterative deepening A*: a series of depth-first searches bounded "
+        "by increasing f = g + h values. Memory use only depends on the "
+        "length of the current path and the size of the transposition "
+        "table, not on the number of states explored. With an admissible "
+        "heuristic, the plan is optimal.");
+    parser.document_note(
+        "Transposition table",
+        "Without a transposition table, the search only detects cycles on "
+        "the current path and may explore a state once for every path to "
+        "it. The transposition table prunes states that have already been "
+        "reached at most as expensively in the current iteration. Its "
+        "entries are identified by a 64-bit hash of the state, so in very "
+        "rare cases a hash collision can prune a state that has not been "
+        "seen before.");
+    parser.document_note(
+        "Evaluators",
+        "The evaluator is computed from scratch for every generated state, "
+        "since states are not registered and hence not cached. "
+        "Path-dependent evaluators are not supported.");
+    parser.add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+
+    idastar_search::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    shared_ptr<idastar_search::IDAStarSearch> algorithm;
+    if (!parser.dry_run()) {
+        algorithm = make_shared<idastar_search::IDAStarSearch>(opts);
+    }
+    return algorithm;
+}
+
+static Plugin<SearchAlgorithm> _plugin("idastar", _parse);
+} // namespace plugin_idastar
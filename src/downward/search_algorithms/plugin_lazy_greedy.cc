@@ -0,0 +1,55 @@
+#include "downward/search_algorithms/lazy_search.h"
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/option_parser.h"
+#include "downward/plugin.h"
+
+using namespace std;
+
+namespace plugin_lazy_greedy {
+static shared_ptr<SearchAlgorithm> _parse(OptionParser& parser)
+{
+    parser.document_synopsis(
+        "Greedy search (lazy)",
+        "Greedy best-first search with deferred evaluation: successors are "
+        "inserted into the open list with the evaluator values of their "
+        "parent and are only evaluated when they are expanded.");
+    parser.document_note(
+        "Open list",
+        "With a single evaluator and no preferred operator evaluators, the "
+        "open list is a tie-breaking open list on that evaluator. Otherwise, "
+        "it is an alternation open list with one queue for each evaluator "
+        "and, if preferred operator evaluators are given, one more queue for "
+        "each evaluator that only contains successors reached via preferred "
+        "operators. Whenever the search makes progress, the preferred-only "
+        "queues are boosted (see the boost option).");
+    parser.document_note(
+        "Preferred operators",
+        "Besides feeding the preferred-only queues, preferred operators "
+        "change the order in which successors are generated (see "
+        "preferred_successors_first).");
+    parser.add_list_option<shared_ptr<Evaluator>>("evals", "evaluators");
+    parser.add_list_option<shared_ptr<Evaluator>>(
+        "preferred",
+        "use preferred operators of these evaluators",
+        "[]");
+    parser.add_option<bool>("reopen_closed", "reopen closed nodes", "false");
+    parser.add_option<int>(
+        "boost",
+        "boost value for preferred operator open lists",
+        "1000");
+    SearchAlgorithm::add_succ_order_options(parser);
+    SearchAlgorithm::add_options_to_parser(parser);
+    Options opts = parser.parse();
+    opts.verify_list_non_empty<shared_ptr<Evaluator>>("evals");
+
+    shared_ptr<lazy_search::LazySearch> algorithm;
+    if (!parser.dry_run()) {
+        opts.set("open", search_common::create_greedy_open_list_factory(opts));
+        algorithm = make_shared<lazy_search::LazySearch>(opts);
+    }
+    return algorithm;
+}
+
+static Plugin<SearchAlgorithm> _plugin("lazy_greedy", _parse);
+} // namespace plugin_lazy_greedy
@@ -0,0 +1,91 @@
+#include "downward/search_algorithms/hda_search.h"
+
+#include "downward/evaluator.h"
+#include "downward/option_parser.h"
+#include "downward/plugin.h"
+
+#include <set>
+
+using namespace std;
+
+namespace plugin_parallel_astar {
+static shared_ptr<SearchAlgorithm> _parse(OptionParser& parser)
+{
+    parser.document_synopsis(
+        "Parallel A* search (HDA*)",
+        "Hash-distributed A* search. States are partitioned among worker "
+        "threads by a hash of their variable assignment. Every worker runs "
+        "A* on its own open list and forwards successors owned by other "
+        "workers via message queues. The search terminates once no worker "
+        "has an open node that can improve on the best solution found and no "
+        "message is in transit, so with an admissible heuristic the plan is "
+        "optimal. Closed nodes are re-opened.");
+    parser.document_note(
+        "Evaluators",
+        "Every worker thread uses its own instance of the evaluator, which "
+        "is created by parsing the evaluator specification once per thread. "
+        "Predefined evaluators cannot be shared between threads and are "
+        "therefore only supported with threads=1. Path-dependent evaluators "
+        "are not supported.");
+    parser.document_note(
+        "Differences to astar",
+        "The open list of every worker is the one of astar, ordered by f "
+        "and h of the given evaluator. There is no lazy_evaluator option: "
+        "lazy evaluators re-evaluate states whose estimates change during "
+        "the search, which only happens for path-dependent evaluators, and "
+        "the evaluator instances of the workers do not share their caches. "
+        "search_node_storage is not supported either, since the workers "
+        "keep their own per-state information instead of search nodes.");
+    parser.add_option<shared_ptr<Evaluator>>("eval", "evaluator for h-value");
+    parser.add_option<int>(
+        "threads",
+        "number of worker threads",
+        "1",
+        Bounds("1", "infinity"));
+
+    hda_search::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    shared_ptr<hda_search::HDASearch> algorithm;
+    if (!parser.dry_run()) {
+        int num_threads = opts.get<int>("threads");
+        vector<shared_ptr<Evaluator>> evaluators;
+        evaluators.push_back(opts.get<shared_ptr<Evaluator>>("eval"));
+        const options::ParseTree& eval_tree = opts.get_parse_tree("eval");
+        set<Evaluator*> instances = {evaluators.front().get()};
+        for (int i = 1; i < num_threads; ++i) {
+            // Keep the evaluator IDs of each thread small.
+            EvaluatorIdScope id_scope;
+            OptionParser eval_parser(
+                eval_tree,
+                parser.get_registry(),
+                parser.get_predefinitions(),
+                false);
+            evaluators.push_back(
+                eval_parser.start_parsing<shared_ptr<Evaluator>>());
+            if (!instances.insert(evaluators.back().get()).second) {
+                parser.error(
+                    "parallel_astar needs a separate evaluator per thread; "
+                    "do not use predefined evaluators with threads > 1");
+            }
+        }
+        algorithm = make_shared<hda_search::HDASearch>(
+            opts.get<shared_ptr<ClassicalTask>>("transform"),
+            utils::get_log_from_options(opts),
+            opts.get<OperatorCost>("cost_type"),
+            opts.get<double>("max_time"),
+            opts.get<int>("bound"),
+            evaluators,
+            opts.get<StateStorage>("state_storage"),
+            opts.get<string>("state_storage_directory"),
+            opts.get<int_packer::Encoding>("state_encoding"),
+            opts.get<successor_generator::Representation>(
+                "successor_generator"));
+        algorithm->read_statistics_options(opts);
+    }
+
+    return algorithm;
+}
+
+static Plugin<SearchAlgorithm> _plugin("parallel_astar", _parse);
+} // namespace plugin_parallel_astar
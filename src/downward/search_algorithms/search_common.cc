@@ -6,6 +6,8 @@
 #include "downward/evaluators/g_evaluator.h"
 #include "downward/evaluators/sum_evaluator.h"
 
+#include "downward/open_lists/alternation_open_list.h"
+#include "downward/open_lists/bucket_tiebreaking_open_list.h"
 #include "downward/open_lists/tiebreaking_open_list.h"
 
 #include <memory>
@@ -45,8 +47,49 @@ create_astar_open_list_factory_and_f_eval(
     options.set("evals", evals);
     options.set("pref_only", false);
     options.set("unsafe_pruning", false);
-    shared_ptr<OpenListFactory> open =
-        make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(options);
+    shared_ptr<OpenListFactory> open = make_shared<
+        bucket_tiebreaking_open_list::BucketTieBreakingOpenListFactory>(
+        options);
     return make_pair(open, f);
 }
+
+static shared_ptr<OpenListFactory> create_standard_scalar_open_list_factory(
+    const shared_ptr<Evaluator>& eval,
+    bool pref_only)
+{
+    Options options;
+    options.set("evals", vector<shared_ptr<Evaluator>>({eval}));
+    options.set("pref_only", pref_only);
+    options.set("unsafe_pruning", false);
+    return make_shared<tiebreaking_open_list::TieBreakingOpenListFactory>(
+        options);
+}
+
+shared_ptr<OpenListFactory>
+create_greedy_open_list_factory(const Options& opts)
+{
+    vector<shared_ptr<Evaluator>> evals =
+        opts.get_list<shared_ptr<Evaluator>>("evals");
+    vector<shared_ptr<Evaluator>> preferred_evaluators =
+        opts.get_list<shared_ptr<Evaluator>>("preferred");
+    if (evals.size() == 1 && preferred_evaluators.empty()) {
+        return create_standard_scalar_open_list_factory(evals[0], false);
+    }
+
+    vector<shared_ptr<OpenListFactory>> subfactories;
+    for (const shared_ptr<Evaluator>& evaluator : evals) {
+        subfactories.push_back(
+            create_standard_scalar_open_list_factory(evaluator, false));
+        if (!preferred_evaluators.empty()) {
+            subfactories.push_back(
+                create_standard_scalar_open_list_factory(evaluator, true));
+        }
+    }
+
+    Options options;
+    options.set("sublists", subfactories);
+    options.set("boost", opts.get<int>("boost"));
+    return make_shared<alternation_open_list::AlternationOpenListFactory>(
+        options);
+}
 } // namespace search_common
@@ -20,18 +20,16 @@ bool SearchProgress::process_evaluator_value(
       2. return true if this is a new lowest value
          (includes case where we haven't seen this evaluator before)
     */
-    auto insert_result = min_values.insert(make_pair(evaluator, value));
-    auto iter = insert_result.first;
-    bool was_inserted = insert_result.second;
-    if (was_inserted) {
-        // We haven't seen this evaluator before.
+    int id = evaluator->get_id();
+    if (id >= static_cast<int>(min_values.size())) {
+        min_values.resize(id + 1);
+    }
+    MinValue& min_value = min_values[id];
+    if (min_value.serial != evaluator->get_serial() ||
+        value < min_value.value) {
+        min_value.serial = evaluator->get_serial();
+        min_value.value = value;
         return true;
-    } else {
-        int& min_value = iter->second;
-        if (value < min_value) {
-            min_value = value;
-            return true;
-        }
     }
     return false;
 }
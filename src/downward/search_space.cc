@@ -3,20 +3,59 @@
 #include "downward/search_node_info.h"
 #include "downward/task_proxy.h"
 
+#include "downward/task_utils/successor_generator.h"
 #include "downward/task_utils/task_properties.h"
 #include "downward/utils/logging.h"
 
+#include <algorithm>
 #include <cassert>
+#include <limits>
 
 using namespace std;
 
 SearchNode::SearchNode(const State& state, SearchNodeInfo& info)
     : state(state)
-    , info(info)
+    , info(&info)
 {
     assert(state.get_id() != StateID::no_state);
 }
 
+SearchNode::SearchNode(const State& state, const CompactSearchNodeRef& compact)
+    : state(state)
+    , info(nullptr)
+    , compact(compact)
+{
+    assert(state.get_id() != StateID::no_state);
+}
+
+void SearchNode::set_status(SearchNodeInfo::NodeStatus status)
+{
+    if (info)
+        info->status = status;
+    else
+        *compact.status = status;
+}
+
+void SearchNode::set_path(
+    const SearchNode& parent_node,
+    const OperatorProxy& parent_op,
+    int adjusted_cost)
+{
+    int g = parent_node.get_g() + adjusted_cost;
+    int real_g = parent_node.get_real_g() + parent_op.get_cost();
+    StateID parent_id = parent_node.get_state().get_id();
+    if (info) {
+        info->g = g;
+        info->real_g = real_g;
+        info->parent_state_id = parent_id;
+        info->creating_operator = OperatorID(parent_op.get_id());
+    } else {
+        *compact.g = g;
+        if (compact.real_g) *compact.real_g = real_g;
+        *compact.parent_state_id = parent_id;
+    }
+}
+
 const State& SearchNode::get_state() const
 {
     return state;
@@ -24,43 +63,51 @@ const State& SearchNode::get_state() const
 
 bool SearchNode::is_open() const
 {
-    return info.status == SearchNodeInfo::OPEN;
+    return get_status() == SearchNodeInfo::OPEN;
 }
 
 bool SearchNode::is_closed() const
 {
-    return info.status == SearchNodeInfo::CLOSED;
+    return get_status() == SearchNodeInfo::CLOSED;
 }
 
 bool SearchNode::is_dead_end() const
 {
-    return info.status == SearchNodeInfo::DEAD_END;
+    return get_status() == SearchNodeInfo::DEAD_END;
 }
 
 bool SearchNode::is_new() const
 {
-    return info.status == SearchNodeInfo::NEW;
+    return get_status() == SearchNodeInfo::NEW;
 }
 
 int SearchNode::get_g() const
 {
-    assert(info.g >= 0);
-    return info.g;
+    int g = info ? info->g : *compact.g;
+    assert(g >= 0);
+    return g;
 }
 
 int SearchNode::get_real_g() const
 {
-    return info.real_g;
+    if (info) return info->real_g;
+    return compact.real_g ? *compact.real_g : *compact.g;
 }
 
 void SearchNode::open_initial()
 {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = 0;
-    info.real_g = 0;
-    info.parent_state_id = StateID::no_state;
-    info.creating_operator = OperatorID::no_operator;
+    assert(get_status() == SearchNodeInfo::NEW);
+    set_status(SearchNodeInfo::OPEN);
+    if (info) {
+        info->g = 0;
+        info->real_g = 0;
+        info->parent_state_id = StateID::no_state;
+        info->creating_operator = OperatorID::no_operator;
+    } else {
+        *compact.g = 0;
+        if (compact.real_g) *compact.real_g = 0;
+        *compact.parent_state_id = StateID::no_state;
+    }
 }
 
 void SearchNode::open(
@@ -68,20 +115,17 @@ void SearchNode::open(
     const OperatorProxy& parent_op,
     int adjusted_cost)
 {
-    assert(info.status == SearchNodeInfo::NEW);
-    info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    assert(get_status() == SearchNodeInfo::NEW);
+    set_status(SearchNodeInfo::OPEN);
+    set_path(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::reopen()
 {
     assert(
-        info.status == SearchNodeInfo::OPEN ||
-        info.status == SearchNodeInfo::CLOSED);
-    info.status = SearchNodeInfo::OPEN;
+        get_status() == SearchNodeInfo::OPEN ||
+        get_status() == SearchNodeInfo::CLOSED);
+    set_status(SearchNodeInfo::OPEN);
 }
 
 void SearchNode::reopen(
@@ -90,16 +134,13 @@ void SearchNode::reopen(
     int adjusted_cost)
 {
     assert(
-        info.status == SearchNodeInfo::OPEN ||
-        info.status == SearchNodeInfo::CLOSED);
+        get_status() == SearchNodeInfo::OPEN ||
+        get_status() == SearchNodeInfo::CLOSED);
 
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.status = SearchNodeInfo::OPEN;
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_status(SearchNodeInfo::OPEN);
+    set_path(parent_node, parent_op, adjusted_cost);
 }
 
 // like reopen, except doesn't change status
@@ -109,25 +150,22 @@ void SearchNode::update_parent(
     int adjusted_cost)
 {
     assert(
-        info.status == SearchNodeInfo::OPEN ||
-        info.status == SearchNodeInfo::CLOSED);
+        get_status() == SearchNodeInfo::OPEN ||
+        get_status() == SearchNodeInfo::CLOSED);
     // The latter possibility is for inconsistent heuristics, which
     // may require reopening closed nodes.
-    info.g = parent_node.info.g + adjusted_cost;
-    info.real_g = parent_node.info.real_g + parent_op.get_cost();
-    info.parent_state_id = parent_node.get_state().get_id();
-    info.creating_operator = OperatorID(parent_op.get_id());
+    set_path(parent_node, parent_op, adjusted_cost);
 }
 
 void SearchNode::close()
 {
-    assert(info.status == SearchNodeInfo::OPEN);
-    info.status = SearchNodeInfo::CLOSED;
+    assert(get_status() == SearchNodeInfo::OPEN);
+    set_status(SearchNodeInfo::CLOSED);
 }
 
 void SearchNode::mark_as_dead_end()
 {
-    info.status = SearchNodeInfo::DEAD_END;
+    set_status(SearchNodeInfo::DEAD_END);
 }
 
 void SearchNode::dump(
@@ -137,26 +175,121 @@ void SearchNode::dump(
     if (log.is_at_least_debug()) {
         log << state.get_id() << ": ";
         task_properties::dump_fdr(state);
-        if (info.creating_operator != OperatorID::no_operator) {
-            OperatorsProxy operators = task_proxy.get_operators();
-            OperatorProxy op = operators[info.creating_operator.get_index()];
-            log << " created by " << op.get_name() << " from "
-                << info.parent_state_id << endl;
+        StateID parent_id =
+            info ? info->parent_state_id : *compact.parent_state_id;
+        if (parent_id != StateID::no_state) {
+            log << " created";
+            if (info) {
+                OperatorsProxy operators = task_proxy.get_operators();
+                OperatorProxy op =
+                    operators[info->creating_operator.get_index()];
+                log << " by " << op.get_name();
+            }
+            log << " from " << parent_id << endl;
         } else {
             log << " no parent" << endl;
         }
     }
 }
 
-SearchSpace::SearchSpace(StateRegistry& state_registry, utils::LogProxy& log)
-    : state_registry(state_registry)
+SearchSpace::SearchSpace(
+    StateRegistry& state_registry,
+    const successor_generator::SuccessorGenerator& successor_generator,
+    utils::LogProxy& log,
+    SearchNodeStorage storage,
+    OperatorCost cost_type)
+    : storage(storage)
+    , store_real_g(cost_type != NORMAL)
+    , node_statuses(SearchNodeInfo::NEW)
+    , node_g_values(-1)
+    , node_parents(StateID::no_state)
+    , node_real_g_values(-1)
+    , state_registry(state_registry)
+    , successor_generator(successor_generator)
     , log(log)
 {
 }
 
 SearchNode SearchSpace::get_node(const State& state)
 {
-    return SearchNode(state, search_node_infos[state]);
+    if (storage == SearchNodeStorage::STRUCT) {
+        return SearchNode(state, search_node_infos[state]);
+    }
+    CompactSearchNodeRef compact;
+    compact.status = &node_statuses[state];
+    compact.g = &node_g_values[state];
+    compact.parent_state_id = &node_parents[state];
+    if (store_real_g) compact.real_g = &node_real_g_values[state];
+    return SearchNode(state, compact);
+}
+
+StateID SearchSpace::get_parent_id(const State& state) const
+{
+    if (storage == SearchNodeStorage::STRUCT) {
+        return search_node_infos[state].parent_state_id;
+    }
+    return node_parents[state];
+}
+
+OperatorID SearchSpace::get_creating_operator(const State& state) const
+{
+    if (storage == SearchNodeStorage::STRUCT) {
+        return search_node_infos[state].creating_operator;
+    }
+    StateID parent_id = node_parents[state];
+    if (parent_id == StateID::no_state) return OperatorID::no_operator;
+    return recompute_creating_operator(
+        state_registry.lookup_state(parent_id),
+        state);
+}
+
+/*
+  Find an operator that leads from parent to child. If there are several, we
+  use a cheapest one, so the cost of a traced path is never higher than the
+  cost of the path that was actually generated.
+
+  An applicable operator leads to the child iff the child agrees with all of
+  its effects and every variable on which parent and child differ is set by
+  one of its effects, so each candidate only costs time linear in the number
+  of its effects.
+*/
+OperatorID SearchSpace::recompute_creating_operator(
+    const State& parent,
+    const State& child) const
+{
+    ClassicalTaskProxy task_proxy(state_registry.get_task_proxy());
+    const vector<int>& parent_values = parent.get_unpacked_values();
+    const vector<int>& child_values = child.get_unpacked_values();
+    int num_changed_vars = 0;
+    for (size_t var = 0; var < parent_values.size(); ++var) {
+        if (parent_values[var] != child_values[var]) ++num_changed_vars;
+    }
+
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(parent, applicable_ops);
+    OperatorsProxy operators = task_proxy.get_operators();
+    OperatorID best_op = OperatorID::no_operator;
+    int best_cost = numeric_limits<int>::max();
+    for (OperatorID op_id : applicable_ops) {
+        OperatorProxy op = operators[op_id];
+        if (op.get_cost() >= best_cost) continue;
+        bool leads_to_child = true;
+        int num_changing_effects = 0;
+        for (FactProxy effect : op.get_effect()) {
+            FactPair fact = effect.get_pair();
+            if (child_values[fact.var] != fact.value) {
+                leads_to_child = false;
+                break;
+            }
+            if (parent_values[fact.var] != fact.value) ++num_changing_effects;
+        }
+        if (leads_to_child && num_changing_effects == num_changed_vars) {
+            best_op = op_id;
+            best_cost = op.get_cost();
+        }
+    }
+    assert(best_op != OperatorID::no_operator);
+    return best_op;
 }
 
 void SearchSpace::trace_path(const State& goal_state, vector<OperatorID>& path)
@@ -166,13 +299,15 @@ void SearchSpace::trace_path(const State& goal_state, vector<OperatorID>& path)
     assert(current_state.get_registry() == &state_registry);
     assert(path.empty());
     for (;;) {
-        const SearchNodeInfo& info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
+        StateID parent_id = get_parent_id(current_state);
+        if (parent_id == StateID::no_state) {
+            assert(
+                get_creating_operator(current_state) ==
+                OperatorID::no_operator);
             break;
         }
-        path.push_back(info.creating_operator);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        path.push_back(get_creating_operator(current_state));
+        current_state = state_registry.lookup_state(parent_id);
     }
     reverse(path.begin(), path.end());
 }
@@ -186,13 +321,10 @@ void SearchSpace::trace_path(
     assert(trajectory.empty());
     trajectory.push_back(goal_state.get_id());
     for (;;) {
-        const SearchNodeInfo& info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
-            break;
-        }
-        trajectory.push_back(info.parent_state_id);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        StateID parent_id = get_parent_id(current_state);
+        if (parent_id == StateID::no_state) break;
+        trajectory.push_back(parent_id);
+        current_state = state_registry.lookup_state(parent_id);
     }
     reverse(trajectory.begin(), trajectory.end());
 }
@@ -208,19 +340,26 @@ void SearchSpace::trace_path(
     assert(trajectory.empty());
     trajectory.push_back(goal_state.get_id());
     for (;;) {
-        const SearchNodeInfo& info = search_node_infos[current_state];
-        if (info.creating_operator == OperatorID::no_operator) {
-            assert(info.parent_state_id == StateID::no_state);
-            break;
-        }
-        path.push_back(info.creating_operator);
-        trajectory.push_back(info.parent_state_id);
-        current_state = state_registry.lookup_state(info.parent_state_id);
+        StateID parent_id = get_parent_id(current_state);
+        if (parent_id == StateID::no_state) break;
+        path.push_back(get_creating_operator(current_state));
+        trajectory.push_back(parent_id);
+        current_state = state_registry.lookup_state(parent_id);
     }
     reverse(path.begin(), path.end());
     reverse(trajectory.begin(), trajectory.end());
 }
 
+int SearchSpace::get_node_size_in_bytes() const
+{
+    if (storage == SearchNodeStorage::STRUCT) {
+        return sizeof(SearchNodeInfo);
+    }
+    int size = sizeof(uint8_t) + sizeof(int) + sizeof(StateID);
+    if (store_real_g) size += sizeof(int);
+    return size;
+}
+
 void SearchSpace::dump(const ClassicalTaskProxy& task_proxy) const
 {
     OperatorsProxy operators = task_proxy.get_operators();
@@ -228,15 +367,14 @@ void SearchSpace::dump(const ClassicalTaskProxy& task_proxy) const
         /* The body duplicates SearchNode::dump() but we cannot create
            a search node without discarding the const qualifier. */
         State state = state_registry.lookup_state(id);
-        const SearchNodeInfo& node_info = search_node_infos[state];
+        StateID parent_id = get_parent_id(state);
         log << id << ": ";
         task_properties::dump_fdr(state);
-        if (node_info.creating_operator != OperatorID::no_operator &&
-            node_info.parent_state_id != StateID::no_state) {
+        if (parent_id != StateID::no_state) {
             OperatorProxy op =
-                operators[node_info.creating_operator.get_index()];
-            log << " created by " << op.get_name() << " from "
-                << node_info.parent_state_id << endl;
+                operators[get_creating_operator(state).get_index()];
+            log << " created by " << op.get_name() << " from " << parent_id
+                << endl;
         } else {
             log << "has no parent" << endl;
         }
@@ -246,4 +384,10 @@ void SearchSpace::dump(const ClassicalTaskProxy& task_proxy) const
 void SearchSpace::print_statistics() const
 {
     state_registry.print_statistics(log);
+    log << "Search node storage: "
+        << (storage == SearchNodeStorage::STRUCT ? "struct" : "compact")
+        << ", " << get_node_size_in_bytes() << " bytes per node" << endl;
+    log << "Search node memory: "
+        << state_registry.size() * get_node_size_in_bytes() / 1024 << " KB"
+        << endl;
 }
@@ -1,10 +1,15 @@
 #include "downward/search_statistics.h"
 
+#include "downward/evaluator.h"
+
+#include "downward/utils/json.h"
 #include "downward/utils/logging.h"
 #include "downward/utils/system.h"
 #include "downward/utils/timer.h"
 
+#include <algorithm>
 #include <iostream>
+#include <numeric>
 
 using namespace std;
 
@@ -25,6 +30,8 @@ SearchStatistics::SearchStatistics(utils::LogProxy& log)
     lastjump_generated_states = 0;
 
     lastjump_f_value = -1;
+
+    time_evaluators = false;
 }
 
 void SearchStatistics::report_f_value_progress(int f)
@@ -36,6 +43,13 @@ void SearchStatistics::report_f_value_progress(int f)
         lastjump_reopened_states = reopened_states;
         lastjump_evaluated_states = evaluated_states;
         lastjump_generated_states = generated_states;
+        f_layers.push_back(
+            {f,
+             expanded_states,
+             evaluated_states,
+             generated_states,
+             reopened_states,
+             utils::g_timer()});
     }
 }
 
@@ -57,6 +71,126 @@ void SearchStatistics::print_checkpoint_line(int g) const
     }
 }
 
+void SearchStatistics::report_thread_expansions(const vector<int>& expansions)
+{
+    thread_expansions = expansions;
+}
+
+void SearchStatistics::report_evaluator_call(
+    const Evaluator* evaluator,
+    double seconds)
+{
+    // There are only a few evaluators, so a linear search is fast enough.
+    for (EvaluatorStatistics& entry : evaluator_statistics) {
+        if (entry.evaluator == evaluator) {
+            ++entry.calls;
+            entry.time += seconds;
+            return;
+        }
+    }
+    evaluator_statistics.push_back(
+        {evaluator, evaluator->get_description(), 1, seconds});
+}
+
+SearchStatistics::FLayer SearchStatistics::get_f_layer(int f) const
+{
+    for (const FLayer& layer : f_layers) {
+        if (layer.f_value >= f) return layer;
+    }
+    return {
+        f,
+        expanded_states,
+        evaluated_states,
+        generated_states,
+        reopened_states,
+        0.0};
+}
+
+void SearchStatistics::merge(const SearchStatistics& other)
+{
+    vector<int> f_values;
+    for (const FLayer& layer : f_layers) f_values.push_back(layer.f_value);
+    for (const FLayer& layer : other.f_layers) {
+        f_values.push_back(layer.f_value);
+    }
+    sort(f_values.begin(), f_values.end());
+    f_values.erase(unique(f_values.begin(), f_values.end()), f_values.end());
+
+    vector<FLayer> merged_layers;
+    for (int f : f_values) {
+        FLayer lhs = get_f_layer(f);
+        FLayer rhs = other.get_f_layer(f);
+        merged_layers.push_back(
+            {f,
+             lhs.expanded_states + rhs.expanded_states,
+             lhs.evaluated_states + rhs.evaluated_states,
+             lhs.generated_states + rhs.generated_states,
+             lhs.reopened_states + rhs.reopened_states,
+             max(lhs.time, rhs.time)});
+    }
+    f_layers = std::move(merged_layers);
+    if (!f_layers.empty()) {
+        const FLayer& last = f_layers.back();
+        lastjump_f_value = last.f_value;
+        lastjump_expanded_states = last.expanded_states;
+        lastjump_reopened_states = last.reopened_states;
+        lastjump_evaluated_states = last.evaluated_states;
+        lastjump_generated_states = last.generated_states;
+    }
+
+    expanded_states += other.expanded_states;
+    evaluated_states += other.evaluated_states;
+    evaluations += other.evaluations;
+    generated_states += other.generated_states;
+    reopened_states += other.reopened_states;
+    dead_end_states += other.dead_end_states;
+    generated_ops += other.generated_ops;
+
+    /*
+      Several evaluators can have the same description (e.g., the g and f
+      evaluators of A*), so the i-th entry with a description is matched
+      with the i-th entry with that description.
+    */
+    vector<bool> matched(evaluator_statistics.size(), false);
+    for (const EvaluatorStatistics& other_entry : other.evaluator_statistics) {
+        size_t i = 0;
+        while (i < evaluator_statistics.size() &&
+               (matched[i] ||
+                evaluator_statistics[i].description != other_entry.description))
+            ++i;
+        if (i == evaluator_statistics.size()) {
+            evaluator_statistics.push_back(other_entry);
+            matched.push_back(true);
+        } else {
+            evaluator_statistics[i].calls += other_entry.calls;
+            evaluator_statistics[i].time += other_entry.time;
+            matched[i] = true;
+        }
+    }
+}
+
+double SearchStatistics::get_load_imbalance() const
+{
+    if (thread_expansions.empty()) return 1.0;
+    double total =
+        accumulate(thread_expansions.begin(), thread_expansions.end(), 0.0);
+    if (total == 0) return 1.0;
+    double mean = total / thread_expansions.size();
+    return *max_element(thread_expansions.begin(), thread_expansions.end()) /
+           mean;
+}
+
+void SearchStatistics::print_thread_statistics() const
+{
+    log << "Expanded per thread:";
+    for (int expansions : thread_expansions) {
+        log << " " << expansions;
+    }
+    log << endl;
+    log << "Load imbalance (max/mean expansions): " << get_load_imbalance()
+        << endl;
+}
+
 void SearchStatistics::print_basic_statistics() const
 {
     log << evaluated_states << " evaluated, " << expanded_states << " expanded";
@@ -84,4 +218,85 @@ void SearchStatistics::print_detailed_statistics() const
         log << "Generated until last jump: " << lastjump_generated_states
             << " state(s)." << endl;
     }
+
+    if (!thread_expansions.empty()) {
+        print_thread_statistics();
+    }
+}
+
+void SearchStatistics::write_json(utils::JsonWriter& json) const
+{
+    json.key("expanded");
+    json.value(expanded_states);
+    json.key("reopened");
+    json.value(reopened_states);
+    json.key("evaluated");
+    json.value(evaluated_states);
+    json.key("evaluations");
+    json.value(evaluations);
+    json.key("generated");
+    json.value(generated_states);
+    json.key("generated_ops");
+    json.value(generated_ops);
+    json.key("dead_ends");
+    json.value(dead_end_states);
+
+    if (lastjump_f_value >= 0) {
+        json.key("last_jump");
+        json.begin_object();
+        json.key("f");
+        json.value(lastjump_f_value);
+        json.key("expanded");
+        json.value(lastjump_expanded_states);
+        json.key("reopened");
+        json.value(lastjump_reopened_states);
+        json.key("evaluated");
+        json.value(lastjump_evaluated_states);
+        json.key("generated");
+        json.value(lastjump_generated_states);
+        json.end_object();
+    }
+
+    json.key("evaluators");
+    json.begin_array();
+    for (const EvaluatorStatistics& entry : evaluator_statistics) {
+        json.begin_object();
+        json.key("description");
+        json.value(entry.description);
+        json.key("calls");
+        json.value(entry.calls);
+        json.key("time");
+        json.value(entry.time);
+        json.end_object();
+    }
+    json.end_array();
+
+    json.key("f_layers");
+    json.begin_array();
+    for (const FLayer& layer : f_layers) {
+        json.begin_object();
+        json.key("f");
+        json.value(layer.f_value);
+        json.key("expanded");
+        json.value(layer.expanded_states);
+        json.key("evaluated");
+        json.value(layer.evaluated_states);
+        json.key("generated");
+        json.value(layer.generated_states);
+        json.key("reopened");
+        json.value(layer.reopened_states);
+        json.key("time");
+        json.value(layer.time);
+        json.end_object();
+    }
+    json.end_array();
+
+    if (!thread_expansions.empty()) {
+        json.key("thread_expansions");
+        json.begin_array();
+        for (int expansions : thread_expansions) json.value(expansions);
+        json.end_array();
+        json.key("load_imbalance");
+        json.value(get_load_imbalance());
+    }
 }
@@ -8,17 +8,43 @@
 
 #include "probfd/task_proxy.h"
 
+#include <random>
+
 using namespace std;
 
 StateRegistry::StateRegistry(const PlanningTaskProxy& task_proxy)
+    : StateRegistry(task_proxy, nullptr)
+{
+}
+
+StateRegistry::StateRegistry(
+    const PlanningTaskProxy& task_proxy,
+    shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory,
+    int_packer::Encoding state_encoding)
     : task_proxy(task_proxy)
-    , state_packer(task_properties::g_state_packers[task_proxy])
+    , state_packer(
+          task_properties::get_state_packer(task_proxy, state_encoding))
     , num_variables(task_proxy.get_variables().size())
-    , state_data_pool(get_bins_per_state())
+    , mapped_memory(std::move(mapped_memory))
+    , state_data_pool(
+          get_bins_per_state(),
+          mapped_segment_allocator::SegmentAllocator<PackedStateBin>(
+              this->mapped_memory))
+    , state_hash_pool(
+          mapped_segment_allocator::SegmentAllocator<uint64_t>(
+              this->mapped_memory))
     , registered_states(
-          StateIDSemanticHash(state_data_pool, get_bins_per_state()),
+          StateIDSemanticHash(state_hash_pool),
           StateIDSemanticEqual(state_data_pool, get_bins_per_state()))
 {
+    // A fixed seed makes hashes, and hence the search, deterministic.
+    mt19937_64 rng(2011);
+    for (VariableProxy var : task_proxy.get_variables()) {
+        zobrist_offsets.push_back(zobrist_keys.size());
+        for (int value = 0; value < var.get_domain_size(); ++value) {
+            zobrist_keys.push_back(rng());
+        }
+    }
 }
 
 StateID StateRegistry::insert_id_or_pop_state()
@@ -33,52 +59,85 @@ StateID StateRegistry::insert_id_or_pop_state()
     pair<int, bool> result = registered_states.insert(id.value);
     bool is_new_entry = result.second;
     if (!is_new_entry) {
-        state_data_pool.pop_back();
+        pop_state();
     }
     assert(
         registered_states.size() == static_cast<int>(state_data_pool.size()));
     return StateID(result.first);
 }
 
+void StateRegistry::pop_state()
+{
+    state_data_pool.pop_back();
+    state_hash_pool.pop_back();
+}
+
 State StateRegistry::lookup_state(StateID id) const
 {
     const PackedStateBin* buffer = state_data_pool[id.value];
     return task_proxy.create_state(*this, id, buffer);
 }
 
+PackedStateBin* StateRegistry::push_packed_state(span<const int> values)
+{
+    assert(values.size() == static_cast<size_t>(num_variables));
+    // Avoid garbage values in half-full bins.
+    PackedStateBin* buffer = state_data_pool.push_back_filled(0);
+    uint64_t hash = 0;
+    for (int var = 0; var < num_variables; ++var) {
+        state_packer.set(buffer, var, values[var]);
+        hash ^= get_zobrist_key(var, values[var]);
+    }
+    state_hash_pool.push_back(hash);
+    return buffer;
+}
+
 const State& StateRegistry::get_initial_state()
 {
     if (!cached_initial_state) {
-        int num_bins = get_bins_per_state();
-        unique_ptr<PackedStateBin[]> buffer(new PackedStateBin[num_bins]);
-        // Avoid garbage values in half-full bins.
-        fill_n(buffer.get(), num_bins, 0);
-
-        State initial_state = task_proxy.get_initial_state();
-        for (size_t i = 0; i < initial_state.size(); ++i) {
-            state_packer.set(buffer.get(), i, initial_state[i].get_value());
-        }
-        state_data_pool.push_back(buffer.get());
+        vector<int> values =
+            task_proxy.get_initial_state().get_unpacked_values();
+        push_packed_state(values);
         StateID id = insert_id_or_pop_state();
-        cached_initial_state = std::make_unique<State>(lookup_state(id));
+        cached_initial_state = std::make_unique<State>(task_proxy.create_state(
+            *this,
+            id,
+            state_data_pool[id.value],
+            std::move(values)));
     }
     return *cached_initial_state;
 }
 
 State StateRegistry::insert_state(std::vector<int>&& state)
 {
-    int num_bins = get_bins_per_state();
-    unique_ptr<PackedStateBin[]> buffer(new PackedStateBin[num_bins]);
-    // Avoid garbage values in half-full bins.
-    fill_n(buffer.get(), num_bins, 0);
+    push_packed_state(state);
+    StateID id = insert_id_or_pop_state();
+    return task_proxy.create_state(
+        *this,
+        id,
+        state_data_pool[id.value],
+        std::move(state));
+}
 
-    for (size_t i = 0; i < state.size(); ++i) {
-        state_packer.set(buffer.get(), i, state[i]);
+vector<StateID>
+StateRegistry::insert_states(span<const int> values, size_t count)
+{
+    assert(values.size() == count * num_variables);
+    vector<StateID> ids;
+    ids.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        push_packed_state(values.subspan(i * num_variables, num_variables));
+        ids.push_back(insert_id_or_pop_state());
     }
-    state_data_pool.push_back(buffer.get());
-    // buffer is copied by push_back
-    StateID id = insert_id_or_pop_state();
-    return lookup_state(id);
+    return ids;
+}
+
+StateID StateRegistry::find_state_id(span<const int> values)
+{
+    push_packed_state(values);
+    int key = registered_states.find(state_data_pool.size() - 1);
+    pop_state();
+    return key == -1 ? StateID::no_state : StateID(key);
 }
 
 int StateRegistry::get_bins_per_state() const
@@ -95,4 +154,10 @@ void StateRegistry::print_statistics(utils::LogProxy& log) const
 {
     log << "Number of registered states: " << size() << endl;
     registered_states.print_statistics(log);
+    if (mapped_memory) {
+        log << "State storage: mapped, "
+            << mapped_memory->get_resident_bytes() / 1024 << " KB resident of "
+            << mapped_memory->get_mapped_bytes() / 1024 << " KB mapped"
+            << endl;
+    }
 }
@@ -0,0 +1,55 @@
+#include "downward/task_utils/compiled_task.h"
+
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+using namespace std;
+
+namespace compiled_task {
+CompiledTask::CompiledTask(const ClassicalTaskProxy& task_proxy)
+    : num_facts(0)
+    , unit_cost(task_properties::is_unit_cost(task_proxy))
+{
+    for (VariableProxy var : task_proxy.get_variables()) {
+        domain_sizes.push_back(var.get_domain_size());
+        fact_offsets.push_back(num_facts);
+        num_facts += var.get_domain_size();
+    }
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    int num_operators = operators.size();
+    precondition_offsets.reserve(num_operators + 1);
+    effect_offsets.reserve(num_operators + 1);
+    for (OperatorProxy op : operators) {
+        precondition_offsets.push_back(preconditions.size());
+        for (FactProxy pre : op.get_precondition())
+            preconditions.push_back(pre.get_pair());
+        effect_offsets.push_back(effects.size());
+        for (FactProxy eff : op.get_effect())
+            effects.push_back(eff.get_pair());
+    }
+    precondition_offsets.push_back(preconditions.size());
+    effect_offsets.push_back(effects.size());
+
+    adjusted_costs.resize(MAX_OPERATOR_COST * num_operators);
+    for (int cost_type = 0; cost_type < MAX_OPERATOR_COST; ++cost_type) {
+        for (OperatorProxy op : operators) {
+            adjusted_costs[cost_type * num_operators + op.get_id()] =
+                get_adjusted_action_cost(
+                    op,
+                    static_cast<OperatorCost>(cost_type),
+                    unit_cost);
+        }
+    }
+
+    for (FactProxy goal : task_proxy.get_goal())
+        goals.push_back(goal.get_pair());
+}
+
+PerTaskInformation<CompiledTask>
+    g_compiled_tasks([](const PlanningTaskProxy& task_proxy) {
+        return make_unique<CompiledTask>(
+            static_cast<ClassicalTaskProxy>(task_proxy));
+    });
+} // namespace compiled_task
@@ -6,12 +6,62 @@
 #include "downward/planning_task.h"
 #include "downward/state.h"
 
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
 using namespace std;
 
 namespace successor_generator {
-SuccessorGenerator::SuccessorGenerator(const PlanningTaskProxy& task_proxy)
-    : root(SuccessorGeneratorFactory(task_proxy).create())
+/*
+  Estimated time of a row access of GeneratorBitset relative to a node
+  visit of the tree, measured on the tasks in domains/.
+*/
+static const double BITSET_ROW_ACCESS_COST = 0.5;
+
+static bool is_bitset_faster(
+    const PlanningTaskProxy& task_proxy,
+    const GeneratorBase& tree,
+    const GeneratorBitset& bitset)
+{
+    vector<int> domain_sizes;
+    for (VariableProxy var : task_proxy.get_variables())
+        domain_sizes.push_back(var.get_domain_size());
+    double tree_cost = tree.get_expected_num_visits(domain_sizes);
+    double bitset_cost =
+        BITSET_ROW_ACCESS_COST * bitset.get_num_row_accesses();
+    return bitset_cost < tree_cost;
+}
+
+SuccessorGenerator::SuccessorGenerator(
+    const PlanningTaskProxy& task_proxy,
+    Representation representation)
 {
+    if (representation == Representation::BITSET) {
+        bitset = make_unique<GeneratorBitset>(task_proxy);
+        return;
+    }
+    root = SuccessorGeneratorFactory(task_proxy).create();
+    if (representation == Representation::BYTE_CODE) {
+        byte_code = make_unique<GeneratorByteCode>(*root);
+        root.reset();
+    } else if (representation == Representation::AUTOMATIC) {
+        auto candidate = make_unique<GeneratorBitset>(task_proxy);
+        if (is_bitset_faster(task_proxy, *root, *candidate)) {
+            bitset = std::move(candidate);
+            root.reset();
+        }
+    }
+}
+
+SuccessorGenerator::SuccessorGenerator(vector<int> byte_code)
+{
+    assert(!byte_code.empty());
+    // The first entry is the root, the rest is the code.
+    int root = byte_code.front();
+    byte_code.erase(byte_code.begin());
+    this->byte_code =
+        make_unique<GeneratorByteCode>(std::move(byte_code), root);
 }
 
 SuccessorGenerator::~SuccessorGenerator() = default;
@@ -20,8 +70,124 @@ void SuccessorGenerator::generate_applicable_ops(
     const State& state,
     vector<OperatorID>& applicable_ops) const
 {
-    root->generate_applicable_ops(state.get_unpacked_values(), applicable_ops);
+    if (byte_code) {
+        byte_code->generate_applicable_ops(
+            state.get_unpacked_values(),
+            applicable_ops);
+    } else if (bitset) {
+        bitset->generate_applicable_ops(
+            state.get_unpacked_values(),
+            applicable_ops);
+    } else {
+        root->generate_applicable_ops(
+            state.get_unpacked_values(),
+            applicable_ops);
+    }
+}
+
+void SuccessorGenerator::generate_applicable_ops_batch(
+    span<const State> states,
+    ApplicableOpsBatch& result) const
+{
+    int num_states = states.size();
+    result.offsets.assign(1, 0);
+    result.operators.clear();
+    if (!root) {
+        for (const State& state : states) {
+            generate_applicable_ops(state, result.operators);
+            result.offsets.push_back(result.operators.size());
+        }
+        return;
+    }
+
+    vector<const int*> state_values;
+    state_values.reserve(num_states);
+    for (const State& state : states)
+        state_values.push_back(state.get_unpacked_values().data());
+    vector<int> stack(num_states);
+    iota(stack.begin(), stack.end(), 0);
+    LeafVisits leaf_visits;
+    root->generate_applicable_ops_batch(
+        state_values,
+        stack,
+        0,
+        num_states,
+        leaf_visits);
+
+    /* Lay out the operators by state. Since the leaves were visited in
+       the same order as by generate_applicable_ops, this keeps the order
+       of the operators of each state. */
+    result.offsets.assign(num_states + 1, 0);
+    for (const LeafVisits::Visit& visit : leaf_visits.visits) {
+        for (int i = visit.begin; i < visit.end; ++i)
+            result.offsets[leaf_visits.state_indices[i] + 1] +=
+                visit.num_operators;
+    }
+    for (int i = 0; i < num_states; ++i)
+        result.offsets[i + 1] += result.offsets[i];
+    vector<int> next_position(result.offsets.begin(), result.offsets.end() - 1);
+    result.operators.assign(result.offsets.back(), OperatorID::no_operator);
+    for (const LeafVisits::Visit& visit : leaf_visits.visits) {
+        for (int i = visit.begin; i < visit.end; ++i) {
+            int& position = next_position[leaf_visits.state_indices[i]];
+            copy_n(
+                visit.operators,
+                visit.num_operators,
+                result.operators.begin() + position);
+            position += visit.num_operators;
+        }
+    }
+}
+
+vector<int> SuccessorGenerator::get_byte_code() const
+{
+    assert(byte_code);
+    vector<int> result;
+    result.reserve(byte_code->get_size() + 1);
+    result.push_back(byte_code->get_root());
+    result.insert(
+        result.end(),
+        byte_code->get_code().begin(),
+        byte_code->get_code().end());
+    return result;
 }
 
 PerTaskInformation<SuccessorGenerator> g_successor_generators;
+
+PerTaskInformation<SuccessorGenerator> g_byte_code_successor_generators(
+    [](const PlanningTaskProxy& task_proxy) {
+        return make_unique<SuccessorGenerator>(
+            task_proxy,
+            Representation::BYTE_CODE);
+    });
+
+PerTaskInformation<SuccessorGenerator> g_bitset_successor_generators(
+    [](const PlanningTaskProxy& task_proxy) {
+        return make_unique<SuccessorGenerator>(
+            task_proxy,
+            Representation::BITSET);
+    });
+
+PerTaskInformation<SuccessorGenerator> g_automatic_successor_generators(
+    [](const PlanningTaskProxy& task_proxy) {
+        return make_unique<SuccessorGenerator>(
+            task_proxy,
+            Representation::AUTOMATIC);
+    });
+
+SuccessorGenerator& get_successor_generator(
+    const PlanningTaskProxy& task_proxy,
+    Representation representation)
+{
+    switch (representation) {
+    case Representation::BYTE_CODE:
+        return g_byte_code_successor_generators[task_proxy];
+    case Representation::BITSET:
+        return g_bitset_successor_generators[task_proxy];
+    case Representation::AUTOMATIC:
+        return g_automatic_successor_generators[task_proxy];
+    default:
+        return g_successor_generators[task_proxy];
+    }
+}
 } // namespace successor_generator
@@ -2,7 +2,16 @@
 
 #include "downward/task_proxy.h"
 
+#include <algorithm>
+#include <bit>
 #include <cassert>
+#include <map>
+
+#if (defined(__GNUC__) || defined(__clang__)) &&                               \
+    (defined(__x86_64__) || defined(__i386__))
+#define SUCCESSOR_GENERATOR_HAS_AVX2
+#include <immintrin.h>
+#endif
 
 using namespace std;
 
@@ -21,7 +30,10 @@ using namespace std;
   - Going further down this route, on the more extreme end of the
     spectrum, we could use a "byte-code" style representation, where
     the successor generator is just a long vector of ints combining
-    information about node type with node payload.
+    information about node type with node payload. (This is now
+    implemented by GeneratorByteCode, which uses operator references
+    as children, forks, vector leaves, vector switches, single
+    switches and binary-searchable switches as discussed below.)
 
     For example, we could represent different node types as follows,
     where BINARY_FORK etc. are symbolic constants for tagging node
@@ -89,6 +101,27 @@ void GeneratorForkBinary::generate_applicable_ops(
     generator2->generate_applicable_ops(state, applicable_ops);
 }
 
+void GeneratorForkBinary::generate_applicable_ops_batch(
+    const vector<const int*>& states,
+    vector<int>& stack,
+    int begin,
+    int end,
+    LeafVisits& leaf_visits) const
+{
+    generator1->generate_applicable_ops_batch(
+        states,
+        stack,
+        begin,
+        end,
+        leaf_visits);
+    generator2->generate_applicable_ops_batch(
+        states,
+        stack,
+        begin,
+        end,
+        leaf_visits);
+}
+
 GeneratorForkMulti::GeneratorForkMulti(
     vector<unique_ptr<GeneratorBase>> children)
     : children(std::move(children))
@@ -108,6 +141,84 @@ void GeneratorForkMulti::generate_applicable_ops(
         generator->generate_applicable_ops(state, applicable_ops);
 }
 
+void GeneratorForkMulti::generate_applicable_ops_batch(
+    const vector<const int*>& states,
+    vector<int>& stack,
+    int begin,
+    int end,
+    LeafVisits& leaf_visits) const
+{
+    for (const auto& generator : children) {
+        generator->generate_applicable_ops_batch(
+            states,
+            stack,
+            begin,
+            end,
+            leaf_visits);
+    }
+}
+
+static int append_fork(vector<int>& code, const vector<int>& children)
+{
+    int ref = code.size();
+    code.push_back(GeneratorByteCode::FORK);
+    code.push_back(children.size());
+    code.insert(code.end(), children.begin(), children.end());
+    return ref;
+}
+
+/*
+  Sorts the (value, child) pairs by value. The values must be distinct.
+*/
+static int append_switch(
+    vector<int>& code,
+    int switch_var_id,
+    vector<pair<int, int>> children)
+{
+    sort(children.begin(), children.end());
+    int ref = code.size();
+    code.push_back(GeneratorByteCode::SWITCH);
+    code.push_back(children.size());
+    code.push_back(switch_var_id);
+    for (const auto& [value, child] : children) {
+        code.push_back(value);
+        code.push_back(child);
+    }
+    return ref;
+}
+
+int GeneratorForkBinary::append_byte_code(vector<int>& code) const
+{
+    int child1 = generator1->append_byte_code(code);
+    int child2 = generator2->append_byte_code(code);
+    return append_fork(code, {child1, child2});
+}
+
+double GeneratorForkBinary::get_expected_num_visits(
+    const vector<int>& domain_sizes) const
+{
+    return 1 + generator1->get_expected_num_visits(domain_sizes) +
+           generator2->get_expected_num_visits(domain_sizes);
+}
+
+int GeneratorForkMulti::append_byte_code(vector<int>& code) const
+{
+    vector<int> child_refs;
+    child_refs.reserve(children.size());
+    for (const auto& generator : children)
+        child_refs.push_back(generator->append_byte_code(code));
+    return append_fork(code, child_refs);
+}
+
+double GeneratorForkMulti::get_expected_num_visits(
+    const vector<int>& domain_sizes) const
+{
+    double num_visits = 1;
+    for (const auto& generator : children)
+        num_visits += generator->get_expected_num_visits(domain_sizes);
+    return num_visits;
+}
+
 GeneratorSwitchVector::GeneratorSwitchVector(
     int switch_var_id,
     vector<unique_ptr<GeneratorBase>>&& generator_for_value)
@@ -128,6 +239,55 @@ void GeneratorSwitchVector::generate_applicable_ops(
     }
 }
 
+void GeneratorSwitchVector::generate_applicable_ops_batch(
+    const vector<const int*>& states,
+    vector<int>& stack,
+    int begin,
+    int end,
+    LeafVisits& leaf_visits) const
+{
+    /*
+      Partition the states by value with a counting sort. The stack holds
+      the first position of each value (followed by the end position),
+      and then the partitioned indices.
+    */
+    int domain_size = generator_for_value.size();
+    int frame = stack.size();
+    int first_index = frame + domain_size + 1;
+    stack.resize(first_index + (end - begin), 0);
+    for (int i = begin; i < end; ++i)
+        ++stack[frame + 1 + states[stack[i]][switch_var_id]];
+    stack[frame] = first_index;
+    for (int val = 0; val < domain_size; ++val)
+        stack[frame + val + 1] += stack[frame + val];
+    for (int i = begin; i < end; ++i) {
+        int index = stack[i];
+        int val = states[index][switch_var_id];
+        // Use the start position of the value as insertion position.
+        stack[stack[frame + val]++] = index;
+    }
+    // Restore the start positions, which have moved to the next value.
+    for (int val = domain_size; val > 0; --val)
+        stack[frame + val] = stack[frame + val - 1];
+    stack[frame] = first_index;
+
+    for (int val = 0; val < domain_size; ++val) {
+        const unique_ptr<GeneratorBase>& generator_for_val =
+            generator_for_value[val];
+        int val_begin = stack[frame + val];
+        int val_end = stack[frame + val + 1];
+        if (generator_for_val && val_begin != val_end) {
+            generator_for_val->generate_applicable_ops_batch(
+                states,
+                stack,
+                val_begin,
+                val_end,
+                leaf_visits);
+        }
+    }
+    stack.resize(frame);
+}
+
 GeneratorSwitchHash::GeneratorSwitchHash(
     int switch_var_id,
     unordered_map<int, unique_ptr<GeneratorBase>>&& generator_for_value)
@@ -136,6 +296,33 @@ GeneratorSwitchHash::GeneratorSwitchHash(
 {
 }
 
+int GeneratorSwitchVector::append_byte_code(vector<int>& code) const
+{
+    vector<int> child_refs;
+    child_refs.reserve(generator_for_value.size());
+    for (const auto& generator : generator_for_value) {
+        child_refs.push_back(
+            generator ? generator->append_byte_code(code)
+                      : GeneratorByteCode::NO_CHILD);
+    }
+    int ref = code.size();
+    code.push_back(GeneratorByteCode::VECTOR_SWITCH);
+    code.push_back(switch_var_id);
+    code.insert(code.end(), child_refs.begin(), child_refs.end());
+    return ref;
+}
+
+double GeneratorSwitchVector::get_expected_num_visits(
+    const vector<int>& domain_sizes) const
+{
+    double child_visits = 0;
+    for (const auto& generator : generator_for_value) {
+        if (generator)
+            child_visits += generator->get_expected_num_visits(domain_sizes);
+    }
+    return 1 + child_visits / domain_sizes[switch_var_id];
+}
+
 void GeneratorSwitchHash::generate_applicable_ops(
     const vector<int>& state,
     vector<OperatorID>& applicable_ops) const
@@ -148,6 +335,62 @@ void GeneratorSwitchHash::generate_applicable_ops(
     }
 }
 
+void GeneratorSwitchHash::generate_applicable_ops_batch(
+    const vector<const int*>& states,
+    vector<int>& stack,
+    int begin,
+    int end,
+    LeafVisits& leaf_visits) const
+{
+    // Sort the states that have a child by value.
+    vector<pair<int, int>> values_and_indices;
+    for (int i = begin; i < end; ++i) {
+        int val = states[stack[i]][switch_var_id];
+        if (generator_for_value.count(val))
+            values_and_indices.emplace_back(val, stack[i]);
+    }
+    sort(values_and_indices.begin(), values_and_indices.end());
+
+    int frame = stack.size();
+    for (const auto& [val, index] : values_and_indices)
+        stack.push_back(index);
+    int group_begin = 0;
+    int num_indices = values_and_indices.size();
+    while (group_begin < num_indices) {
+        int val = values_and_indices[group_begin].first;
+        int group_end = group_begin;
+        while (group_end < num_indices &&
+               values_and_indices[group_end].first == val)
+            ++group_end;
+        generator_for_value.at(val)->generate_applicable_ops_batch(
+            states,
+            stack,
+            frame + group_begin,
+            frame + group_end,
+            leaf_visits);
+        group_begin = group_end;
+    }
+    stack.resize(frame);
+}
+
+int GeneratorSwitchHash::append_byte_code(vector<int>& code) const
+{
+    vector<pair<int, int>> children;
+    children.reserve(generator_for_value.size());
+    for (const auto& [value, generator] : generator_for_value)
+        children.emplace_back(value, generator->append_byte_code(code));
+    return append_switch(code, switch_var_id, std::move(children));
+}
+
+double GeneratorSwitchHash::get_expected_num_visits(
+    const vector<int>& domain_sizes) const
+{
+    double child_visits = 0;
+    for (const auto& [value, generator] : generator_for_value)
+        child_visits += generator->get_expected_num_visits(domain_sizes);
+    return 1 + child_visits / domain_sizes[switch_var_id];
+}
+
 GeneratorSwitchSingle::GeneratorSwitchSingle(
     int switch_var_id,
     int value,
@@ -167,6 +410,48 @@ void GeneratorSwitchSingle::generate_applicable_ops(
     }
 }
 
+void GeneratorSwitchSingle::generate_applicable_ops_batch(
+    const vector<const int*>& states,
+    vector<int>& stack,
+    int begin,
+    int end,
+    LeafVisits& leaf_visits) const
+{
+    int frame = stack.size();
+    for (int i = begin; i < end; ++i) {
+        if (value == states[stack[i]][switch_var_id])
+            stack.push_back(stack[i]);
+    }
+    int matching_end = stack.size();
+    if (matching_end != frame) {
+        generator_for_value->generate_applicable_ops_batch(
+            states,
+            stack,
+            frame,
+            matching_end,
+            leaf_visits);
+    }
+    stack.resize(frame);
+}
+
+int GeneratorSwitchSingle::append_byte_code(vector<int>& code) const
+{
+    int child = generator_for_value->append_byte_code(code);
+    int ref = code.size();
+    code.push_back(GeneratorByteCode::SINGLE_SWITCH);
+    code.push_back(switch_var_id);
+    code.push_back(value);
+    code.push_back(child);
+    return ref;
+}
+
+double GeneratorSwitchSingle::get_expected_num_visits(
+    const vector<int>& domain_sizes) const
+{
+    return 1 + generator_for_value->get_expected_num_visits(domain_sizes) /
+                   domain_sizes[switch_var_id];
+}
+
 GeneratorLeafVector::GeneratorLeafVector(
     vector<OperatorID>&& applicable_operators)
     : applicable_operators(std::move(applicable_operators))
@@ -189,6 +474,35 @@ void GeneratorLeafVector::generate_applicable_ops(
     }
 }
 
+void GeneratorLeafVector::generate_applicable_ops_batch(
+    const vector<const int*>&,
+    vector<int>& stack,
+    int begin,
+    int end,
+    LeafVisits& leaf_visits) const
+{
+    leaf_visits.add_visit(
+        applicable_operators.data(),
+        applicable_operators.size(),
+        stack.data() + begin,
+        stack.data() + end);
+}
+
+int GeneratorLeafVector::append_byte_code(vector<int>& code) const
+{
+    int ref = code.size();
+    code.push_back(GeneratorByteCode::LEAF);
+    code.push_back(applicable_operators.size());
+    for (OperatorID id : applicable_operators)
+        code.push_back(id.get_index());
+    return ref;
+}
+
+double GeneratorLeafVector::get_expected_num_visits(const vector<int>&) const
+{
+    return 1;
+}
+
 GeneratorLeafSingle::GeneratorLeafSingle(OperatorID applicable_operator)
     : applicable_operator(applicable_operator)
 {
@@ -200,4 +514,293 @@ void GeneratorLeafSingle::generate_applicable_ops(
 {
     applicable_ops.push_back(applicable_operator);
 }
+
+void GeneratorLeafSingle::generate_applicable_ops_batch(
+    const vector<const int*>&,
+    vector<int>& stack,
+    int begin,
+    int end,
+    LeafVisits& leaf_visits) const
+{
+    leaf_visits.add_visit(
+        &applicable_operator,
+        1,
+        stack.data() + begin,
+        stack.data() + end);
+}
+
+int GeneratorLeafSingle::append_byte_code(vector<int>&) const
+{
+    return GeneratorByteCode::get_operator_ref(applicable_operator);
+}
+
+double GeneratorLeafSingle::get_expected_num_visits(const vector<int>&) const
+{
+    return 1;
+}
+
+GeneratorByteCode::GeneratorByteCode(const GeneratorBase& tree)
+{
+    root = tree.append_byte_code(code);
+    code.shrink_to_fit();
+}
+
+GeneratorByteCode::GeneratorByteCode(vector<int>&& code, int root)
+    : code(std::move(code))
+    , root(root)
+{
+}
+
+/*
+  Follows the switches starting at ref and returns the reference to the
+  first operator, leaf or fork reached, or NO_CHILD if a switch has no child
+  for the value of its variable.
+*/
+static inline int follow_switches(const int* code, int ref, const int* state)
+{
+    while (ref >= 0) {
+        const int* node = code + ref;
+        switch (node[0]) {
+        case GeneratorByteCode::FORK:
+        case GeneratorByteCode::LEAF:
+            return ref;
+        case GeneratorByteCode::VECTOR_SWITCH:
+            ref = node[2 + state[node[1]]];
+            break;
+        case GeneratorByteCode::SINGLE_SWITCH:
+            ref = state[node[1]] == node[2] ? node[3]
+                                            : GeneratorByteCode::NO_CHILD;
+            break;
+        case GeneratorByteCode::SWITCH: {
+            int num_children = node[1];
+            int value = state[node[2]];
+            const int* entries = node + 3;
+            // Binary search over the (value, child) pairs.
+            int lo = 0;
+            int hi = num_children;
+            while (hi - lo > 8) {
+                int mid = (lo + hi) / 2;
+                if (entries[2 * mid] < value)
+                    lo = mid + 1;
+                else
+                    hi = mid;
+            }
+            // Scan the remaining pairs linearly.
+            while (lo < hi && entries[2 * lo] < value)
+                ++lo;
+            if (lo == hi || entries[2 * lo] != value)
+                return GeneratorByteCode::NO_CHILD;
+            ref = entries[2 * lo + 1];
+            break;
+        }
+        default:
+            assert(false);
+            return GeneratorByteCode::NO_CHILD;
+        }
+    }
+    return ref;
+}
+
+void GeneratorByteCode::generate_applicable_ops(
+    int ref,
+    const int* state,
+    vector<OperatorID>& applicable_ops) const
+{
+    /*
+      Switches are followed iteratively, so only forks whose children
+      lead to further forks cause recursive calls. The code is accessed
+      through a local pointer because the compiler cannot prove that
+      adding operators does not modify the vector holding the code.
+    */
+    const int* code = this->code.data();
+    ref = follow_switches(code, ref, state);
+    if (ref == NO_CHILD) return;
+    if (ref < 0) {
+        applicable_ops.emplace_back(-ref - 1);
+        return;
+    }
+    const int* node = code + ref;
+    int num_children = node[1];
+    if (node[0] == LEAF) {
+        for (int i = 0; i < num_children; ++i)
+            applicable_ops.emplace_back(node[2 + i]);
+        return;
+    }
+    assert(node[0] == FORK);
+    const int* children = node + 2;
+    for (int i = 0; i < num_children; ++i) {
+        int child = children[i];
+        if (child >= 0) {
+            child = follow_switches(code, child, state);
+            if (child == NO_CHILD) continue;
+            if (child >= 0) {
+                generate_applicable_ops(child, state, applicable_ops);
+                continue;
+            }
+        }
+        applicable_ops.emplace_back(-child - 1);
+    }
+}
+
+GeneratorBitset::GeneratorBitset(const PlanningTaskProxy& task_proxy)
+{
+    AbstractOperatorsProxy operators = task_proxy.get_abstract_operators();
+    VariablesProxy variables = task_proxy.get_variables();
+    int num_operators = operators.size();
+    num_blocks = (num_operators + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    /* The rows of the blocks are consecutive, so the bit of an operator
+       in the row of its block is simply bit op_id of the first rows. */
+    rows.assign(num_blocks * WORDS_PER_BLOCK, 0);
+    for (int op_id = 0; op_id < num_operators; ++op_id)
+        rows[op_id / 64] |= Word(1) << (op_id % 64);
+
+    block_begin.push_back(0);
+    for (int block = 0; block < num_blocks; ++block) {
+        int first_op = block * BLOCK_SIZE;
+        int end_op = min(first_op + BLOCK_SIZE, num_operators);
+        // Maps each variable to the (position in block, value) pairs.
+        map<int, vector<pair<int, int>>> preconditions_by_var;
+        for (int op_id = first_op; op_id < end_op; ++op_id) {
+            for (FactProxy pre : operators[op_id].get_precondition()) {
+                FactPair fact = pre.get_pair();
+                preconditions_by_var[fact.var].emplace_back(
+                    op_id - first_op,
+                    fact.value);
+            }
+        }
+
+        /*
+          Combine the rows of the most constrained variables first, so the
+          result tends to become empty early.
+        */
+        vector<pair<int, const vector<pair<int, int>>*>> block_vars;
+        for (const auto& [var_id, preconditions] : preconditions_by_var)
+            block_vars.emplace_back(var_id, &preconditions);
+        stable_sort(
+            block_vars.begin(),
+            block_vars.end(),
+            [](const auto& lhs, const auto& rhs) {
+                return lhs.second->size() > rhs.second->size();
+            });
+
+        vector<Word> block_row(
+            rows.begin() + block * WORDS_PER_BLOCK,
+            rows.begin() + (block + 1) * WORDS_PER_BLOCK);
+        for (const auto& [var_id, preconditions] : block_vars) {
+            int domain_size = variables[var_id].get_domain_size();
+            int first_row = rows.size() / WORDS_PER_BLOCK;
+            for (int value = 0; value < domain_size; ++value)
+                rows.insert(rows.end(), block_row.begin(), block_row.end());
+            for (const auto& [pos, pre_value] : *preconditions) {
+                for (int value = 0; value < domain_size; ++value) {
+                    if (value != pre_value) {
+                        Word* row =
+                            &rows[(first_row + value) * WORDS_PER_BLOCK];
+                        row[pos / 64] &= ~(Word(1) << (pos % 64));
+                    }
+                }
+            }
+            var.push_back(var_id);
+            row_for_value_0.push_back(first_row);
+        }
+        block_begin.push_back(var.size());
+    }
+    rows.shrink_to_fit();
+
+#ifdef SUCCESSOR_GENERATOR_HAS_AVX2
+    use_avx2 = __builtin_cpu_supports("avx2");
+#else
+    use_avx2 = false;
+#endif
+}
+
+static inline void add_operators(
+    GeneratorBitset::Word word,
+    int first_op,
+    vector<OperatorID>& applicable_ops)
+{
+    while (word) {
+        applicable_ops.emplace_back(first_op + countr_zero(word));
+        word &= word - 1;
+    }
+}
+
+void GeneratorBitset::generate_applicable_ops(
+    const vector<int>& state,
+    vector<OperatorID>& applicable_ops) const
+{
+    if (use_avx2)
+        generate_applicable_ops_avx2(state, applicable_ops);
+    else
+        generate_applicable_ops_scalar(state, applicable_ops);
+}
+
+void GeneratorBitset::generate_applicable_ops_scalar(
+    const vector<int>& state,
+    vector<OperatorID>& applicable_ops) const
+{
+    for (int block = 0; block < num_blocks; ++block) {
+        Word result[WORDS_PER_BLOCK];
+        const Word* block_row = &rows[block * WORDS_PER_BLOCK];
+        copy(block_row, block_row + WORDS_PER_BLOCK, result);
+        bool empty = false;
+        for (int i = block_begin[block]; i < block_begin[block + 1]; ++i) {
+            const Word* row =
+                &rows[(row_for_value_0[i] + state[var[i]]) * WORDS_PER_BLOCK];
+            Word any = 0;
+            for (int w = 0; w < WORDS_PER_BLOCK; ++w) {
+                result[w] &= row[w];
+                any |= result[w];
+            }
+            if (!any) {
+                empty = true;
+                break;
+            }
+        }
+        if (empty) continue;
+        for (int w = 0; w < WORDS_PER_BLOCK; ++w)
+            add_operators(
+                result[w],
+                block * BLOCK_SIZE + w * 64,
+                applicable_ops);
+    }
+}
+
+#ifdef SUCCESSOR_GENERATOR_HAS_AVX2
+__attribute__((target("avx2"))) void
+GeneratorBitset::generate_applicable_ops_avx2(
+    const vector<int>& state,
+    vector<OperatorID>& applicable_ops) const
+{
+    static_assert(WORDS_PER_BLOCK * sizeof(Word) == sizeof(__m256i));
+    for (int block = 0; block < num_blocks; ++block) {
+        __m256i result = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(&rows[block * WORDS_PER_BLOCK]));
+        for (int i = block_begin[block]; i < block_begin[block + 1]; ++i) {
+            const Word* row =
+                &rows[(row_for_value_0[i] + state[var[i]]) * WORDS_PER_BLOCK];
+            result = _mm256_and_si256(
+                result,
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(row)));
+            if (_mm256_testz_si256(result, result)) break;
+        }
+        if (_mm256_testz_si256(result, result)) continue;
+        Word words[WORDS_PER_BLOCK];
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(words), result);
+        for (int w = 0; w < WORDS_PER_BLOCK; ++w)
+            add_operators(
+                words[w],
+                block * BLOCK_SIZE + w * 64,
+                applicable_ops);
+    }
+}
+#else
+void GeneratorBitset::generate_applicable_ops_avx2(
+    const vector<int>& state,
+    vector<OperatorID>& applicable_ops) const
+{
+    generate_applicable_ops_scalar(state, applicable_ops);
+}
+#endif
 } // namespace successor_generator
@@ -76,6 +76,8 @@ void print_variable_statistics(
     utils::LogProxy& log)
 {
     const int_packer::IntPacker& state_packer = g_state_packers[task_proxy];
+    const int_packer::IntPacker& mixed_radix_state_packer =
+        g_mixed_radix_state_packers[task_proxy];
 
     int num_facts = 0;
     VariablesProxy variables = task_proxy.get_variables();
@@ -87,16 +89,45 @@ void print_variable_statistics(
     log << "Bytes per state: "
         << state_packer.get_num_bins() * sizeof(int_packer::IntPacker::Bin)
         << endl;
+    log << "Bytes per state with mixed-radix encoding: "
+        << mixed_radix_state_packer.get_num_bins() *
+               sizeof(int_packer::IntPacker::Bin)
+        << endl;
+}
+
+static unique_ptr<int_packer::IntPacker> create_state_packer(
+    const PlanningTaskProxy& task_proxy,
+    int_packer::Encoding encoding)
+{
+    VariablesProxy variables = task_proxy.get_variables();
+    vector<int> variable_ranges;
+    variable_ranges.reserve(variables.size());
+    for (VariableProxy var : variables) {
+        variable_ranges.push_back(var.get_domain_size());
+    }
+    return std::make_unique<int_packer::IntPacker>(variable_ranges, encoding);
 }
 
 PerTaskInformation<int_packer::IntPacker>
     g_state_packers([](const PlanningTaskProxy& task_proxy) {
-        VariablesProxy variables = task_proxy.get_variables();
-        vector<int> variable_ranges;
-        variable_ranges.reserve(variables.size());
-        for (VariableProxy var : variables) {
-            variable_ranges.push_back(var.get_domain_size());
-        }
-        return std::make_unique<int_packer::IntPacker>(variable_ranges);
+        return create_state_packer(
+            task_proxy,
+            int_packer::Encoding::BIT_FIELDS);
     });
+
+PerTaskInformation<int_packer::IntPacker>
+    g_mixed_radix_state_packers([](const PlanningTaskProxy& task_proxy) {
+        return create_state_packer(
+            task_proxy,
+            int_packer::Encoding::MIXED_RADIX);
+    });
+
+const int_packer::IntPacker& get_state_packer(
+    const PlanningTaskProxy& task_proxy,
+    int_packer::Encoding encoding)
+{
+    if (encoding == int_packer::Encoding::MIXED_RADIX)
+        return g_mixed_radix_state_packers[task_proxy];
+    return g_state_packers[task_proxy];
+}
 } // namespace task_properties
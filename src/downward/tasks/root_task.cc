@@ -4,16 +4,30 @@
 #include "downward/plugin.h"
 #include "downward/state_registry.h"
 
+#include "downward/task_utils/successor_generator.h"
 #include "downward/utils/collections.h"
+#include "downward/utils/system.h"
 #include "downward/utils/timer.h"
 
 #include <algorithm>
 #include <cassert>
+#include <cerrno>
+#include <climits>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
 #include <memory>
-#include <set>
-#include <unordered_set>
+#include <string_view>
+#include <thread>
 #include <vector>
 
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using namespace std;
 using utils::ExitCode;
 
@@ -22,14 +36,152 @@ static const auto PRE_FILE_VERSION = "3";
 static const auto PRE_FILE_PROB_VERSION = "3P";
 shared_ptr<ClassicalTask> g_root_task = nullptr;
 
+/*
+  Position of a name in the name arena of a RootTask. All names of a task
+  are stored in a single string to avoid one allocation per name.
+*/
+struct NameRange {
+    size_t begin;
+    size_t end;
+};
+
+static NameRange add_name(string& names, string_view name)
+{
+    NameRange range{names.size(), names.size() + name.size()};
+    names.append(name);
+    return range;
+}
+
+/*
+  Reads the translator output from a buffer that holds all of it. Tokens
+  are separated by whitespace as for formatted stream extraction, so this
+  accepts the same input as reading the task with istream::operator>>.
+*/
+class SasScanner {
+    const char* pos;
+    const char* end;
+
+    static bool is_space(char c)
+    {
+        return c == ' ' || (c >= '\t' && c <= '\r');
+    }
+
+    static bool is_digit(char c) { return c >= '0' && c <= '9'; }
+
+public:
+    SasScanner(const char* begin, const char* end)
+        : pos(begin)
+        , end(end)
+    {
+    }
+
+    const char* get_position() const { return pos; }
+
+    const char* get_end() const { return end; }
+
+    void skip_whitespace()
+    {
+        while (pos != end && is_space(*pos)) ++pos;
+    }
+
+    string_view peek_word()
+    {
+        skip_whitespace();
+        const char* word_end = pos;
+        while (word_end != end && !is_space(*word_end)) ++word_end;
+        return string_view(pos, word_end - pos);
+    }
+
+    string_view read_word()
+    {
+        string_view word = peek_word();
+        pos += word.size();
+        return word;
+    }
+
+    // Like getline: the rest of the current line without the newline.
+    string_view read_rest_of_line()
+    {
+        const char* line_end = pos;
+        while (line_end != end && *line_end != '\n') ++line_end;
+        string_view line(pos, line_end - pos);
+        pos = line_end == end ? end : line_end + 1;
+        return line;
+    }
+
+    string_view read_line()
+    {
+        skip_whitespace();
+        return read_rest_of_line();
+    }
+
+    int read_int()
+    {
+        skip_whitespace();
+        bool negative = false;
+        if (pos != end && (*pos == '-' || *pos == '+')) {
+            negative = *pos == '-';
+            ++pos;
+        }
+        if (pos == end || !is_digit(*pos)) {
+            cerr << "Expected a number in the translator output." << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        long long value = 0;
+        while (pos != end && is_digit(*pos)) {
+            value = 10 * value + (*pos - '0');
+            if (value > INT_MAX + 1LL) {
+                cerr << "Number out of range in the translator output."
+                     << endl;
+                utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+            }
+            ++pos;
+        }
+        if (negative) value = -value;
+        if (value > INT_MAX) {
+            cerr << "Number out of range in the translator output." << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        return value;
+    }
+
+    void check_magic(string_view magic)
+    {
+        string_view word = read_word();
+        if (word != magic) {
+            cerr << "Failed to match magic word '" << magic << "'." << endl
+                 << "Got '" << word << "'." << endl;
+            if (magic == "begin_version") {
+                cerr << "Possible cause: you are running the planner "
+                     << "on a translator output file from " << endl
+                     << "an older version." << endl;
+            }
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+    }
+
+    vector<FactPair> read_facts()
+    {
+        int count = read_int();
+        vector<FactPair> facts;
+        facts.reserve(count);
+        for (int i = 0; i < count; ++i) {
+            int var = read_int();
+            int value = read_int();
+            facts.emplace_back(var, value);
+        }
+        return facts;
+    }
+};
+
 struct ExplicitVariable {
     int domain_size;
-    string name;
-    vector<string> fact_names;
+    NameRange name;
+    vector<NameRange> fact_names;
     int axiom_layer;
     int axiom_default_value;
 
-    explicit ExplicitVariable(istream& in);
+    ExplicitVariable(SasScanner& scanner, string& names);
 };
 
 struct ExplicitEffect {
@@ -43,30 +195,38 @@ struct ExplicitOperator {
     vector<FactPair> preconditions;
     vector<ExplicitEffect> effects;
     int cost;
-    string name;
+    NameRange name;
     bool is_an_axiom;
 
-    void read_pre_post(istream& in);
-    ExplicitOperator(istream& in, bool is_an_axiom, bool use_metric);
+    void read_pre_post(SasScanner& scanner);
+    ExplicitOperator(
+        SasScanner& scanner,
+        string& names,
+        bool is_an_axiom,
+        bool use_metric);
 };
 
 class RootTask : public ClassicalTask {
     vector<ExplicitVariable> variables;
-    // TODO: think about using hash sets here.
-    vector<vector<set<FactPair>>> mutexes;
+    // The facts mutex with each fact, sorted and without duplicates.
+    vector<vector<vector<FactPair>>> mutexes;
     vector<ExplicitOperator> operators;
     vector<ExplicitOperator> axioms;
     vector<int> initial_state_values;
     vector<FactPair> goals;
+    string names;
 
     const ExplicitVariable& get_variable(int var) const;
     const ExplicitEffect&
     get_effect(int op_id, int effect_id, bool is_axiom) const;
     const ExplicitOperator&
     get_operator_or_axiom(int index, bool is_axiom) const;
+    string get_name(NameRange range) const;
 
 public:
-    explicit RootTask(istream& in);
+    RootTask(SasScanner& scanner, int num_threads);
+
+    void write_binary(ostream& out) const;
 
     virtual int get_num_variables() const override;
     virtual string get_variable_name(int var) const override;
@@ -128,47 +288,17 @@ static void check_facts(
     }
 }
 
-static void check_magic(istream& in, const string& magic)
-{
-    string word;
-    in >> word;
-    if (word != magic) {
-        cerr << "Failed to match magic word '" << magic << "'." << endl
-             << "Got '" << word << "'." << endl;
-        if (magic == "begin_version") {
-            cerr << "Possible cause: you are running the planner "
-                 << "on a translator output file from " << endl
-                 << "an older version." << endl;
-        }
-        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
-    }
-}
-
-static vector<FactPair> read_facts(istream& in)
-{
-    int count;
-    in >> count;
-    vector<FactPair> conditions;
-    conditions.reserve(count);
-    for (int i = 0; i < count; ++i) {
-        FactPair condition = FactPair::no_fact;
-        in >> condition.var >> condition.value;
-        conditions.push_back(condition);
-    }
-    return conditions;
-}
-
-ExplicitVariable::ExplicitVariable(istream& in)
+ExplicitVariable::ExplicitVariable(SasScanner& scanner, string& names)
 {
-    check_magic(in, "begin_variable");
-    in >> name;
-    in >> axiom_layer;
-    in >> domain_size;
-    in >> ws;
+    scanner.check_magic("begin_variable");
+    name = add_name(names, scanner.read_word());
+    axiom_layer = scanner.read_int();
+    domain_size = scanner.read_int();
+    scanner.skip_whitespace();
     fact_names.resize(domain_size);
     for (int i = 0; i < domain_size; ++i)
-        getline(in, fact_names[i]);
-    check_magic(in, "end_variable");
+        fact_names[i] = add_name(names, scanner.read_rest_of_line());
+    scanner.check_magic("end_variable");
 }
 
 ExplicitEffect::ExplicitEffect(
@@ -180,11 +310,12 @@ ExplicitEffect::ExplicitEffect(
 {
 }
 
-void ExplicitOperator::read_pre_post(istream& in)
+void ExplicitOperator::read_pre_post(SasScanner& scanner)
 {
-    vector<FactPair> conditions = read_facts(in);
-    int var, value_pre, value_post;
-    in >> var >> value_pre >> value_post;
+    vector<FactPair> conditions = scanner.read_facts();
+    int var = scanner.read_int();
+    int value_pre = scanner.read_int();
+    int value_post = scanner.read_int();
     if (value_pre != -1) {
         preconditions.emplace_back(var, value_pre);
     }
@@ -192,43 +323,41 @@ void ExplicitOperator::read_pre_post(istream& in)
 }
 
 ExplicitOperator::ExplicitOperator(
-    istream& in,
+    SasScanner& scanner,
+    string& names,
     bool is_an_axiom,
     bool use_metric)
     : is_an_axiom(is_an_axiom)
 {
     if (!is_an_axiom) {
-        check_magic(in, "begin_operator");
-        in >> ws;
-        getline(in, name);
-        preconditions = read_facts(in);
-        int count;
-        in >> count;
+        scanner.check_magic("begin_operator");
+        name = add_name(names, scanner.read_line());
+        preconditions = scanner.read_facts();
+        int count = scanner.read_int();
         effects.reserve(count);
         for (int i = 0; i < count; ++i) {
-            read_pre_post(in);
+            read_pre_post(scanner);
         }
 
-        int op_cost;
-        in >> op_cost;
+        int op_cost = scanner.read_int();
         cost = use_metric ? op_cost : 1;
-        check_magic(in, "end_operator");
+        scanner.check_magic("end_operator");
     } else {
-        name = "<axiom>";
+        // Axioms have no name.
+        name = {0, 0};
         cost = 0;
-        check_magic(in, "begin_rule");
-        read_pre_post(in);
-        check_magic(in, "end_rule");
+        scanner.check_magic("begin_rule");
+        read_pre_post(scanner);
+        scanner.check_magic("end_rule");
     }
     assert(cost >= 0);
 }
 
-static void read_and_verify_version(istream& in)
+static void read_and_verify_version(SasScanner& scanner)
 {
-    std::string version;
-    check_magic(in, "begin_version");
-    in >> version;
-    check_magic(in, "end_version");
+    scanner.check_magic("begin_version");
+    string_view version = scanner.read_word();
+    scanner.check_magic("end_version");
     if (version != PRE_FILE_VERSION && version != PRE_FILE_PROB_VERSION) {
         cerr << "Expected translator output file version " << PRE_FILE_VERSION
              << ", got " << version << "." << endl
@@ -237,57 +366,43 @@ static void read_and_verify_version(istream& in)
     }
 }
 
-static bool read_metric(istream& in)
+static bool read_metric(SasScanner& scanner)
 {
-    bool use_metric;
-    check_magic(in, "begin_metric");
-    in >> use_metric;
-    check_magic(in, "end_metric");
+    scanner.check_magic("begin_metric");
+    int use_metric = scanner.read_int();
+    if (use_metric != 0 && use_metric != 1) {
+        cerr << "Invalid metric flag: " << use_metric << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    scanner.check_magic("end_metric");
     return use_metric;
 }
 
-static vector<ExplicitVariable> read_variables(istream& in)
+static vector<ExplicitVariable>
+read_variables(SasScanner& scanner, string& names)
 {
-    int count;
-    in >> count;
+    int count = scanner.read_int();
     vector<ExplicitVariable> variables;
     variables.reserve(count);
     for (int i = 0; i < count; ++i) {
-        variables.emplace_back(in);
+        variables.emplace_back(scanner, names);
     }
     return variables;
 }
 
-static vector<vector<set<FactPair>>>
-read_mutexes(istream& in, const vector<ExplicitVariable>& variables)
+static vector<vector<vector<FactPair>>>
+read_mutexes(SasScanner& scanner, const vector<ExplicitVariable>& variables)
 {
-    vector<vector<set<FactPair>>> inconsistent_facts(variables.size());
+    vector<vector<vector<FactPair>>> inconsistent_facts(variables.size());
     for (size_t i = 0; i < variables.size(); ++i)
         inconsistent_facts[i].resize(variables[i].domain_size);
 
-    int num_mutex_groups;
-    in >> num_mutex_groups;
+    int num_mutex_groups = scanner.read_int();
 
-    /*
-      NOTE: Mutex groups can overlap, in which case the same mutex
-      should not be represented multiple times. The current
-      representation takes care of that automatically by using sets.
-      If we ever change this representation, this is something to be
-      aware of.
-    */
     for (int i = 0; i < num_mutex_groups; ++i) {
-        check_magic(in, "begin_mutex_group");
-        int num_facts;
-        in >> num_facts;
-        vector<FactPair> invariant_group;
-        invariant_group.reserve(num_facts);
-        for (int j = 0; j < num_facts; ++j) {
-            int var;
-            int value;
-            in >> var >> value;
-            invariant_group.emplace_back(var, value);
-        }
-        check_magic(in, "end_mutex_group");
+        scanner.check_magic("begin_mutex_group");
+        vector<FactPair> invariant_group = scanner.read_facts();
+        scanner.check_magic("end_mutex_group");
         for (const FactPair& fact1 : invariant_group) {
             for (const FactPair& fact2 : invariant_group) {
                 if (fact1.var != fact2.var) {
@@ -301,19 +416,34 @@ read_mutexes(istream& in, const vector<ExplicitVariable>& variables)
                        can of course generate mutex groups which lead
                        to *some* redundant mutexes, where some but not
                        all facts talk about the same variable. */
-                    inconsistent_facts[fact1.var][fact1.value].insert(fact2);
+                    inconsistent_facts[fact1.var][fact1.value].push_back(
+                        fact2);
                 }
             }
         }
     }
+
+    /*
+      NOTE: Mutex groups can overlap, in which case the same mutex
+      should not be represented multiple times.
+    */
+    for (vector<vector<FactPair>>& var_mutexes : inconsistent_facts) {
+        for (vector<FactPair>& fact_mutexes : var_mutexes) {
+            sort(fact_mutexes.begin(), fact_mutexes.end());
+            fact_mutexes.erase(
+                unique(fact_mutexes.begin(), fact_mutexes.end()),
+                fact_mutexes.end());
+            fact_mutexes.shrink_to_fit();
+        }
+    }
     return inconsistent_facts;
 }
 
-static vector<FactPair> read_goal(istream& in)
+static vector<FactPair> read_goal(SasScanner& scanner)
 {
-    check_magic(in, "begin_goal");
-    vector<FactPair> goals = read_facts(in);
-    check_magic(in, "end_goal");
+    scanner.check_magic("begin_goal");
+    vector<FactPair> goals = scanner.read_facts();
+    scanner.check_magic("end_goal");
     if (goals.empty()) {
         cerr << "Task has no goal condition!" << endl;
         utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
@@ -322,46 +452,171 @@ static vector<FactPair> read_goal(istream& in)
 }
 
 static vector<ExplicitOperator> read_actions(
-    istream& in,
+    SasScanner& scanner,
+    string& names,
     bool is_axiom,
     bool use_metric,
     const vector<ExplicitVariable>& variables)
 {
-    int count;
-    in >> count;
+    int count = scanner.read_int();
     vector<ExplicitOperator> actions;
     actions.reserve(count);
     for (int i = 0; i < count; ++i) {
-        actions.emplace_back(in, is_axiom, use_metric);
+        actions.emplace_back(scanner, names, is_axiom, use_metric);
         check_facts(actions.back(), variables);
     }
     return actions;
 }
 
-RootTask::RootTask(istream& in)
+/*
+  Parsing the operators in parallel only pays off if each thread gets
+  enough of them.
+*/
+static const int MIN_OPERATORS_PER_THREAD = 10000;
+
+/*
+  Return the start of the first operator that starts at or after pos, or
+  nullptr if there is none. Operators are found where a line that is
+  exactly "end_operator" is followed by a line that is exactly
+  "begin_operator". This cannot happen inside an operator: its name is
+  the only line that can hold arbitrary text, and it is preceded by
+  "begin_operator" and followed by a number.
+*/
+static const char* find_operator_start(string_view buffer, size_t pos)
+{
+    static const string_view boundary = "\nend_operator\nbegin_operator\n";
+    // Offset of "begin_operator" in boundary.
+    static const size_t begin_offset = boundary.find('b');
+    pos = pos < begin_offset ? 0 : pos - begin_offset;
+    pos = buffer.find(boundary, pos);
+    if (pos == string_view::npos) return nullptr;
+    return buffer.data() + pos + begin_offset;
+}
+
+/*
+  Read the operator section with several threads. The section is split
+  into chunks at operator boundaries, each thread parses the operators of
+  one chunk into its own name arena, and the results are concatenated in
+  order, so the result is the same as for read_actions.
+*/
+static vector<ExplicitOperator> read_operators_in_parallel(
+    SasScanner& scanner,
+    string& names,
+    bool use_metric,
+    const vector<ExplicitVariable>& variables,
+    int num_threads)
+{
+    const char* buffer_end = scanner.get_end();
+    int count = scanner.read_int();
+    int max_threads = max(1, count / MIN_OPERATORS_PER_THREAD);
+    num_threads = min(num_threads, max_threads);
+
+    scanner.skip_whitespace();
+    const char* section_begin = scanner.get_position();
+    string_view rest(section_begin, buffer_end - section_begin);
+    vector<const char*> chunk_begin = {section_begin};
+    for (int i = 1; i < num_threads; ++i) {
+        const char* start =
+            find_operator_start(rest, rest.size() / num_threads * i);
+        if (!start || start <= chunk_begin.back()) break;
+        chunk_begin.push_back(start);
+    }
+    int num_chunks = chunk_begin.size();
+
+    vector<vector<ExplicitOperator>> chunk_operators(num_chunks);
+    vector<string> chunk_names(num_chunks);
+    vector<const char*> chunk_end(num_chunks);
+    auto read_chunk = [&](int chunk) {
+        SasScanner chunk_scanner(chunk_begin[chunk], buffer_end);
+        bool is_last = chunk == num_chunks - 1;
+        while (is_last ? chunk_scanner.peek_word() == "begin_operator"
+                       : chunk_scanner.peek_word().data() <
+                             chunk_begin[chunk + 1]) {
+            chunk_operators[chunk].emplace_back(
+                chunk_scanner,
+                chunk_names[chunk],
+                false,
+                use_metric);
+            check_facts(chunk_operators[chunk].back(), variables);
+        }
+        chunk_end[chunk] = chunk_scanner.get_position();
+    };
+    vector<thread> threads;
+    for (int chunk = 1; chunk < num_chunks; ++chunk)
+        threads.emplace_back(read_chunk, chunk);
+    read_chunk(0);
+    for (thread& t : threads) t.join();
+
+    // Each chunk must end exactly where the next one begins.
+    size_t num_operators = 0;
+    for (int chunk = 0; chunk < num_chunks; ++chunk) {
+        if (chunk + 1 < num_chunks) {
+            SasScanner chunk_scanner(chunk_end[chunk], buffer_end);
+            chunk_scanner.skip_whitespace();
+            if (chunk_scanner.get_position() != chunk_begin[chunk + 1]) {
+                cerr << "Operator "
+                     << num_operators + chunk_operators[chunk].size()
+                     << " does not start at an operator boundary." << endl;
+                utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+            }
+        }
+        num_operators += chunk_operators[chunk].size();
+    }
+    if (num_operators != static_cast<size_t>(count)) {
+        cerr << "Expected " << count << " operators, got " << num_operators
+             << "." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+
+    vector<ExplicitOperator> operators;
+    operators.reserve(count);
+    for (int chunk = 0; chunk < num_chunks; ++chunk) {
+        size_t offset = names.size();
+        names += chunk_names[chunk];
+        for (ExplicitOperator& op : chunk_operators[chunk]) {
+            op.name.begin += offset;
+            op.name.end += offset;
+            operators.push_back(std::move(op));
+        }
+    }
+    scanner = SasScanner(chunk_end.back(), buffer_end);
+    return operators;
+}
+
+RootTask::RootTask(SasScanner& scanner, int num_threads)
 {
-    read_and_verify_version(in);
-    bool use_metric = read_metric(in);
-    variables = read_variables(in);
+    read_and_verify_version(scanner);
+    bool use_metric = read_metric(scanner);
+    variables = read_variables(scanner, names);
     int num_variables = variables.size();
 
-    mutexes = read_mutexes(in, variables);
+    mutexes = read_mutexes(scanner, variables);
 
     initial_state_values.resize(num_variables);
-    check_magic(in, "begin_state");
+    scanner.check_magic("begin_state");
     for (int i = 0; i < num_variables; ++i) {
-        in >> initial_state_values[i];
+        initial_state_values[i] = scanner.read_int();
     }
-    check_magic(in, "end_state");
+    scanner.check_magic("end_state");
 
     for (int i = 0; i < num_variables; ++i) {
         variables[i].axiom_default_value = initial_state_values[i];
     }
 
-    goals = read_goal(in);
+    goals = read_goal(scanner);
     check_facts(goals, variables);
-    operators = read_actions(in, false, use_metric, variables);
-    axioms = read_actions(in, true, use_metric, variables);
+    if (num_threads > 1) {
+        operators = read_operators_in_parallel(
+            scanner,
+            names,
+            use_metric,
+            variables,
+            num_threads);
+    } else {
+        operators = read_actions(scanner, names, false, use_metric, variables);
+    }
+    axioms = read_actions(scanner, names, true, use_metric, variables);
+    names.shrink_to_fit();
 }
 
 const ExplicitVariable& RootTask::get_variable(int var) const
@@ -390,6 +645,11 @@ RootTask::get_operator_or_axiom(int index, bool is_axiom) const
     }
 }
 
+string RootTask::get_name(NameRange range) const
+{
+    return names.substr(range.begin, range.end - range.begin);
+}
+
 int RootTask::get_num_variables() const
 {
     return variables.size();
@@ -397,7 +657,7 @@ int RootTask::get_num_variables() const
 
 string RootTask::get_variable_name(int var) const
 {
-    return get_variable(var).name;
+    return get_name(get_variable(var).name);
 }
 
 int RootTask::get_variable_domain_size(int var) const
@@ -408,7 +668,7 @@ int RootTask::get_variable_domain_size(int var) const
 string RootTask::get_fact_name(const FactPair& fact) const
 {
     assert(utils::in_bounds(fact.value, get_variable(fact.var).fact_names));
-    return get_variable(fact.var).fact_names[fact.value];
+    return get_name(get_variable(fact.var).fact_names[fact.value]);
 }
 
 bool RootTask::are_facts_mutex(const FactPair& fact1, const FactPair& fact2)
@@ -420,7 +680,8 @@ bool RootTask::are_facts_mutex(const FactPair& fact1, const FactPair& fact2)
     }
     assert(utils::in_bounds(fact1.var, mutexes));
     assert(utils::in_bounds(fact1.value, mutexes[fact1.var]));
-    return bool(mutexes[fact1.var][fact1.value].count(fact2));
+    const vector<FactPair>& fact1_mutexes = mutexes[fact1.var][fact1.value];
+    return binary_search(fact1_mutexes.begin(), fact1_mutexes.end(), fact2);
 }
 
 int RootTask::get_num_operators() const
@@ -435,7 +696,7 @@ int RootTask::get_operator_cost(int index) const
 
 string RootTask::get_operator_name(int index) const
 {
-    return get_operator_or_axiom(index, false).name;
+    return get_name(get_operator_or_axiom(index, false).name);
 }
 
 int RootTask::get_num_operator_precondition_facts(int index) const
@@ -482,15 +743,535 @@ bool RootTask::is_undefined(const FactPair& /*fact*/) const
     return false;
 }
 
-std::unique_ptr<ClassicalTask> read_task_from_sas(std::istream& in)
+/*
+  A binary task file contains everything a RootTask exposes through the
+  ClassicalTask interface in flat arrays, so that later runs can map the
+  file into memory instead of parsing the translator output. The file
+  starts with a BinaryTaskHeader, followed by these arrays of 32-bit
+  integers (in the byte order of the machine that wrote the file):
+
+    domain_sizes           num_variables
+    initial_state          num_variables
+    goals                  num_goals pairs of variable and value
+    costs                  num_operators
+    precondition_offsets   num_operators + 1
+    preconditions          num_preconditions pairs of variable and value
+    effect_offsets         num_operators + 1
+    effects                num_effects pairs of variable and value
+    mutex_offsets          num_facts + 1
+    mutexes                num_mutexes fact IDs
+    name_offsets           num_variables + num_facts + num_operators + 1
+    byte_code              byte_code_size
+
+  The file ends with the name_size characters of the variable names, fact
+  names and operator names, in this order. Facts are numbered consecutively
+  by variable and value, and the preconditions of operator i are
+  preconditions[precondition_offsets[i]], ...,
+  preconditions[precondition_offsets[i + 1] - 1] (likewise for effects,
+  mutexes and names). The facts that are mutex with a fact are sorted by ID.
+
+  byte_code is the byte code of the successor generator as returned by
+  SuccessorGenerator::get_byte_code, or empty. Axioms and effect conditions
+  are not stored since the ClassicalTask interface does not expose them.
+*/
+static const char BINARY_TASK_MAGIC[8] = {'F', 'D', 'T', 'A', 'S', 'K', 0, 0};
+static const int32_t BINARY_TASK_VERSION = 1;
+
+struct BinaryTaskHeader {
+    char magic[8];
+    int32_t version;
+    int32_t num_variables;
+    int32_t num_facts;
+    int32_t num_goals;
+    int32_t num_operators;
+    int32_t num_preconditions;
+    int32_t num_effects;
+    int32_t num_mutexes;
+    int32_t byte_code_size;
+    int32_t name_size;
+};
+
+static_assert(sizeof(FactPair) == 2 * sizeof(int32_t));
+static_assert(sizeof(int) == sizeof(int32_t));
+
+template <typename T>
+static void write_array(ostream& out, const vector<T>& array)
 {
-    return make_unique<RootTask>(in);
+    out.write(
+        reinterpret_cast<const char*>(array.data()),
+        array.size() * sizeof(T));
 }
 
-void read_root_task(istream& in)
+void RootTask::write_binary(ostream& out) const
+{
+    vector<int> domain_sizes;
+    vector<int> fact_offsets;
+    int num_facts = 0;
+    for (const ExplicitVariable& var : variables) {
+        domain_sizes.push_back(var.domain_size);
+        fact_offsets.push_back(num_facts);
+        num_facts += var.domain_size;
+    }
+
+    vector<int> costs;
+    vector<int> precondition_offsets = {0};
+    vector<FactPair> preconditions;
+    vector<int> effect_offsets = {0};
+    vector<FactPair> effects;
+    for (const ExplicitOperator& op : operators) {
+        costs.push_back(op.cost);
+        preconditions.insert(
+            preconditions.end(),
+            op.preconditions.begin(),
+            op.preconditions.end());
+        precondition_offsets.push_back(preconditions.size());
+        for (const ExplicitEffect& eff : op.effects)
+            effects.push_back(eff.fact);
+        effect_offsets.push_back(effects.size());
+    }
+
+    // The mutexes are sorted by variable and value and hence by fact ID.
+    vector<int> mutex_offsets = {0};
+    vector<int> mutex_facts;
+    for (const vector<vector<FactPair>>& var_mutexes : mutexes) {
+        for (const vector<FactPair>& fact_mutexes : var_mutexes) {
+            for (const FactPair& fact : fact_mutexes)
+                mutex_facts.push_back(fact_offsets[fact.var] + fact.value);
+            mutex_offsets.push_back(mutex_facts.size());
+        }
+    }
+
+    vector<int> name_offsets = {0};
+    string binary_names;
+    auto add_binary_name = [&](NameRange range) {
+        binary_names.append(names, range.begin, range.end - range.begin);
+        if (binary_names.size() > INT_MAX) {
+            cerr << "Task names are too long for a binary task file." << endl;
+            utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+        }
+        name_offsets.push_back(binary_names.size());
+    };
+    for (const ExplicitVariable& var : variables) add_binary_name(var.name);
+    for (const ExplicitVariable& var : variables) {
+        for (NameRange fact_name : var.fact_names) add_binary_name(fact_name);
+    }
+    for (const ExplicitOperator& op : operators) add_binary_name(op.name);
+
+    vector<int> byte_code =
+        successor_generator::SuccessorGenerator(
+            ClassicalTaskProxy(*this),
+            successor_generator::Representation::BYTE_CODE)
+            .get_byte_code();
+
+    BinaryTaskHeader header;
+    memcpy(header.magic, BINARY_TASK_MAGIC, sizeof(header.magic));
+    header.version = BINARY_TASK_VERSION;
+    header.num_variables = variables.size();
+    header.num_facts = num_facts;
+    header.num_goals = goals.size();
+    header.num_operators = operators.size();
+    header.num_preconditions = preconditions.size();
+    header.num_effects = effects.size();
+    header.num_mutexes = mutex_facts.size();
+    header.byte_code_size = byte_code.size();
+    header.name_size = binary_names.size();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    write_array(out, domain_sizes);
+    write_array(out, initial_state_values);
+    write_array(out, goals);
+    write_array(out, costs);
+    write_array(out, precondition_offsets);
+    write_array(out, preconditions);
+    write_array(out, effect_offsets);
+    write_array(out, effects);
+    write_array(out, mutex_offsets);
+    write_array(out, mutex_facts);
+    write_array(out, name_offsets);
+    write_array(out, byte_code);
+    out.write(binary_names.data(), binary_names.size());
+}
+
+/*
+  A read-only view of a file. Where memory-mapped files are not supported,
+  the file is read into memory instead.
+*/
+class MappedFile {
+    const char* data;
+    size_t size;
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+    void* address;
+#else
+    vector<char> buffer;
+#endif
+
+public:
+    explicit MappedFile(const string& filename);
+    ~MappedFile();
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const char* get_data() const { return data; }
+    size_t get_size() const { return size; }
+};
+
+#if OPERATING_SYSTEM == LINUX || OPERATING_SYSTEM == OSX
+MappedFile::MappedFile(const string& filename)
+    : data(nullptr)
+    , size(0)
+    , address(MAP_FAILED)
+{
+    int file_descriptor = open(filename.c_str(), O_RDONLY);
+    struct stat file_status;
+    if (file_descriptor == -1 || fstat(file_descriptor, &file_status) == -1) {
+        cerr << "Could not open " << filename << ": " << strerror(errno)
+             << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    size = file_status.st_size;
+    if (size > 0) {
+        address =
+            mmap(nullptr, size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    }
+    // The mapping stays valid after closing the file.
+    close(file_descriptor);
+    if (size > 0 && address == MAP_FAILED) {
+        cerr << "Could not map " << filename << ": " << strerror(errno)
+             << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    data = static_cast<const char*>(address);
+}
+
+MappedFile::~MappedFile()
+{
+    if (address != MAP_FAILED) munmap(address, size);
+}
+#else
+MappedFile::MappedFile(const string& filename)
+{
+    ifstream in(filename, ios::binary);
+    if (!in) {
+        cerr << "Could not open " << filename << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    buffer.assign(istreambuf_iterator<char>(in), istreambuf_iterator<char>());
+    data = buffer.data();
+    size = buffer.size();
+}
+
+MappedFile::~MappedFile()
+{
+}
+#endif
+
+/*
+  A task read from a binary task file. All data stays in the mapped file
+  and is accessed in place, so loading the task takes time independent of
+  its size.
+*/
+class BinaryTask : public ClassicalTask {
+    MappedFile file;
+    BinaryTaskHeader header;
+    const int* domain_sizes;
+    const int* initial_state_values;
+    const FactPair* goals;
+    const int* costs;
+    const int* precondition_offsets;
+    const FactPair* preconditions;
+    const int* effect_offsets;
+    const FactPair* effects;
+    const int* mutex_offsets;
+    const int* mutexes;
+    const int* name_offsets;
+    const int* byte_code;
+    const char* names;
+    // Not stored in the file because it is cheap to compute.
+    vector<int> fact_offsets;
+
+    int get_fact_id(const FactPair& fact) const
+    {
+        return fact_offsets[fact.var] + fact.value;
+    }
+
+    string get_name(int index) const
+    {
+        return string(
+            names + name_offsets[index],
+            names + name_offsets[index + 1]);
+    }
+
+public:
+    explicit BinaryTask(const string& filename);
+
+    vector<int> get_byte_code() const
+    {
+        return vector<int>(byte_code, byte_code + header.byte_code_size);
+    }
+
+    virtual int get_num_variables() const override;
+    virtual string get_variable_name(int var) const override;
+    virtual int get_variable_domain_size(int var) const override;
+    virtual string get_fact_name(const FactPair& fact) const override;
+    virtual bool are_facts_mutex(const FactPair& fact1, const FactPair& fact2)
+        const override;
+
+    virtual int get_num_operators() const override;
+
+    virtual int get_operator_cost(int index) const override;
+    virtual string get_operator_name(int index) const override;
+    virtual int get_num_operator_precondition_facts(int index) const override;
+    virtual FactPair
+    get_operator_precondition_fact(int op_index, int fact_index) const override;
+    virtual int get_num_operator_effect_facts(int op_index) const override;
+    virtual FactPair
+    get_operator_effect_fact(int op_index, int eff_index) const override;
+
+    virtual int get_num_goal_facts() const override;
+    virtual FactPair get_goal_fact(int index) const override;
+
+    virtual vector<int> get_initial_state_values() const override;
+
+    virtual bool is_undefined(const FactPair& fact) const override;
+};
+
+static void exit_with_corrupt_binary_task(const string& filename)
+{
+    cerr << filename << " is not a binary task file of version "
+         << BINARY_TASK_VERSION << "." << endl;
+    utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+}
+
+BinaryTask::BinaryTask(const string& filename)
+    : file(filename)
+{
+    if (file.get_size() < sizeof(header)) {
+        exit_with_corrupt_binary_task(filename);
+    }
+    memcpy(&header, file.get_data(), sizeof(header));
+    if (memcmp(header.magic, BINARY_TASK_MAGIC, sizeof(header.magic)) != 0 ||
+        header.version != BINARY_TASK_VERSION) {
+        exit_with_corrupt_binary_task(filename);
+    }
+
+    size_t num_ints = 2 * size_t(header.num_variables) +
+                      2 * size_t(header.num_goals) +
+                      3 * size_t(header.num_operators) + 2 +
+                      2 * size_t(header.num_preconditions) +
+                      2 * size_t(header.num_effects) +
+                      size_t(header.num_facts) + 1 +
+                      size_t(header.num_mutexes) +
+                      size_t(header.num_variables) +
+                      size_t(header.num_facts) +
+                      size_t(header.num_operators) + 1 +
+                      size_t(header.byte_code_size);
+    if (file.get_size() !=
+        sizeof(header) + num_ints * sizeof(int) + header.name_size) {
+        exit_with_corrupt_binary_task(filename);
+    }
+
+    const int* next = reinterpret_cast<const int*>(
+        file.get_data() + sizeof(header));
+    auto take_ints = [&](size_t count) {
+        const int* array = next;
+        next += count;
+        return array;
+    };
+    auto take_facts = [&](size_t count) {
+        return reinterpret_cast<const FactPair*>(take_ints(2 * count));
+    };
+    domain_sizes = take_ints(header.num_variables);
+    initial_state_values = take_ints(header.num_variables);
+    goals = take_facts(header.num_goals);
+    costs = take_ints(header.num_operators);
+    precondition_offsets = take_ints(header.num_operators + 1);
+    preconditions = take_facts(header.num_preconditions);
+    effect_offsets = take_ints(header.num_operators + 1);
+    effects = take_facts(header.num_effects);
+    mutex_offsets = take_ints(header.num_facts + 1);
+    mutexes = take_ints(header.num_mutexes);
+    name_offsets = take_ints(
+        header.num_variables + header.num_facts + header.num_operators + 1);
+    byte_code = take_ints(header.byte_code_size);
+    names = reinterpret_cast<const char*>(next);
+
+    int num_facts = 0;
+    for (int var = 0; var < header.num_variables; ++var) {
+        fact_offsets.push_back(num_facts);
+        num_facts += domain_sizes[var];
+    }
+}
+
+int BinaryTask::get_num_variables() const
+{
+    return header.num_variables;
+}
+
+string BinaryTask::get_variable_name(int var) const
+{
+    assert(var >= 0 && var < header.num_variables);
+    return get_name(var);
+}
+
+int BinaryTask::get_variable_domain_size(int var) const
+{
+    assert(var >= 0 && var < header.num_variables);
+    return domain_sizes[var];
+}
+
+string BinaryTask::get_fact_name(const FactPair& fact) const
+{
+    assert(fact.value >= 0 && fact.value < get_variable_domain_size(fact.var));
+    return get_name(header.num_variables + get_fact_id(fact));
+}
+
+bool BinaryTask::are_facts_mutex(const FactPair& fact1, const FactPair& fact2)
+    const
+{
+    if (fact1.var == fact2.var) {
+        // Same variable: mutex iff different value.
+        return fact1.value != fact2.value;
+    }
+    int id1 = get_fact_id(fact1);
+    return binary_search(
+        mutexes + mutex_offsets[id1],
+        mutexes + mutex_offsets[id1 + 1],
+        get_fact_id(fact2));
+}
+
+int BinaryTask::get_num_operators() const
+{
+    return header.num_operators;
+}
+
+int BinaryTask::get_operator_cost(int index) const
+{
+    assert(index >= 0 && index < header.num_operators);
+    return costs[index];
+}
+
+string BinaryTask::get_operator_name(int index) const
+{
+    assert(index >= 0 && index < header.num_operators);
+    return get_name(header.num_variables + header.num_facts + index);
+}
+
+int BinaryTask::get_num_operator_precondition_facts(int index) const
+{
+    assert(index >= 0 && index < header.num_operators);
+    return precondition_offsets[index + 1] - precondition_offsets[index];
+}
+
+FactPair
+BinaryTask::get_operator_precondition_fact(int op_index, int fact_index) const
+{
+    assert(
+        fact_index >= 0 &&
+        fact_index < get_num_operator_precondition_facts(op_index));
+    return preconditions[precondition_offsets[op_index] + fact_index];
+}
+
+int BinaryTask::get_num_operator_effect_facts(int op_index) const
+{
+    assert(op_index >= 0 && op_index < header.num_operators);
+    return effect_offsets[op_index + 1] - effect_offsets[op_index];
+}
+
+FactPair BinaryTask::get_operator_effect_fact(int op_index, int eff_index)
+    const
+{
+    assert(
+        eff_index >= 0 && eff_index < get_num_operator_effect_facts(op_index));
+    return effects[effect_offsets[op_index] + eff_index];
+}
+
+int BinaryTask::get_num_goal_facts() const
+{
+    return header.num_goals;
+}
+
+FactPair BinaryTask::get_goal_fact(int index) const
+{
+    assert(index >= 0 && index < header.num_goals);
+    return goals[index];
+}
+
+vector<int> BinaryTask::get_initial_state_values() const
+{
+    return vector<int>(
+        initial_state_values,
+        initial_state_values + header.num_variables);
+}
+
+bool BinaryTask::is_undefined(const FactPair& /*fact*/) const
+{
+    return false;
+}
+
+static string read_all(istream& in)
+{
+    static const size_t CHUNK_SIZE = 1 << 20;
+    string buffer;
+    size_t size = 0;
+    while (true) {
+        buffer.resize(size + CHUNK_SIZE);
+        size_t num_read = in.rdbuf()->sgetn(buffer.data() + size, CHUNK_SIZE);
+        size += num_read;
+        if (num_read < CHUNK_SIZE) break;
+    }
+    buffer.resize(size);
+    return buffer;
+}
+
+std::unique_ptr<ClassicalTask>
+read_task_from_sas(std::istream& in, int num_threads)
+{
+    string buffer = read_all(in);
+    SasScanner scanner(buffer.data(), buffer.data() + buffer.size());
+    return make_unique<RootTask>(scanner, num_threads);
+}
+
+void read_root_task(istream& in, int num_threads)
 {
     assert(!g_root_task);
-    g_root_task = read_task_from_sas(in);
+    g_root_task = read_task_from_sas(in, num_threads);
+}
+
+std::unique_ptr<ClassicalTask> read_task_from_binary(const string& filename)
+{
+    return make_unique<BinaryTask>(filename);
+}
+
+void read_root_task_from_binary(const string& filename)
+{
+    assert(!g_root_task);
+    auto task = make_shared<BinaryTask>(filename);
+    vector<int> byte_code = task->get_byte_code();
+    g_root_task = task;
+    if (!byte_code.empty()) {
+        successor_generator::g_byte_code_successor_generators.set(
+            ClassicalTaskProxy(*g_root_task),
+            make_unique<successor_generator::SuccessorGenerator>(
+                std::move(byte_code)));
+    }
+}
+
+void write_binary_task(const ClassicalTask& task, const string& filename)
+{
+    const RootTask* root_task = dynamic_cast<const RootTask*>(&task);
+    if (!root_task) {
+        cerr << "Only tasks read from translator output can be written to "
+             << "a binary task file." << endl;
+        utils::exit_with(ExitCode::SEARCH_INPUT_ERROR);
+    }
+    ofstream out(filename, ios::binary);
+    root_task->write_binary(out);
+    out.close();
+    if (!out) {
+        cerr << "Could not write " << filename << ": " << strerror(errno)
+             << endl;
+        utils::exit_with(ExitCode::SEARCH_CRITICAL_ERROR);
+    }
 }
 
 static shared_ptr<ClassicalTask> _parse(OptionParser& parser)
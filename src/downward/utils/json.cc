@@ -0,0 +1,121 @@
+#include "downward/utils/json.h"
+
+#include <charconv>
+#include <cmath>
+#include <cstdio>
+
+using namespace std;
+
+namespace utils {
+JsonWriter::JsonWriter(ostream& os)
+    : os(os)
+    , needs_comma(false)
+{
+}
+
+void JsonWriter::write_separator()
+{
+    if (needs_comma) os << ',';
+    needs_comma = true;
+}
+
+void JsonWriter::begin_object()
+{
+    write_separator();
+    os << '{';
+    needs_comma = false;
+}
+
+void JsonWriter::end_object()
+{
+    os << '}';
+    needs_comma = true;
+}
+
+void JsonWriter::begin_array()
+{
+    write_separator();
+    os << '[';
+    needs_comma = false;
+}
+
+void JsonWriter::end_array()
+{
+    os << ']';
+    needs_comma = true;
+}
+
+void JsonWriter::key(string_view name)
+{
+    value(name);
+    os << ':';
+    needs_comma = false;
+}
+
+void JsonWriter::value(int value)
+{
+    write_separator();
+    os << value;
+}
+
+void JsonWriter::value(long long value)
+{
+    write_separator();
+    os << value;
+}
+
+void JsonWriter::value(size_t value)
+{
+    write_separator();
+    os << value;
+}
+
+void JsonWriter::value(double value)
+{
+    if (!isfinite(value)) {
+        null();
+        return;
+    }
+    write_separator();
+    // Shortest representation that reads back as the same double.
+    char buffer[32];
+    auto result = to_chars(buffer, buffer + sizeof(buffer), value);
+    os.write(buffer, result.ptr - buffer);
+}
+
+void JsonWriter::value(bool value)
+{
+    write_separator();
+    os << (value ? "true" : "false");
+}
+
+void JsonWriter::value(string_view value)
+{
+    write_separator();
+    os << '"';
+    for (char c : value) {
+        switch (c) {
+        case '"': os << "\\\""; break;
+        case '\\': os << "\\\\"; break;
+        case '\n': os << "\\n"; break;
+        case '\r': os << "\\r"; break;
+        case '\t': os << "\\t"; break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                char buffer[8];
+                snprintf(buffer, sizeof(buffer), "\\u%04x", c);
+                os << buffer;
+            } else {
+                os << c;
+            }
+        }
+    }
+    os << '"';
+}
+
+void JsonWriter::null()
+{
+    write_separator();
+    os << "null";
+}
+} // namespace utils
@@ -64,14 +64,23 @@ NetworkHeuristic::compute_results(vector<EvaluationContext>& eval_contexts)
         bool calculate_preferred =
             eval_contexts[idx_ec].get_calculate_preferred();
 
-        if (!calculate_preferred && heuristic_cache[state].h != NO_VALUE &&
-            !heuristic_cache[state].dirty) {
-            old_heuristics.push_back(heuristic_cache[state].h);
+        int cached_heuristic = NO_VALUE;
+        if (!calculate_preferred && cache_evaluator_values) {
+            auto entry = heuristic_cache[state];
+            if (!entry.is_dirty()) {
+                cached_heuristic = entry.get_value();
+            }
+        }
+
+        if (cached_heuristic != NO_VALUE) {
+            old_heuristics.push_back(cached_heuristic);
         } else if (
             !calculate_preferred &&
             task_properties::is_goal_state(task_proxy, state)) {
             old_heuristics.push_back(0);
-            heuristic_cache[state] = HEntry(0, false);
+            if (cache_evaluator_values) {
+                heuristic_cache[state].set_value(0);
+            }
         } else {
             old_heuristics.push_back(NO_VALUE);
             eval_states.push_back(state);
@@ -86,8 +95,10 @@ NetworkHeuristic::compute_results(vector<EvaluationContext>& eval_contexts)
         int heuristic;
         if (old_heuristics[idx_ec] == NO_VALUE) {
             heuristic = network->get_heuristics()[idx_evaluated_states];
-            heuristic_cache[eval_contexts[idx_ec].get_state()] =
-                HEntry(heuristic, false);
+            if (cache_evaluator_values) {
+                heuristic_cache[eval_contexts[idx_ec].get_state()].set_value(
+                    heuristic);
+            }
 
             if (network->is_preferred() && heuristic != DEAD_END) {
 
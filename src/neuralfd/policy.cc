@@ -6,17 +6,27 @@
 #include "downward/option_parser.h"
 #include "downward/plugin.h"
 
+#include "downward/algorithms/indexed_cache.h"
 #include "downward/task_utils/task_properties.h"
 #include "downward/tasks/cost_adapted_task.h"
 
 #include <cassert>
 #include <cstdlib>
 #include <limits>
+#include <memory>
 
 using namespace std;
 
+static const shared_ptr<indexed_cache::IdPool>& get_policy_ids()
+{
+    static const shared_ptr<indexed_cache::IdPool> policy_ids =
+        make_shared<indexed_cache::IdPool>();
+    return policy_ids;
+}
+
 Policy::Policy(const Options& opts)
-    : policy_cache(PEntry())
+    : id(get_policy_ids())
+    , policy_cache(PEntry())
     , cache_policy_values(opts.get<bool>("cache_estimates"))
     , task(opts.get<shared_ptr<ClassicalTask>>("transform"))
     , task_proxy(*task)
@@ -1,5 +1,7 @@
 #include "neuralfd/policy_cache.h"
 
+#include "neuralfd/policy.h"
+
 using namespace std;
 
 PolicyResult& PolicyCache::operator[](Policy* policy)
@@ -0,0 +1,338 @@
+#include "neuralfd/search_algorithms/bidirectional_search.h"
+
+#include "downward/evaluation_result.h"
+#include "downward/option_parser.h"
+
+#include "downward/utils/json.h"
+#include "downward/utils/logging.h"
+
+#include <cassert>
+
+using namespace std;
+
+namespace bidirectional_search {
+using partial_state_index::PartialStateIndex;
+
+BidirectionalSearch::BidirectionalSearch(const Options& opts)
+    : BidirectionalSearch(
+          opts.get<shared_ptr<ClassicalTask>>("transform"),
+          utils::get_log_from_options(opts),
+          opts.get<OperatorCost>("cost_type"),
+          opts.get<double>("max_time"),
+          opts.get<int>("bound"),
+          opts.get<bool>("prune_mutexes"),
+          opts.get<SearchNodeStorage>("search_node_storage"),
+          create_mapped_state_storage(opts),
+          opts.get<int_packer::Encoding>("state_encoding"),
+          opts.get<successor_generator::Representation>(
+              "successor_generator"))
+{
+    read_statistics_options(opts);
+}
+
+BidirectionalSearch::BidirectionalSearch(
+    shared_ptr<ClassicalTask> task,
+    utils::LogProxy log,
+    OperatorCost cost_type,
+    double max_time,
+    int bound,
+    bool prune_mutexes,
+    SearchNodeStorage node_storage,
+    shared_ptr<mapped_segment_allocator::MappedArena> mapped_memory,
+    int_packer::Encoding state_encoding,
+    successor_generator::Representation successor_generator_representation)
+    : SearchAlgorithm(
+          task,
+          log,
+          cost_type,
+          max_time,
+          bound,
+          node_storage,
+          std::move(mapped_memory),
+          state_encoding,
+          successor_generator_representation)
+    , regression_task_proxy(*task)
+    , predecessor_generator(regression_task_proxy)
+    , prune_mutexes(prune_mutexes)
+    , forward_index(task->get_num_variables())
+    , num_forward_expansions(0)
+    , backward_index(task->get_num_variables())
+    , num_backward_expansions(0)
+    , num_mutex_pruned(0)
+    , best_cost(EvaluationResult::INFTY)
+    , meet_forward(PartialStateIndex::NO_ENTRY)
+    , meet_backward(PartialStateIndex::NO_ENTRY)
+{
+}
+
+void BidirectionalSearch::initialize()
+{
+    if (log.is_at_least_normal()) {
+        log << "Conducting bidirectional search, (real) bound = " << bound
+            << endl;
+    }
+
+    PartialAssignment goal = regression_task_proxy.get_goal_assignment();
+    add_backward_node(
+        vector<int>(goal.get_values()),
+        0,
+        0,
+        -1,
+        OperatorID::no_operator);
+
+    const State& initial_state = state_registry.get_initial_state();
+    search_space.get_node(initial_state).open_initial();
+    add_forward_node(initial_state, 0, 0);
+}
+
+void BidirectionalSearch::add_forward_node(
+    const State& state,
+    int g,
+    int real_g)
+{
+    int entry = forward_states.size();
+    forward_states.push_back(state.get_id());
+    forward_open.emplace(g, entry);
+    const vector<int>& values = state.get_unpacked_values();
+    forward_index.insert(values, entry, g);
+
+    pair<int, int> match =
+        backward_index.find_cheapest_generalization(values, best_cost - g);
+    if (match.first != PartialStateIndex::NO_ENTRY &&
+        real_g + backward_nodes[match.first].real_g < bound) {
+        report_meet(entry, match.first, g + match.second);
+    }
+}
+
+void BidirectionalSearch::add_backward_node(
+    vector<int>&& values,
+    int g,
+    int real_g,
+    int parent,
+    OperatorID op_id)
+{
+    auto [it, inserted] =
+        backward_ids.try_emplace(std::move(values), backward_nodes.size());
+    int id = it->second;
+    if (inserted) {
+        backward_nodes.push_back(
+            BackwardNode{&it->first, g, real_g, parent, op_id, false});
+    } else {
+        BackwardNode& node = backward_nodes[id];
+        if (node.closed || g >= node.g) {
+            return;
+        }
+        node.g = g;
+        node.real_g = real_g;
+        node.parent = parent;
+        node.op_id = op_id;
+    }
+    backward_open.emplace(g, id);
+    const vector<int>& partial_state = it->first;
+    backward_index.insert(partial_state, id, g);
+
+    pair<int, int> match = forward_index.find_cheapest_specialization(
+        partial_state,
+        best_cost - g);
+    if (match.first != PartialStateIndex::NO_ENTRY) {
+        State state = state_registry.lookup_state(forward_states[match.first]);
+        if (search_space.get_node(state).get_real_g() + real_g < bound) {
+            report_meet(match.first, id, g + match.second);
+        }
+    }
+}
+
+void BidirectionalSearch::report_meet(
+    int forward_entry,
+    int backward_id,
+    int cost)
+{
+    assert(cost < best_cost);
+    best_cost = cost;
+    meet_forward = forward_entry;
+    meet_backward = backward_id;
+    if (log.is_at_least_normal()) {
+        log << "Found plan of cost " << cost << " [" << num_forward_expansions
+            << " forward, " << num_backward_expansions
+            << " backward expansions]" << endl;
+    }
+}
+
+bool BidirectionalSearch::prune_stale_forward_entries()
+{
+    while (!forward_open.empty()) {
+        auto [g, entry] = forward_open.top();
+        State state = state_registry.lookup_state(forward_states[entry]);
+        SearchNode node = search_space.get_node(state);
+        if (!node.is_closed() && node.get_g() == g) {
+            return true;
+        }
+        forward_open.pop();
+    }
+    return false;
+}
+
+bool BidirectionalSearch::prune_stale_backward_entries()
+{
+    while (!backward_open.empty()) {
+        auto [g, id] = backward_open.top();
+        const BackwardNode& node = backward_nodes[id];
+        if (!node.closed && node.g == g) {
+            return true;
+        }
+        backward_open.pop();
+    }
+    return false;
+}
+
+void BidirectionalSearch::expand_forward()
+{
+    int entry = forward_open.top().second;
+    forward_open.pop();
+    State state = state_registry.lookup_state(forward_states[entry]);
+    SearchNode node = search_space.get_node(state);
+    node.close();
+    ++num_forward_expansions;
+    statistics.inc_expanded();
+
+    vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(state, applicable_ops);
+    for (OperatorID op_id : applicable_ops) {
+        int succ_real_g = node.get_real_g() + compiled_task.get_cost(op_id);
+        if (succ_real_g >= bound) continue;
+
+        State succ_state = state_registry.get_successor_state(
+            state,
+            compiled_task.get_effects(op_id));
+        statistics.inc_generated();
+        SearchNode succ_node = search_space.get_node(succ_state);
+        OperatorProxy op = task_proxy.get_operators()[op_id];
+        int adjusted_cost = get_adjusted_cost(op_id);
+        int succ_g = node.get_g() + adjusted_cost;
+
+        if (succ_node.is_new()) {
+            succ_node.open(node, op, adjusted_cost);
+        } else if (succ_node.is_open() && succ_g < succ_node.get_g()) {
+            succ_node.update_parent(node, op, adjusted_cost);
+        } else {
+            continue;
+        }
+        add_forward_node(succ_state, succ_g, succ_real_g);
+    }
+}
+
+void BidirectionalSearch::expand_backward()
+{
+    int id = backward_open.top().second;
+    backward_open.pop();
+    BackwardNode& node = backward_nodes[id];
+    node.closed = true;
+    int g = node.g;
+    int real_g = node.real_g;
+    PartialAssignment partial_state(*task, vector<int>(*node.values));
+    ++num_backward_expansions;
+    statistics.inc_expanded();
+
+    vector<OperatorID> applicable_ops;
+    predecessor_generator.generate_applicable_ops(
+        partial_state,
+        applicable_ops);
+    for (OperatorID op_id : applicable_ops) {
+        int pred_real_g = real_g + compiled_task.get_cost(op_id);
+        if (pred_real_g >= bound) continue;
+
+        RegressionOperatorProxy op =
+            regression_task_proxy.get_regression_operator(op_id);
+        assert(op.is_applicable(partial_state));
+        PartialAssignment pred = op.get_anonym_predecessor(partial_state);
+        statistics.inc_generated();
+        if (prune_mutexes && pred.violates_mutexes()) {
+            ++num_mutex_pruned;
+            continue;
+        }
+        add_backward_node(
+            vector<int>(pred.get_values()),
+            g + get_adjusted_cost(op_id),
+            pred_real_g,
+            id,
+            op_id);
+    }
+}
+
+SearchStatus BidirectionalSearch::finish()
+{
+    if (best_cost == EvaluationResult::INFTY) {
+        log << "Completely explored state space -- no solution!" << endl;
+        return FAILED;
+    }
+
+    if (log.is_at_least_normal()) log << "Solution found!" << endl;
+    Plan plan;
+    State meet_state =
+        state_registry.lookup_state(forward_states[meet_forward]);
+    search_space.trace_path(meet_state, plan);
+    for (int id = meet_backward; backward_nodes[id].parent != -1;
+         id = backward_nodes[id].parent) {
+        plan.push_back(backward_nodes[id].op_id);
+    }
+    set_plan(plan);
+    return SOLVED;
+}
+
+SearchStatus BidirectionalSearch::step()
+{
+    bool forward_has_open_nodes = prune_stale_forward_entries();
+    bool backward_has_open_nodes = prune_stale_backward_entries();
+    if (!forward_has_open_nodes || !backward_has_open_nodes) {
+        return finish();
+    }
+
+    int lower_bound = forward_open.top().first + backward_open.top().first;
+    if (best_cost <= lower_bound) {
+        return finish();
+    }
+    statistics.report_f_value_progress(lower_bound);
+
+    if (forward_open.size() <= backward_open.size()) {
+        expand_forward();
+    } else {
+        expand_backward();
+    }
+    return IN_PROGRESS;
+}
+
+void BidirectionalSearch::write_statistics_json(utils::JsonWriter& json) const
+{
+    SearchAlgorithm::write_statistics_json(json);
+    json.key("forward_expansions");
+    json.value(num_forward_expansions);
+    json.key("backward_expansions");
+    json.value(num_backward_expansions);
+    json.key("backward_nodes");
+    json.value(backward_nodes.size());
+    json.key("mutex_pruned");
+    json.value(num_mutex_pruned);
+}
+
+void BidirectionalSearch::print_statistics() const
+{
+    statistics.print_detailed_statistics();
+    search_space.print_statistics();
+    log << "Forward expansions: " << num_forward_expansions << endl;
+    log << "Backward expansions: " << num_backward_expansions << endl;
+    log << "Backward nodes: " << backward_nodes.size() << endl;
+    log << "Predecessors pruned by mutexes: " << num_mutex_pruned << endl;
+    log << "Partial state index nodes: "
+        << forward_index.get_num_nodes() + backward_index.get_num_nodes()
+        << endl;
+}
+
+void add_options_to_parser(OptionParser& parser)
+{
+    parser.add_option<bool>(
+        "prune_mutexes",
+        "prune partial states of the backward search that violate a mutex",
+        "true");
+    SearchAlgorithm::add_options_to_parser(parser);
+}
+} // namespace bidirectional_search
@@ -0,0 +1,38 @@
+#include "neuralfd/search_algorithms/bidirectional_search.h"
+
+#include "downward/option_parser.h"
+#include "downward/plugin.h"
+
+using namespace std;
+
+namespace plugin_bidirectional {
+static shared_ptr<SearchAlgorithm> _parse(OptionParser& parser)
+{
+    parser.document_synopsis(
+        "Bidirectional search",
+        "Bidirectional uniform-cost search. The forward direction searches "
+        "from the initial state, the backward direction regresses the goal "
+        "to partial states. The search stops once the cheapest plan found "
+        "where the two directions meet is no more expensive than the sum of "
+        "the smallest g values of the open lists of both directions, so "
+        "the plan is optimal.");
+    parser.document_note(
+        "Supported tasks",
+        "Regression does not support conditional effects. Since partial "
+        "states generated by regression need not be reachable, the backward "
+        "direction can be much larger than the forward one; pruning partial "
+        "states that violate mutexes helps here.");
+
+    bidirectional_search::add_options_to_parser(parser);
+    Options opts = parser.parse();
+
+    shared_ptr<bidirectional_search::BidirectionalSearch> algorithm;
+    if (!parser.dry_run()) {
+        algorithm =
+            make_shared<bidirectional_search::BidirectionalSearch>(opts);
+    }
+    return algorithm;
+}
+
+static Plugin<SearchAlgorithm> _plugin("bidirectional", _parse);
+} // namespace plugin_bidirectional
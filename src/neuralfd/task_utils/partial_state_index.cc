@@ -0,0 +1,200 @@
+#include "neuralfd/task_utils/partial_state_index.h"
+
+#include "downward/state.h"
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+using namespace std;
+
+namespace partial_state_index {
+PartialStateIndex::Node::Node()
+    : min_cost(numeric_limits<int>::max())
+    , entry(NO_ENTRY)
+{
+}
+
+int PartialStateIndex::Node::get_child(int value) const
+{
+    for (const pair<int, int>& child : children) {
+        if (child.first == value) {
+            return child.second;
+        }
+    }
+    return -1;
+}
+
+PartialStateIndex::PartialStateIndex(int num_variables)
+    : num_variables(num_variables)
+    , nodes(1)
+    , num_entries(0)
+{
+}
+
+int PartialStateIndex::add_leaf(
+    const vector<int>& values,
+    int first,
+    int entry,
+    int cost)
+{
+    int node_id = nodes.size();
+    nodes.emplace_back();
+    Node& node = nodes.back();
+    node.min_cost = cost;
+    node.entry = entry;
+    node.tail.assign(values.begin() + first, values.end());
+    return node_id;
+}
+
+void PartialStateIndex::insert(const vector<int>& values, int entry, int cost)
+{
+    assert(static_cast<int>(values.size()) == num_variables);
+    if (num_entries == 0) {
+        nodes.clear();
+        add_leaf(values, 0, entry, cost);
+        ++num_entries;
+        return;
+    }
+
+    int node_id = 0;
+    int var = 0;
+    while (true) {
+        Node& node = nodes[node_id];
+        if (node.entry != NO_ENTRY) {
+            if (equal(
+                    node.tail.begin(),
+                    node.tail.end(),
+                    values.begin() + var)) {
+                if (cost < node.min_cost) {
+                    node.entry = entry;
+                    node.min_cost = cost;
+                }
+                break;
+            }
+            // Split the leaf: move its assignment one level down.
+            assert(var < num_variables);
+            vector<int> tail = std::move(node.tail);
+            int old_entry = node.entry;
+            int old_cost = node.min_cost;
+            node.tail = vector<int>();
+            node.entry = NO_ENTRY;
+            int child_id = add_leaf(tail, 1, old_entry, old_cost);
+            nodes[node_id].children.emplace_back(tail.front(), child_id);
+        }
+
+        Node& inner = nodes[node_id];
+        inner.min_cost = min(inner.min_cost, cost);
+        int child_id = inner.get_child(values[var]);
+        if (child_id == -1) {
+            child_id = add_leaf(values, var + 1, entry, cost);
+            nodes[node_id].children.emplace_back(values[var], child_id);
+            ++num_entries;
+            break;
+        }
+        node_id = child_id;
+        ++var;
+    }
+}
+
+bool PartialStateIndex::Node::tail_generalizes(
+    const vector<int>& state,
+    int var) const
+{
+    for (size_t i = 0; i < tail.size(); ++i) {
+        int value = tail[i];
+        if (value != PartialAssignment::UNASSIGNED && value != state[var + i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool PartialStateIndex::Node::tail_specializes(
+    const vector<int>& partial_state,
+    int var) const
+{
+    for (size_t i = 0; i < tail.size(); ++i) {
+        int value = partial_state[var + i];
+        if (value != PartialAssignment::UNASSIGNED && value != tail[i]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+void PartialStateIndex::find_generalization(
+    const vector<int>& state,
+    int node_id,
+    int var,
+    pair<int, int>& best) const
+{
+    const Node& node = nodes[node_id];
+    if (node.min_cost >= best.second) {
+        return;
+    }
+    if (node.entry != NO_ENTRY) {
+        if (node.tail_generalizes(state, var)) {
+            best = make_pair(node.entry, node.min_cost);
+        }
+        return;
+    }
+    int child_id = node.get_child(state[var]);
+    if (child_id != -1) {
+        find_generalization(state, child_id, var + 1, best);
+    }
+    child_id = node.get_child(PartialAssignment::UNASSIGNED);
+    if (child_id != -1) {
+        find_generalization(state, child_id, var + 1, best);
+    }
+}
+
+void PartialStateIndex::find_specialization(
+    const vector<int>& partial_state,
+    int node_id,
+    int var,
+    pair<int, int>& best) const
+{
+    const Node& node = nodes[node_id];
+    if (node.min_cost >= best.second) {
+        return;
+    }
+    if (node.entry != NO_ENTRY) {
+        if (node.tail_specializes(partial_state, var)) {
+            best = make_pair(node.entry, node.min_cost);
+        }
+        return;
+    }
+    int value = partial_state[var];
+    if (value == PartialAssignment::UNASSIGNED) {
+        for (const pair<int, int>& child : node.children) {
+            find_specialization(partial_state, child.second, var + 1, best);
+        }
+    } else {
+        int child_id = node.get_child(value);
+        if (child_id != -1) {
+            find_specialization(partial_state, child_id, var + 1, best);
+        }
+    }
+}
+
+pair<int, int> PartialStateIndex::find_cheapest_generalization(
+    const vector<int>& state,
+    int cost_limit) const
+{
+    assert(static_cast<int>(state.size()) == num_variables);
+    pair<int, int> best(NO_ENTRY, cost_limit);
+    find_generalization(state, 0, 0, best);
+    return best;
+}
+
+pair<int, int> PartialStateIndex::find_cheapest_specialization(
+    const vector<int>& partial_state,
+    int cost_limit) const
+{
+    assert(static_cast<int>(partial_state.size()) == num_variables);
+    pair<int, int> best(NO_ENTRY, cost_limit);
+    find_specialization(partial_state, 0, 0, best);
+    return best;
+}
+} // namespace partial_state_index
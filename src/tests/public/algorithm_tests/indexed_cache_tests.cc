@@ -0,0 +1,145 @@
+#include <gtest/gtest.h>
+
+#include "downward/algorithms/indexed_cache.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluator.h"
+#include "downward/search_progress.h"
+#include "downward/task_proxy.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace indexed_cache;
+using namespace tests;
+
+namespace {
+class ConstEvaluator : public Evaluator {
+    int value;
+
+public:
+    explicit ConstEvaluator(int value)
+        : Evaluator("const", utils::get_silent_log())
+        , value(value)
+    {
+    }
+
+    EvaluationResult compute_result(EvaluationContext&) override
+    {
+        EvaluationResult result;
+        result.set_evaluator_value(value);
+        return result;
+    }
+
+    void get_path_dependent_evaluators(std::set<Evaluator*>&) override {}
+};
+} // namespace
+
+TEST(IndexedCacheTestsPublic, test_id_pool_reuses_smallest_free_id)
+{
+    IdPool pool;
+    ASSERT_EQ(pool.allocate(), 0);
+    ASSERT_EQ(pool.allocate(), 1);
+    ASSERT_EQ(pool.allocate(), 2);
+    pool.release(1);
+    pool.release(0);
+    ASSERT_EQ(pool.allocate(), 0);
+    ASSERT_EQ(pool.allocate(), 1);
+    ASSERT_EQ(pool.allocate(), 3);
+}
+
+TEST(IndexedCacheTestsPublic, test_reused_ids_get_new_serials)
+{
+    auto pool = std::make_shared<IdPool>();
+    auto first = std::make_unique<PooledId>(pool);
+    int id = first->get_id();
+    auto serial = first->get_serial();
+    ASSERT_NE(serial, 0u);
+    first.reset();
+
+    PooledId second(pool);
+    ASSERT_EQ(second.get_id(), id);
+    ASSERT_NE(second.get_serial(), serial);
+}
+
+TEST(IndexedCacheTestsPublic, test_id_pool_scope)
+{
+    auto shared_pool = std::make_shared<IdPool>();
+    std::shared_ptr<IdPool> current = shared_pool;
+    std::vector<std::unique_ptr<PooledId>> outside;
+    for (int i = 0; i < 20; ++i) {
+        outside.push_back(std::make_unique<PooledId>(current));
+    }
+
+    std::unique_ptr<PooledId> inside;
+    {
+        IdPoolScope scope(current);
+        ASSERT_NE(current, shared_pool);
+        inside = std::make_unique<PooledId>(current);
+        ASSERT_EQ(inside->get_id(), 0);
+    }
+    ASSERT_EQ(current, shared_pool);
+    ASSERT_EQ(PooledId(current).get_id(), 20);
+    // Released into the pool of the scope, which is kept alive by the ID.
+    inside.reset();
+}
+
+TEST(IndexedCacheTestsPublic, test_context_drops_stale_result)
+{
+    GripperProblem problem(2, 1);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    EvaluationContext eval_context(task_proxy.get_initial_state());
+    auto first = std::make_unique<ConstEvaluator>(5);
+    int id = first->get_id();
+    ASSERT_EQ(eval_context.get_evaluator_value(first.get()), 5);
+    first.reset();
+
+    ConstEvaluator second(7);
+    ASSERT_EQ(second.get_id(), id);
+    ASSERT_EQ(eval_context.get_evaluator_value(&second), 7);
+}
+
+TEST(IndexedCacheTestsPublic, test_progress_drops_stale_minimum)
+{
+    GripperProblem problem(2, 1);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    State state = task_proxy.get_initial_state();
+    SearchProgress progress;
+    auto first = std::make_unique<ConstEvaluator>(5);
+    {
+        EvaluationContext eval_context(state);
+        eval_context.get_evaluator_value(first.get());
+        ASSERT_TRUE(progress.check_progress(eval_context));
+    }
+    first.reset();
+
+    // The first value of a new evaluator is a new minimum, even if an
+    // earlier evaluator with the same ID had a smaller value.
+    ConstEvaluator second(7);
+    EvaluationContext eval_context(state);
+    eval_context.get_evaluator_value(&second);
+    ASSERT_TRUE(progress.check_progress(eval_context));
+    ASSERT_FALSE(progress.check_progress(eval_context));
+}
+
+TEST(IndexedCacheTestsPublic, test_evaluator_id_scope)
+{
+    std::vector<std::unique_ptr<ConstEvaluator>> evaluators;
+    for (int i = 0; i < 20; ++i) {
+        evaluators.push_back(std::make_unique<ConstEvaluator>(i));
+    }
+    {
+        EvaluatorIdScope id_scope;
+        ConstEvaluator first(0);
+        ConstEvaluator second(0);
+        ASSERT_EQ(first.get_id(), 0);
+        ASSERT_EQ(second.get_id(), 1);
+    }
+    ConstEvaluator after(0);
+    ASSERT_GE(after.get_id(), 20);
+}
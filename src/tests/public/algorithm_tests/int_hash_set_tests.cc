@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "downward/algorithms/int_hash_set.h"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+using namespace int_hash_set;
+
+namespace {
+/*
+  Keys are indices into a vector of values. Two keys are equal if they have
+  the same value, and the hash of a key is given for its value.
+*/
+struct Keys {
+    std::vector<int> values;
+    std::vector<HashType> hashes;
+    int num_equal_calls = 0;
+
+    int add_key(int value)
+    {
+        values.push_back(value);
+        return values.size() - 1;
+    }
+};
+
+struct KeyHash {
+    const Keys* keys;
+
+    HashType operator()(int key) const
+    {
+        return keys->hashes[keys->values[key]];
+    }
+};
+
+struct KeyEqual {
+    Keys* keys;
+
+    bool operator()(int lhs, int rhs) const
+    {
+        ++keys->num_equal_calls;
+        return keys->values[lhs] == keys->values[rhs];
+    }
+};
+} // namespace
+
+class IntHashSetTestsPublic : public testing::Test {
+protected:
+    Keys keys;
+    IntHashSet<KeyHash, KeyEqual> hash_set;
+
+    IntHashSetTestsPublic()
+        : hash_set(KeyHash{&keys}, KeyEqual{&keys})
+    {
+    }
+};
+
+TEST_F(IntHashSetTestsPublic, test_equal_keys_are_found)
+{
+    std::mt19937_64 rng(1);
+    for (int value = 0; value < 10000; ++value) keys.hashes.push_back(rng());
+    for (int value = 0; value < 10000; ++value) {
+        ASSERT_EQ(
+            hash_set.insert(keys.add_key(value)),
+            std::make_pair(value, true));
+    }
+    ASSERT_EQ(hash_set.size(), 10000);
+    for (int value = 0; value < 10000; ++value) {
+        int key = keys.add_key(value);
+        ASSERT_EQ(hash_set.find(key), value);
+        ASSERT_EQ(hash_set.insert(key), std::make_pair(value, false));
+    }
+    ASSERT_EQ(hash_set.size(), 10000);
+}
+
+/*
+  Hashes that only differ in their high 32 bits select the same ideal bucket
+  for every capacity of the set, but the stored fingerprints tell the keys
+  apart without calling the equality test.
+*/
+TEST_F(IntHashSetTestsPublic, test_same_bucket_different_fingerprints)
+{
+    const int num_groups = 50;
+    const int group_size = 20;
+    std::mt19937 rng(2);
+    for (int group = 0; group < num_groups; ++group) {
+        std::uint64_t low_bits = rng();
+        for (int i = 0; i < group_size; ++i) {
+            std::uint64_t high_bits = rng() | 1u;
+            keys.hashes.push_back((high_bits << 32) | low_bits);
+        }
+    }
+    const int num_values = keys.hashes.size();
+    for (int value = 0; value < num_values; ++value) {
+        ASSERT_TRUE(hash_set.insert(keys.add_key(value)).second);
+    }
+    for (int value = 0; value < num_values; ++value) {
+        ASSERT_EQ(hash_set.find(keys.add_key(value)), value);
+    }
+    ASSERT_EQ(hash_set.size(), num_values);
+    // The equality test is only called for the lookups of equal keys.
+    ASSERT_EQ(keys.num_equal_calls, num_values);
+}
+
+// Keys with the same 64-bit hash are told apart by the equality test.
+TEST_F(IntHashSetTestsPublic, test_full_hash_collisions)
+{
+    const int num_values = 20;
+    keys.hashes.assign(num_values, 0x123456789abcdef0ULL);
+    for (int value = 0; value < num_values; ++value) {
+        ASSERT_TRUE(hash_set.insert(keys.add_key(value)).second);
+    }
+    for (int value = 0; value < num_values; ++value) {
+        int key = keys.add_key(value);
+        ASSERT_EQ(hash_set.find(key), value);
+        ASSERT_EQ(hash_set.insert(key), std::make_pair(value, false));
+    }
+    ASSERT_EQ(hash_set.size(), num_values);
+}
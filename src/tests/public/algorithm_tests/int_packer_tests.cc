@@ -0,0 +1,119 @@
+#include <gtest/gtest.h>
+
+#include "downward/algorithms/int_packer.h"
+
+#include <random>
+#include <vector>
+
+using namespace int_packer;
+
+static const std::vector<Encoding> encodings = {
+    Encoding::BIT_FIELDS,
+    Encoding::MIXED_RADIX};
+
+// Random ranges whose products do not fill the bins exactly.
+static std::vector<int> create_random_ranges(int num_vars, std::mt19937& rng)
+{
+    std::uniform_int_distribution<int> small_range(2, 12);
+    std::uniform_int_distribution<int> large_range(1000, 1 << 20);
+    std::vector<int> ranges;
+    for (int var = 0; var < num_vars; ++var) {
+        ranges.push_back(var % 7 == 0 ? large_range(rng) : small_range(rng));
+    }
+    return ranges;
+}
+
+/*
+  Set all variables to random values, then change them one at a time and
+  check after every change that all variables hold their values.
+*/
+static void test_round_trip(
+    const std::vector<int>& ranges,
+    Encoding encoding,
+    unsigned seed)
+{
+    IntPacker packer(ranges, encoding);
+    std::vector<IntPacker::Bin> buffer(packer.get_num_bins(), 0);
+    std::mt19937 rng(seed);
+    std::vector<int> values;
+    for (int range : ranges) {
+        values.push_back(std::uniform_int_distribution<int>(0, range - 1)(rng));
+    }
+    for (size_t var = 0; var < ranges.size(); ++var) {
+        packer.set(buffer.data(), var, values[var]);
+    }
+    for (int change = 0; change < 200; ++change) {
+        for (size_t var = 0; var < ranges.size(); ++var) {
+            ASSERT_EQ(packer.get(buffer.data(), var), values[var]);
+        }
+        int var = std::uniform_int_distribution<int>(0, ranges.size() - 1)(rng);
+        values[var] =
+            std::uniform_int_distribution<int>(0, ranges[var] - 1)(rng);
+        packer.set(buffer.data(), var, values[var]);
+    }
+}
+
+TEST(IntPackerTestsPublic, test_round_trip_of_ternary_variables)
+{
+    for (Encoding encoding : encodings) {
+        test_round_trip(std::vector<int>(61, 3), encoding, 1);
+    }
+}
+
+TEST(IntPackerTestsPublic, test_round_trip_of_mixed_ranges)
+{
+    std::mt19937 rng(2);
+    for (int num_vars : {1, 5, 30, 100}) {
+        std::vector<int> ranges = create_random_ranges(num_vars, rng);
+        for (Encoding encoding : encodings) {
+            test_round_trip(ranges, encoding, num_vars);
+        }
+    }
+}
+
+TEST(IntPackerTestsPublic, test_round_trip_of_extreme_values)
+{
+    std::vector<int> ranges = {2, 1 << 30, 3, 2, 5, 1 << 16, 7};
+    for (Encoding encoding : encodings) {
+        IntPacker packer(ranges, encoding);
+        std::vector<IntPacker::Bin> buffer(packer.get_num_bins(), 0);
+        for (size_t var = 0; var < ranges.size(); ++var) {
+            packer.set(buffer.data(), var, ranges[var] - 1);
+        }
+        for (size_t var = 0; var < ranges.size(); ++var) {
+            ASSERT_EQ(packer.get(buffer.data(), var), ranges[var] - 1);
+            packer.set(buffer.data(), var, 0);
+        }
+        for (IntPacker::Bin bin : buffer) ASSERT_EQ(bin, 0u);
+    }
+}
+
+TEST(IntPackerTestsPublic, test_mixed_radix_uses_fewer_bins)
+{
+    // 20 ternary variables need 40 bits as bit fields, but 3^20 < 2^32.
+    ASSERT_EQ(
+        IntPacker(std::vector<int>(20, 3), Encoding::BIT_FIELDS)
+            .get_num_bins(),
+        2);
+    ASSERT_EQ(
+        IntPacker(std::vector<int>(20, 3), Encoding::MIXED_RADIX)
+            .get_num_bins(),
+        1);
+    // 80 variables with range 5 need 240 bits, but 5^13 < 2^32.
+    ASSERT_EQ(
+        IntPacker(std::vector<int>(80, 5), Encoding::BIT_FIELDS)
+            .get_num_bins(),
+        8);
+    ASSERT_EQ(
+        IntPacker(std::vector<int>(80, 5), Encoding::MIXED_RADIX)
+            .get_num_bins(),
+        7);
+
+    std::mt19937 rng(3);
+    for (int i = 0; i < 20; ++i) {
+        std::vector<int> ranges = create_random_ranges(50, rng);
+        ASSERT_LE(
+            IntPacker(ranges, Encoding::MIXED_RADIX).get_num_bins(),
+            IntPacker(ranges, Encoding::BIT_FIELDS).get_num_bins());
+    }
+}
@@ -0,0 +1,148 @@
+#include <gtest/gtest.h>
+
+#include "downward/algorithms/mapped_segment_allocator.h"
+
+#include "downward/algorithms/segmented_vector.h"
+#include "downward/per_state_information.h"
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <vector>
+
+using namespace mapped_segment_allocator;
+using namespace tests;
+
+class MappedSegmentAllocatorTestsPublic : public testing::Test {
+protected:
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "mapped_segment_tests";
+
+    void SetUp() override { std::filesystem::create_directories(directory); }
+    void TearDown() override { std::filesystem::remove_all(directory); }
+};
+
+TEST_F(MappedSegmentAllocatorTestsPublic, test_backing_file_is_unlinked)
+{
+    MappedArena arena(directory.string(), 4096);
+    arena.allocate(100, 8);
+    ASSERT_TRUE(std::filesystem::is_empty(directory));
+}
+
+TEST_F(MappedSegmentAllocatorTestsPublic, test_allocations_are_disjoint)
+{
+    const std::size_t chunk_bytes = 4096;
+    MappedArena arena(directory.string(), chunk_bytes);
+    const std::vector<std::size_t> alignments = {1, 4, 8, 64};
+
+    std::vector<std::pair<unsigned char*, std::size_t>> allocations;
+    std::size_t total_bytes = 0;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        std::size_t bytes = 1 + (i * 37) % 300;
+        std::size_t alignment = alignments[i % alignments.size()];
+        auto* address =
+            static_cast<unsigned char*>(arena.allocate(bytes, alignment));
+        ASSERT_EQ(reinterpret_cast<std::uintptr_t>(address) % alignment, 0u);
+        std::memset(address, static_cast<int>(i % 256), bytes);
+        allocations.emplace_back(address, bytes);
+        total_bytes += bytes;
+    }
+    // A later allocation never overwrites an earlier one.
+    for (std::size_t i = 0; i < allocations.size(); ++i) {
+        auto [address, bytes] = allocations[i];
+        for (std::size_t j = 0; j < bytes; ++j) {
+            ASSERT_EQ(address[j], i % 256);
+        }
+    }
+    ASSERT_GE(arena.get_mapped_bytes(), total_bytes);
+    ASSERT_EQ(arena.get_mapped_bytes() % chunk_bytes, 0u);
+}
+
+TEST_F(MappedSegmentAllocatorTestsPublic, test_allocation_larger_than_chunk)
+{
+    const std::size_t chunk_bytes = 4096;
+    MappedArena arena(directory.string(), chunk_bytes);
+    auto* small = static_cast<char*>(arena.allocate(10, 1));
+    std::memset(small, 1, 10);
+    auto* large = static_cast<char*>(arena.allocate(3 * chunk_bytes + 1, 8));
+    std::memset(large, 2, 3 * chunk_bytes + 1);
+    ASSERT_EQ(small[9], 1);
+    ASSERT_EQ(large[3 * chunk_bytes], 2);
+    ASSERT_GE(arena.get_mapped_bytes(), 4 * chunk_bytes + 1);
+}
+
+TEST_F(MappedSegmentAllocatorTestsPublic, test_segmented_vectors_in_arena)
+{
+    auto arena = std::make_shared<MappedArena>(directory.string(), 4096);
+
+    segmented_vector::SegmentedVector<int, SegmentAllocator<int>> vector(
+        (SegmentAllocator<int>(arena)));
+    for (int i = 0; i < 100000; ++i) vector.push_back(3 * i);
+    ASSERT_EQ(vector.size(), 100000u);
+    for (int i = 0; i < 100000; ++i) ASSERT_EQ(vector[i], 3 * i);
+
+    segmented_vector::SegmentedArrayVector<int, SegmentAllocator<int>> arrays(
+        3,
+        SegmentAllocator<int>(arena));
+    for (int i = 0; i < 10000; ++i) {
+        int array[3] = {i, i + 1, i + 2};
+        arrays.push_back(array);
+    }
+    for (int i = 0; i < 10000; ++i) {
+        ASSERT_EQ(arrays[i][0], i);
+        ASSERT_EQ(arrays[i][2], i + 2);
+    }
+    // The segments were allocated from the arena.
+    ASSERT_GE(arena->get_mapped_bytes(), 100000 * sizeof(int));
+}
+
+TEST_F(MappedSegmentAllocatorTestsPublic, test_mapped_state_registry)
+{
+    GripperProblem problem(3, 4);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+
+    StateRegistry heap_registry(task_proxy);
+    StateRegistry mapped_registry(
+        task_proxy,
+        std::make_shared<MappedArena>(directory.string(), 4096));
+    PerStateInformation<int> heap_info(-1);
+    PerStateInformation<int> mapped_info(-1);
+
+    // Breadth-first exploration of all reachable states in both registries.
+    std::vector<State> queue = {heap_registry.get_initial_state()};
+    State mapped_initial = mapped_registry.get_initial_state();
+    ASSERT_EQ(mapped_initial.get_id(), queue.front().get_id());
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        State state = queue[i];
+        State mapped_state = mapped_registry.lookup_state(state.get_id());
+        ASSERT_EQ(
+            mapped_state.get_unpacked_values(),
+            state.get_unpacked_values());
+        heap_info[state] = i;
+        mapped_info[mapped_state] = i;
+        for (OperatorProxy op : task_proxy.get_operators()) {
+            if (!task_properties::is_applicable(op, state)) continue;
+            std::size_t num_states = heap_registry.size();
+            State succ =
+                heap_registry.get_successor_state(state, op.get_effect());
+            State mapped_succ = mapped_registry.get_successor_state(
+                mapped_state,
+                op.get_effect());
+            ASSERT_EQ(mapped_succ.get_id(), succ.get_id());
+            if (heap_registry.size() > num_states) queue.push_back(succ);
+        }
+    }
+    ASSERT_EQ(mapped_registry.size(), heap_registry.size());
+    for (std::size_t i = 0; i < queue.size(); ++i) {
+        State mapped_state = mapped_registry.lookup_state(queue[i].get_id());
+        ASSERT_EQ(mapped_info[mapped_state], heap_info[queue[i]]);
+    }
+}
@@ -0,0 +1,162 @@
+#include <gtest/gtest.h>
+
+#include "downward/heuristic_cache.h"
+
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <cstdint>
+#include <memory>
+
+using namespace tests;
+
+// With 8-bit codes, 7 bits encode values and 124 is the largest one.
+using SmallCache = HeuristicCache<std::uint8_t>;
+
+static_assert(SmallCache::MAX_ENCODED_VALUE == 124);
+static_assert(HeuristicCache<>::MAX_ENCODED_VALUE == 32764);
+
+class HeuristicCacheTestsPublic : public testing::Test {
+protected:
+    GripperProblem problem;
+    std::shared_ptr<ClassicalTask> task;
+    ClassicalTaskProxy task_proxy;
+
+    HeuristicCacheTestsPublic()
+        : problem(4, 1)
+        , task(create_gripper_task(problem))
+        , task_proxy(*task)
+    {
+    }
+
+    State insert_state(StateRegistry& registry, int room)
+    {
+        return insert_state_with_robot_at(registry, problem, room);
+    }
+};
+
+TEST_F(HeuristicCacheTestsPublic, test_new_entry_is_dirty_and_empty)
+{
+    StateRegistry registry(task_proxy);
+    State state = insert_state(registry, 0);
+    SmallCache cache;
+
+    ASSERT_EQ(cache.get_value(state), SmallCache::NO_VALUE);
+    auto entry = cache[state];
+    ASSERT_FALSE(entry.has_value());
+    ASSERT_TRUE(entry.is_dirty());
+    ASSERT_EQ(entry.get_value(), SmallCache::NO_VALUE);
+}
+
+TEST_F(HeuristicCacheTestsPublic, test_largest_encoded_value)
+{
+    StateRegistry registry(task_proxy);
+    State state = insert_state(registry, 0);
+    SmallCache cache;
+
+    auto entry = cache[state];
+    entry.set_value(0);
+    ASSERT_EQ(entry.get_value(), 0);
+    entry.set_value(SmallCache::MAX_ENCODED_VALUE);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_FALSE(entry.is_dirty());
+    ASSERT_EQ(entry.get_value(), SmallCache::MAX_ENCODED_VALUE);
+    ASSERT_EQ(cache.get_value(state), SmallCache::MAX_ENCODED_VALUE);
+}
+
+TEST_F(HeuristicCacheTestsPublic, test_values_of_reserved_codes)
+{
+    StateRegistry registry(task_proxy);
+    SmallCache cache;
+
+    /*
+      The values right above MAX_ENCODED_VALUE equal the reserved codes for
+      overflow, dead ends and missing values. They must be stored in the side
+      table and not be mistaken for those codes.
+    */
+    for (int offset = 1; offset <= 4; ++offset) {
+        int value = SmallCache::MAX_ENCODED_VALUE + offset;
+        State state = insert_state(registry, offset - 1);
+        auto entry = cache[state];
+        entry.set_value(value);
+        ASSERT_TRUE(entry.has_value());
+        ASSERT_FALSE(entry.is_dirty());
+        ASSERT_EQ(entry.get_value(), value);
+        ASSERT_EQ(cache.get_value(state), value);
+    }
+}
+
+TEST_F(HeuristicCacheTestsPublic, test_overflow_value_is_replaced)
+{
+    StateRegistry registry(task_proxy);
+    State state = insert_state(registry, 0);
+    State other_state = insert_state(registry, 1);
+    SmallCache cache;
+
+    cache[other_state].set_value(1000);
+    auto entry = cache[state];
+    entry.set_value(100000);
+    ASSERT_EQ(entry.get_value(), 100000);
+    entry.set_value(200000);
+    ASSERT_EQ(entry.get_value(), 200000);
+    entry.set_value(3);
+    ASSERT_EQ(entry.get_value(), 3);
+    entry.set_value(SmallCache::DEAD_END);
+    ASSERT_EQ(entry.get_value(), SmallCache::DEAD_END);
+    entry.set_value(300000);
+    ASSERT_EQ(entry.get_value(), 300000);
+    ASSERT_EQ(cache.get_value(other_state), 1000);
+}
+
+TEST_F(HeuristicCacheTestsPublic, test_dead_end)
+{
+    StateRegistry registry(task_proxy);
+    State state = insert_state(registry, 0);
+    SmallCache cache;
+
+    auto entry = cache[state];
+    entry.set_value(SmallCache::DEAD_END);
+    ASSERT_TRUE(entry.has_value());
+    ASSERT_FALSE(entry.is_dirty());
+    ASSERT_EQ(entry.get_value(), SmallCache::DEAD_END);
+    ASSERT_EQ(cache.get_value(state), SmallCache::DEAD_END);
+}
+
+TEST_F(HeuristicCacheTestsPublic, test_mark_dirty_keeps_value)
+{
+    StateRegistry registry(task_proxy);
+    SmallCache cache;
+
+    int room = 0;
+    for (int value :
+         {7, SmallCache::MAX_ENCODED_VALUE, 1000, SmallCache::DEAD_END}) {
+        State state = insert_state(registry, room++);
+        auto entry = cache[state];
+        entry.set_value(value);
+        entry.mark_dirty();
+        ASSERT_TRUE(entry.is_dirty());
+        ASSERT_TRUE(entry.has_value());
+        ASSERT_EQ(entry.get_value(), value);
+        entry.set_value(value);
+        ASSERT_FALSE(entry.is_dirty());
+    }
+}
+
+TEST_F(HeuristicCacheTestsPublic, test_overflow_values_per_registry)
+{
+    SmallCache cache;
+    StateRegistry registry(task_proxy);
+    State state = insert_state(registry, 0);
+    cache[state].set_value(1000);
+    {
+        // The first state of each registry has the same ID.
+        StateRegistry other_registry(task_proxy);
+        State other_state = insert_state(other_registry, 0);
+        ASSERT_EQ(other_state.get_id(), state.get_id());
+        cache[other_state].set_value(2000);
+        ASSERT_EQ(cache.get_value(other_state), 2000);
+    }
+    ASSERT_EQ(cache.get_value(state), 1000);
+}
@@ -0,0 +1,202 @@
+#include <gtest/gtest.h>
+
+#include "downward/open_lists/alternation_open_list.h"
+
+#include "downward/open_lists/tiebreaking_open_list.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluator.h"
+#include "downward/open_list.h"
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace tests;
+
+namespace {
+// Evaluates a state to the value given for the room of the robot.
+class RoomEvaluator : public Evaluator {
+    int robot_var;
+    std::vector<int> values;
+
+public:
+    RoomEvaluator(int robot_var, std::vector<int> values)
+        : Evaluator("room", utils::get_silent_log())
+        , robot_var(robot_var)
+        , values(std::move(values))
+    {
+    }
+
+    EvaluationResult compute_result(EvaluationContext& eval_context) override
+    {
+        EvaluationResult result;
+        result.set_evaluator_value(
+            values[eval_context.get_state()[robot_var].get_value()]);
+        return result;
+    }
+
+    void get_path_dependent_evaluators(std::set<Evaluator*>&) override {}
+};
+} // namespace
+
+class AlternationOpenListTestsPublic : public testing::Test {
+protected:
+    static constexpr int NUM_ROOMS = 4;
+
+    GripperProblem problem;
+    std::shared_ptr<ClassicalTask> task;
+    ClassicalTaskProxy task_proxy;
+    StateRegistry registry;
+    // The state in which the robot is in room i.
+    std::vector<StateID> states;
+
+    AlternationOpenListTestsPublic()
+        : problem(NUM_ROOMS, 1)
+        , task(create_gripper_task(problem))
+        , task_proxy(*task)
+        , registry(task_proxy)
+    {
+        for (int room = 0; room < NUM_ROOMS; ++room) {
+            states.push_back(
+                insert_state_with_robot_at(registry, problem, room).get_id());
+        }
+    }
+
+    std::shared_ptr<Evaluator> create_evaluator(std::vector<int> values)
+    {
+        return std::make_shared<RoomEvaluator>(
+            problem.get_variable_robot_at(),
+            std::move(values));
+    }
+
+    static std::shared_ptr<OpenListFactory>
+    create_sublist(std::shared_ptr<Evaluator> eval, bool pref_only)
+    {
+        Options opts;
+        opts.set("evals", std::vector<std::shared_ptr<Evaluator>>{eval});
+        opts.set("pref_only", pref_only);
+        opts.set("unsafe_pruning", false);
+        return std::make_shared<
+            tiebreaking_open_list::TieBreakingOpenListFactory>(opts);
+    }
+
+    static std::unique_ptr<StateOpenList> create_alternation_list(
+        std::vector<std::shared_ptr<OpenListFactory>> sublists,
+        int boost)
+    {
+        Options opts;
+        opts.set("sublists", sublists);
+        opts.set("boost", boost);
+        return alternation_open_list::AlternationOpenListFactory(opts)
+            .create_state_open_list();
+    }
+
+    // Insert the states of all rooms. Those in "preferred" are preferred.
+    void insert_all(StateOpenList& open_list, const std::set<int>& preferred)
+    {
+        for (int room = 0; room < NUM_ROOMS; ++room) {
+            State state = registry.lookup_state(states[room]);
+            EvaluationContext eval_context(
+                state,
+                0,
+                preferred.contains(room),
+                nullptr);
+            open_list.insert(eval_context, state.get_id());
+        }
+    }
+
+    std::vector<StateID> remove_all(StateOpenList& open_list)
+    {
+        std::vector<StateID> removed;
+        while (!open_list.empty()) removed.push_back(open_list.remove_min());
+        return removed;
+    }
+};
+
+TEST_F(AlternationOpenListTestsPublic, test_round_robin)
+{
+    auto open_list = create_alternation_list(
+        {create_sublist(create_evaluator({0, 1, 2, 3}), false),
+         create_sublist(create_evaluator({3, 2, 1, 0}), false)},
+        0);
+    insert_all(*open_list, {});
+
+    // Every entry is in both sublists, which take turns.
+    std::vector<StateID> expected = {
+        states[0],
+        states[3],
+        states[1],
+        states[2],
+        states[2],
+        states[1],
+        states[3],
+        states[0]};
+    ASSERT_EQ(remove_all(*open_list), expected);
+}
+
+TEST_F(AlternationOpenListTestsPublic, test_pref_only_sublist_without_boost)
+{
+    auto eval = create_evaluator({0, 1, 2, 3});
+    auto open_list = create_alternation_list(
+        {create_sublist(eval, false), create_sublist(eval, true)},
+        3);
+    insert_all(*open_list, {2, 3});
+
+    std::vector<StateID> expected = {
+        states[0],
+        states[2],
+        states[1],
+        states[3],
+        states[2],
+        states[3]};
+    ASSERT_EQ(remove_all(*open_list), expected);
+}
+
+TEST_F(AlternationOpenListTestsPublic, test_boost_preferred)
+{
+    auto eval = create_evaluator({0, 1, 2, 3});
+    auto open_list = create_alternation_list(
+        {create_sublist(eval, false), create_sublist(eval, true)},
+        3);
+    insert_all(*open_list, {2, 3});
+    open_list->boost_preferred();
+
+    // The boosted sublist is used until it is empty or its boost is used up.
+    std::vector<StateID> expected = {
+        states[2],
+        states[3],
+        states[0],
+        states[1],
+        states[2],
+        states[3]};
+    ASSERT_EQ(remove_all(*open_list), expected);
+}
+
+TEST_F(AlternationOpenListTestsPublic, test_boost_is_used_up)
+{
+    auto eval = create_evaluator({0, 1, 2, 3});
+    auto open_list = create_alternation_list(
+        {create_sublist(eval, false), create_sublist(eval, true)},
+        1);
+    insert_all(*open_list, {1, 2, 3});
+    open_list->boost_preferred();
+
+    /*
+      After one boosted removal, both sublists have the same priority, and
+      the sublists take turns again, starting with the first one.
+    */
+    std::vector<StateID> expected = {
+        states[1],
+        states[0],
+        states[2],
+        states[1],
+        states[3],
+        states[2],
+        states[3]};
+    ASSERT_EQ(remove_all(*open_list), expected);
+}
@@ -0,0 +1,103 @@
+#include <gtest/gtest.h>
+
+#include "downward/search_algorithms/anytime_astar_search.h"
+
+#include "downward/heuristics/goal_count_heuristic.h"
+
+#include "tests/tasks/gripper.h"
+#include "tests/utils/search_utils.h"
+
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+
+using namespace anytime_astar_search;
+using namespace goal_count_heuristic;
+using namespace tests;
+
+static std::string read_file(const std::filesystem::path& path)
+{
+    std::ifstream in(path);
+    return std::string(
+        std::istreambuf_iterator<char>(in),
+        std::istreambuf_iterator<char>());
+}
+
+TEST(AnytimeAStarTestsPublic, test_plan_saved_when_interrupted)
+{
+    GripperProblem problem(4, 1);
+    auto task =
+        create_gripper_task(problem, {problem.get_fact_robot_at_room(1)});
+
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "anytime_astar_tests";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    /*
+      With a time limit of zero, the search stops after expanding the
+      initial state. The goal is generated by this expansion, but the first
+      iteration has not ended yet.
+    */
+    AnytimeAStarSearch search(
+        task,
+        utils::get_silent_log(),
+        OperatorCost::NORMAL,
+        0,
+        std::numeric_limits<int>::max(),
+        std::make_shared<GoalCountHeuristic>(task),
+        {5, 1});
+    search.get_plan_manager().set_plan_filename(
+        (directory / "sas_plan").string());
+    search.search();
+
+    ASSERT_EQ(search.get_status(), TIMEOUT);
+    ASSERT_TRUE(search.found_solution());
+    ASSERT_EQ(search.get_plan().size(), 1u);
+    ASSERT_TRUE(std::filesystem::exists(directory / "sas_plan.1"));
+    ASSERT_NE(
+        read_file(directory / "sas_plan.1").find("; cost = 1"),
+        std::string::npos);
+
+    // The plan is not saved a second time.
+    search.save_plan_if_necessary();
+    ASSERT_FALSE(std::filesystem::exists(directory / "sas_plan.2"));
+    std::filesystem::remove_all(directory);
+}
+
+TEST(AnytimeAStarTestsPublic, test_final_plan_is_optimal)
+{
+    GripperProblem problem(2, 3);
+    auto task = create_gripper_round_trip_task(problem);
+
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "anytime_astar_tests";
+    std::filesystem::remove_all(directory);
+    std::filesystem::create_directories(directory);
+
+    AnytimeAStarSearch search(
+        task,
+        utils::get_silent_log(),
+        OperatorCost::NORMAL,
+        std::numeric_limits<double>::infinity(),
+        std::numeric_limits<int>::max(),
+        std::make_shared<GoalCountHeuristic>(task),
+        {5, 2, 1});
+    search.get_plan_manager().set_plan_filename(
+        (directory / "sas_plan").string());
+    search.search();
+
+    auto astar = create_astar_search_algorithm(
+        task,
+        std::make_shared<GoalCountHeuristic>(task));
+    astar->search();
+
+    ASSERT_EQ(search.get_status(), SOLVED);
+    ASSERT_TRUE(astar->found_solution());
+    ClassicalTaskProxy task_proxy(*task);
+    ASSERT_EQ(
+        calculate_plan_cost(search.get_plan(), task_proxy),
+        calculate_plan_cost(astar->get_plan(), task_proxy));
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "neuralfd/search_algorithms/bidirectional_search.h"
+
+#include "downward/heuristics/goal_count_heuristic.h"
+#include "downward/tasks/root_task.h"
+
+#include "tests/tasks/gripper.h"
+#include "tests/utils/search_utils.h"
+
+#include <limits>
+#include <sstream>
+#include <string>
+#include <utility>
+
+using namespace bidirectional_search;
+using namespace goal_count_heuristic;
+using namespace tests;
+
+/*
+  A single variable with values 0 to 3 and the goal 3. The operator from 0
+  to 3 costs 10, the path 0, 1, 2, 3 costs 3.
+*/
+static const std::string shortcut_task =
+    "begin_version\n3\nend_version\n"
+    "begin_metric\n1\nend_metric\n"
+    "1\n"
+    "begin_variable\nx\n-1\n4\n"
+    "Atom x(0)\nAtom x(1)\nAtom x(2)\nAtom x(3)\nend_variable\n"
+    "0\n"
+    "begin_state\n0\nend_state\n"
+    "begin_goal\n1\n0 3\nend_goal\n"
+    "4\n"
+    "begin_operator\njump\n0\n1\n0 0 0 3\n10\nend_operator\n"
+    "begin_operator\nstep1\n0\n1\n0 0 0 1\n1\nend_operator\n"
+    "begin_operator\nstep2\n0\n1\n0 0 1 2\n1\nend_operator\n"
+    "begin_operator\nstep3\n0\n1\n0 0 2 3\n1\nend_operator\n"
+    "0\n";
+
+static int compute_optimal_cost(std::shared_ptr<ClassicalTask> task)
+{
+    auto astar = create_astar_search_algorithm(
+        task,
+        std::make_shared<GoalCountHeuristic>(task));
+    astar->search();
+    EXPECT_TRUE(astar->found_solution());
+    ClassicalTaskProxy task_proxy(*task);
+    return calculate_plan_cost(astar->get_plan(), task_proxy);
+}
+
+TEST(BidirectionalSearchTestsPublic, test_plan_is_optimal)
+{
+    for (auto [num_rooms, num_balls] :
+         {std::pair(2, 1), std::pair(2, 3), std::pair(3, 2)}) {
+        GripperProblem problem(num_rooms, num_balls);
+        auto task = create_gripper_round_trip_task(problem);
+        ClassicalTaskProxy task_proxy(*task);
+        int optimal_cost = compute_optimal_cost(task);
+
+        for (bool prune_mutexes : {false, true}) {
+            BidirectionalSearch search(
+                task,
+                utils::get_silent_log(),
+                OperatorCost::NORMAL,
+                std::numeric_limits<double>::infinity(),
+                std::numeric_limits<int>::max(),
+                prune_mutexes);
+            search.search();
+
+            ASSERT_EQ(search.get_status(), SOLVED);
+            ASSERT_TRUE(leads_to_goal(task_proxy, search.get_plan()));
+            ASSERT_EQ(
+                calculate_plan_cost(search.get_plan(), task_proxy),
+                optimal_cost);
+        }
+    }
+}
+
+TEST(BidirectionalSearchTestsPublic, test_bound_is_exclusive)
+{
+    GripperProblem problem(2, 1);
+    auto task = create_gripper_round_trip_task(problem);
+    int optimal_cost = compute_optimal_cost(task);
+
+    for (int bound : {optimal_cost, optimal_cost + 1}) {
+        BidirectionalSearch search(
+            task,
+            utils::get_silent_log(),
+            OperatorCost::NORMAL,
+            std::numeric_limits<double>::infinity(),
+            bound,
+            false);
+        search.search();
+        ASSERT_EQ(search.found_solution(), bound > optimal_cost);
+    }
+}
+
+/*
+  The first expansion of the initial state already meets the goal with the
+  expensive operator. The search may only stop once the cheapest plan found
+  costs at most the sum of the smallest g values of both open lists.
+*/
+TEST(BidirectionalSearchTestsPublic, test_no_stop_at_first_meeting)
+{
+    std::istringstream in(shortcut_task);
+    std::shared_ptr<ClassicalTask> task = tasks::read_task_from_sas(in);
+    ClassicalTaskProxy task_proxy(*task);
+
+    BidirectionalSearch search(
+        task,
+        utils::get_silent_log(),
+        OperatorCost::NORMAL,
+        std::numeric_limits<double>::infinity(),
+        std::numeric_limits<int>::max(),
+        false);
+    search.search();
+
+    ASSERT_EQ(search.get_status(), SOLVED);
+    ASSERT_TRUE(leads_to_goal(task_proxy, search.get_plan()));
+    ASSERT_EQ(calculate_plan_cost(search.get_plan(), task_proxy), 3);
+}
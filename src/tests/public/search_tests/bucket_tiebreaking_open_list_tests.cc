@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include "downward/open_lists/bucket_tiebreaking_open_list.h"
+
+#include "downward/open_lists/tiebreaking_open_list.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluator.h"
+#include "downward/open_list.h"
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <memory>
+#include <random>
+#include <set>
+#include <vector>
+
+using namespace bucket_tiebreaking_open_list;
+using namespace tests;
+
+namespace {
+// Evaluates a state to the value given for the value of one variable.
+class VariableEvaluator : public Evaluator {
+    int var;
+    std::vector<int> values;
+
+public:
+    VariableEvaluator(int var, std::vector<int> values)
+        : Evaluator("variable", utils::get_silent_log())
+        , var(var)
+        , values(std::move(values))
+    {
+    }
+
+    EvaluationResult compute_result(EvaluationContext& eval_context) override
+    {
+        EvaluationResult result;
+        result.set_evaluator_value(
+            values[eval_context.get_state()[var].get_value()]);
+        return result;
+    }
+
+    void get_path_dependent_evaluators(std::set<Evaluator*>&) override {}
+};
+} // namespace
+
+class BucketTieBreakingOpenListTestsPublic : public testing::Test {
+protected:
+    GripperProblem problem;
+    std::shared_ptr<ClassicalTask> task;
+    ClassicalTaskProxy task_proxy;
+    StateRegistry registry;
+
+    BucketTieBreakingOpenListTestsPublic()
+        : problem(4, 3)
+        , task(create_gripper_task(problem))
+        , task_proxy(*task)
+        , registry(task_proxy)
+    {
+    }
+
+    static Options
+    create_options(const std::vector<std::shared_ptr<Evaluator>>& evals)
+    {
+        Options opts;
+        opts.set("evals", evals);
+        opts.set("pref_only", false);
+        opts.set("unsafe_pruning", false);
+        return opts;
+    }
+
+    // Random (not necessarily reachable) states of the task.
+    std::vector<StateID> create_random_states(int num_states, unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        std::vector<StateID> states;
+        for (int i = 0; i < num_states; ++i) {
+            std::vector<int> values;
+            for (VariableProxy var : task_proxy.get_variables()) {
+                std::uniform_int_distribution<int> dist(
+                    0,
+                    var.get_domain_size() - 1);
+                values.push_back(dist(rng));
+            }
+            states.push_back(registry.insert_state(std::move(values)).get_id());
+        }
+        return states;
+    }
+
+    void insert(StateOpenList& open_list, StateID id)
+    {
+        State state = registry.lookup_state(id);
+        EvaluationContext eval_context(state, 0, false, nullptr);
+        open_list.insert(eval_context, id);
+    }
+};
+
+TEST_F(BucketTieBreakingOpenListTestsPublic, test_fifo_within_bucket)
+{
+    auto eval = std::make_shared<VariableEvaluator>(
+        problem.get_variable_robot_at(),
+        std::vector<int>{1, 0, 1, 0});
+    auto open_list =
+        BucketTieBreakingOpenListFactory(create_options({eval}))
+            .create_state_open_list();
+    std::vector<StateID> states;
+    for (int room = 0; room < 4; ++room) {
+        states.push_back(
+            insert_state_with_robot_at(registry, problem, room).get_id());
+        insert(*open_list, states.back());
+    }
+
+    std::vector<StateID> removed;
+    while (!open_list->empty()) removed.push_back(open_list->remove_min());
+    std::vector<StateID> expected =
+        {states[1], states[3], states[0], states[2]};
+    ASSERT_EQ(removed, expected);
+}
+
+/*
+  Compare the order with the tie-breaking open list for one to three
+  evaluators. The evaluator values include many ties as well as negative
+  values, values beyond the bucket arrays and infinity. Removals are
+  interleaved with insertions, so that buckets are emptied and refilled.
+*/
+TEST_F(BucketTieBreakingOpenListTestsPublic, test_same_order_as_tiebreaking)
+{
+    std::vector<std::shared_ptr<Evaluator>> all_evals = {
+        std::make_shared<VariableEvaluator>(
+            problem.get_variable_robot_at(),
+            std::vector<int>{3, 100000, 0, EvaluationResult::INFTY}),
+        std::make_shared<VariableEvaluator>(
+            problem.get_variable_carry_left(),
+            std::vector<int>{1, 0, 1, 70000}),
+        std::make_shared<VariableEvaluator>(
+            problem.get_variable_ball_at(0),
+            std::vector<int>{0, 2, -5, 1, 0})};
+    std::vector<StateID> states = create_random_states(3000, 2024);
+
+    for (size_t num_evals = 1; num_evals <= all_evals.size(); ++num_evals) {
+        std::vector<std::shared_ptr<Evaluator>> evals(
+            all_evals.begin(),
+            all_evals.begin() + num_evals);
+        Options opts = create_options(evals);
+        auto bucket_list =
+            BucketTieBreakingOpenListFactory(opts).create_state_open_list();
+        auto tiebreaking_list =
+            tiebreaking_open_list::TieBreakingOpenListFactory(opts)
+                .create_state_open_list();
+
+        for (size_t i = 0; i < states.size(); ++i) {
+            insert(*bucket_list, states[i]);
+            insert(*tiebreaking_list, states[i]);
+            if (i % 3 == 2) {
+                ASSERT_EQ(
+                    bucket_list->remove_min(),
+                    tiebreaking_list->remove_min());
+            }
+        }
+        while (!tiebreaking_list->empty()) {
+            ASSERT_FALSE(bucket_list->empty());
+            ASSERT_EQ(
+                bucket_list->remove_min(),
+                tiebreaking_list->remove_min());
+        }
+        ASSERT_TRUE(bucket_list->empty());
+    }
+}
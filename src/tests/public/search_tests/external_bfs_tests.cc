@@ -0,0 +1,157 @@
+#include <gtest/gtest.h>
+
+#include "downward/search_algorithms/external_bfs_search.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <filesystem>
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+
+using namespace external_bfs_search;
+using namespace tests;
+
+// A goal that cannot be reached, so that all states are explored.
+static std::vector<FactPair> unreachable_goal(const GripperProblem& problem)
+{
+    return {
+        problem.get_fact_carry_left_ball(0),
+        problem.get_fact_carry_right_ball(0)};
+}
+
+// Number of states at each distance from the initial state.
+static std::vector<long long>
+compute_layer_sizes(const ClassicalTaskProxy& task_proxy)
+{
+    std::vector<long long> layer_sizes;
+    std::set<std::vector<int>> reached;
+    std::vector<State> layer = {task_proxy.get_initial_state()};
+    reached.insert(layer.front().get_unpacked_values());
+    while (!layer.empty()) {
+        layer_sizes.push_back(layer.size());
+        std::vector<State> next_layer;
+        for (const State& state : layer) {
+            for (OperatorProxy op : task_proxy.get_operators()) {
+                if (!task_properties::is_applicable(op, state)) continue;
+                State succ = state.get_unregistered_successor(op.get_effect());
+                if (reached.insert(succ.get_unpacked_values()).second) {
+                    next_layer.push_back(std::move(succ));
+                }
+            }
+        }
+        layer = std::move(next_layer);
+    }
+    // The search writes the empty layer that ends it.
+    layer_sizes.push_back(0);
+    return layer_sizes;
+}
+
+class ExternalBFSTestsPublic : public testing::Test {
+protected:
+    std::filesystem::path directory =
+        std::filesystem::temp_directory_path() / "external_bfs_tests";
+
+    void SetUp() override { std::filesystem::create_directories(directory); }
+    void TearDown() override { std::filesystem::remove_all(directory); }
+
+    /*
+      Run the search with the smallest possible successor buffer, which
+      writes every successor to a run of its own, and return the number of
+      states in each layer it kept on disk.
+    */
+    std::vector<long long> run_search(
+        std::shared_ptr<ClassicalTask> task,
+        int locality,
+        int_packer::Encoding encoding,
+        SearchStatus expected_status = FAILED)
+    {
+        ExternalBFSSearch search(
+            task,
+            utils::get_silent_log(),
+            OperatorCost::NORMAL,
+            // Without duplicate detection, the search would not terminate.
+            10,
+            std::numeric_limits<int>::max(),
+            encoding,
+            directory.string(),
+            0,
+            locality,
+            true);
+        search.search();
+        EXPECT_EQ(search.get_status(), expected_status);
+
+        ClassicalTaskProxy task_proxy(*task);
+        int num_bins =
+            task_properties::get_state_packer(task_proxy, encoding)
+                .get_num_bins();
+        std::vector<long long> layer_sizes;
+        IOStatistics io_statistics;
+        for (int layer = 0;; ++layer) {
+            std::filesystem::path path =
+                directory / ("bfs-layer-" + std::to_string(layer));
+            if (!std::filesystem::exists(path)) break;
+            // Each layer must be sorted and free of duplicates.
+            std::vector<Bin> last;
+            long long size = 0;
+            PackedStateReader reader(path.string(), num_bins, io_statistics);
+            for (const Bin* state = reader.get(); state;
+                 reader.advance(), state = reader.get()) {
+                std::vector<Bin> current(state, state + num_bins);
+                EXPECT_TRUE(last.empty() || last < current);
+                last = std::move(current);
+                ++size;
+            }
+            layer_sizes.push_back(size);
+        }
+        return layer_sizes;
+    }
+};
+
+TEST_F(ExternalBFSTestsPublic, test_duplicates_removed_across_layers)
+{
+    GripperProblem problem(2, 2);
+    auto task = create_gripper_task(problem, unreachable_goal(problem));
+    ClassicalTaskProxy task_proxy(*task);
+    std::vector<long long> expected = compute_layer_sizes(task_proxy);
+
+    for (auto encoding :
+         {int_packer::Encoding::BIT_FIELDS,
+          int_packer::Encoding::MIXED_RADIX}) {
+        ASSERT_EQ(run_search(task, 0, encoding), expected);
+    }
+}
+
+TEST_F(ExternalBFSTestsPublic, test_locality_of_reversible_task)
+{
+    GripperProblem problem(2, 2);
+    auto task = create_gripper_task(problem, unreachable_goal(problem));
+    ClassicalTaskProxy task_proxy(*task);
+
+    /*
+      All operators of gripper can be undone, so the successors of a layer
+      can only be duplicates of states in the layer itself or the one
+      before it.
+    */
+    ASSERT_EQ(
+        run_search(task, 2, int_packer::Encoding::BIT_FIELDS),
+        compute_layer_sizes(task_proxy));
+}
+
+TEST_F(ExternalBFSTestsPublic, test_goal_layer_is_complete)
+{
+    GripperProblem problem(3, 2);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    std::vector<long long> all_layers = compute_layer_sizes(task_proxy);
+
+    // The goal is reached in layer 5 (pick, pick, move, drop, drop), which
+    // is still written completely.
+    std::vector<long long> expected(all_layers.begin(), all_layers.begin() + 6);
+    ASSERT_EQ(
+        run_search(task, 0, int_packer::Encoding::BIT_FIELDS, SOLVED),
+        expected);
+}
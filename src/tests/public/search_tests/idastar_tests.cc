@@ -0,0 +1,71 @@
+#include <gtest/gtest.h>
+
+#include "downward/search_algorithms/idastar_search.h"
+
+#include "downward/heuristics/goal_count_heuristic.h"
+
+#include "tests/tasks/gripper.h"
+#include "tests/utils/search_utils.h"
+
+#include <limits>
+
+using namespace idastar_search;
+using namespace goal_count_heuristic;
+using namespace tests;
+
+TEST(IDAStarTestsPublic, test_plan_is_optimal)
+{
+    GripperProblem problem(2, 3);
+    auto task = create_gripper_round_trip_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+
+    auto astar = create_astar_search_algorithm(
+        task,
+        std::make_shared<GoalCountHeuristic>(task));
+    astar->search();
+    ASSERT_TRUE(astar->found_solution());
+    int optimal_cost = calculate_plan_cost(astar->get_plan(), task_proxy);
+
+    // Without and with a transposition table.
+    for (int transposition_table_size_in_mb : {0, 1}) {
+        IDAStarSearch search(
+            task,
+            utils::get_silent_log(),
+            OperatorCost::NORMAL,
+            std::numeric_limits<double>::infinity(),
+            std::numeric_limits<int>::max(),
+            std::make_shared<GoalCountHeuristic>(task),
+            transposition_table_size_in_mb);
+        search.search();
+
+        ASSERT_EQ(search.get_status(), SOLVED);
+        ASSERT_TRUE(leads_to_goal(task_proxy, search.get_plan()));
+        ASSERT_EQ(
+            calculate_plan_cost(search.get_plan(), task_proxy),
+            optimal_cost);
+        // Goal count underestimates, so one iteration is not enough.
+        ASSERT_GT(search.get_num_iterations(), 1);
+    }
+}
+
+TEST(IDAStarTestsPublic, test_bound_is_exclusive)
+{
+    GripperProblem problem(2, 1);
+    auto task = create_gripper_round_trip_task(problem);
+
+    // The optimal plan (pick, move, drop, move) costs 4.
+    for (int bound : {4, 5}) {
+        IDAStarSearch search(
+            task,
+            utils::get_silent_log(),
+            OperatorCost::NORMAL,
+            std::numeric_limits<double>::infinity(),
+            bound,
+            std::make_shared<GoalCountHeuristic>(task),
+            0);
+        search.search();
+
+        ASSERT_EQ(search.get_status(), bound > 4 ? SOLVED : FAILED);
+        ASSERT_EQ(search.found_solution(), bound > 4);
+    }
+}
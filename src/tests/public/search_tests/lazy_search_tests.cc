@@ -0,0 +1,175 @@
+#include <gtest/gtest.h>
+
+#include "downward/search_algorithms/lazy_search.h"
+
+#include "downward/search_algorithms/search_common.h"
+
+#include "downward/heuristics/goal_count_heuristic.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluator.h"
+#include "downward/open_list_factory.h"
+#include "downward/option_parser.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/successor_generator.h"
+#include "downward/utils/rng.h"
+
+#include "tests/tasks/gripper.h"
+#include "tests/utils/search_utils.h"
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace lazy_search;
+using namespace goal_count_heuristic;
+using namespace tests;
+
+namespace {
+/*
+  Evaluates every state to 0 and records the states it evaluates. In states
+  where it is applicable, the given operator is preferred.
+*/
+class RecordingEvaluator : public Evaluator {
+    OperatorID preferred_op;
+    std::vector<FactPair> preferred_op_precondition;
+
+public:
+    std::vector<std::vector<int>> evaluated_states;
+
+    explicit RecordingEvaluator(const OperatorProxy& preferred_op)
+        : Evaluator("recording", utils::get_silent_log())
+        , preferred_op(preferred_op.get_id())
+    {
+        for (FactProxy fact : preferred_op.get_precondition())
+            preferred_op_precondition.push_back(fact.get_pair());
+    }
+
+    EvaluationResult compute_result(EvaluationContext& eval_context) override
+    {
+        const State& state = eval_context.get_state();
+        evaluated_states.push_back(state.get_unpacked_values());
+        EvaluationResult result;
+        result.set_evaluator_value(0);
+        result.set_count_evaluation(true);
+        if (std::ranges::all_of(
+                preferred_op_precondition,
+                [&state](const FactPair& fact) {
+                    return state[fact.var].get_value() == fact.value;
+                })) {
+            result.set_preferred_operators({preferred_op});
+        }
+        return result;
+    }
+
+    void get_path_dependent_evaluators(std::set<Evaluator*>&) override {}
+};
+} // namespace
+
+static std::unique_ptr<LazySearch> create_lazy_greedy_search(
+    std::shared_ptr<ClassicalTask> task,
+    std::vector<std::shared_ptr<Evaluator>> evals,
+    std::vector<std::shared_ptr<Evaluator>> preferred,
+    std::vector<std::shared_ptr<Evaluator>> open_list_preferred,
+    bool preferred_successors_first)
+{
+    Options opts;
+    opts.set("evals", evals);
+    opts.set("preferred", open_list_preferred);
+    opts.set("boost", 1000);
+    return std::make_unique<LazySearch>(
+        task,
+        utils::get_silent_log(),
+        OperatorCost::NORMAL,
+        std::numeric_limits<double>::infinity(),
+        std::numeric_limits<int>::max(),
+        false,
+        search_common::create_greedy_open_list_factory(opts)
+            ->create_edge_open_list(),
+        preferred,
+        false,
+        preferred_successors_first,
+        std::make_shared<utils::RandomNumberGenerator>(2024));
+}
+
+TEST(LazySearchTestsPublic, test_plan_leads_to_goal)
+{
+    GripperProblem problem(3, 4);
+    auto task = create_gripper_round_trip_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    auto goal_count = std::make_shared<GoalCountHeuristic>(task);
+    auto recording = std::make_shared<RecordingEvaluator>(
+        task_proxy.get_operators()[problem.get_operator_move_id(0, 1)]);
+
+    // Without and with preferred operators, which add a preferred-only queue.
+    for (bool use_preferred : {false, true}) {
+        std::vector<std::shared_ptr<Evaluator>> preferred;
+        if (use_preferred) preferred.push_back(recording);
+        auto search = create_lazy_greedy_search(
+            task,
+            {goal_count},
+            preferred,
+            preferred,
+            true);
+        search->search();
+
+        ASSERT_EQ(search->get_status(), SOLVED);
+        ASSERT_TRUE(leads_to_goal(task_proxy, search->get_plan()));
+    }
+}
+
+/*
+  The open list is FIFO since all states are evaluated to 0, so the first
+  generated successor of the initial state that differs from it (Gripper has
+  operators that move the robot to its own room) is the second evaluated
+  state.
+*/
+TEST(LazySearchTestsPublic, test_preferred_successors_first)
+{
+    GripperProblem problem(3, 2);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    State initial_state = task_proxy.get_initial_state();
+
+    OperatorsProxy operators = task_proxy.get_operators();
+    successor_generator::SuccessorGenerator successor_generator(task_proxy);
+    std::vector<OperatorID> applicable_ops;
+    successor_generator.generate_applicable_ops(initial_state, applicable_ops);
+    std::vector<State> successors;
+    for (OperatorID op_id : applicable_ops) {
+        State succ = initial_state.get_unregistered_successor(
+            operators[op_id].get_effect());
+        if (succ.get_unpacked_values() != initial_state.get_unpacked_values())
+            successors.push_back(succ);
+    }
+    // Prefer the operator that leads to the last successor.
+    OperatorID preferred_op = problem.get_operator_pick_right_id(1, 0);
+    ASSERT_EQ(applicable_ops.back(), preferred_op);
+
+    for (bool preferred_successors_first : {false, true}) {
+        auto evaluator =
+            std::make_shared<RecordingEvaluator>(operators[preferred_op]);
+        auto search = create_lazy_greedy_search(
+            task,
+            {evaluator},
+            {evaluator},
+            {},
+            preferred_successors_first);
+        search->search();
+        ASSERT_EQ(search->get_status(), SOLVED);
+
+        const State& expected = preferred_successors_first
+                                    ? successors.back()
+                                    : successors.front();
+        ASSERT_GE(evaluator->evaluated_states.size(), 2u);
+        ASSERT_EQ(
+            evaluator->evaluated_states[0],
+            initial_state.get_unpacked_values());
+        ASSERT_EQ(
+            evaluator->evaluated_states[1],
+            expected.get_unpacked_values());
+    }
+}
@@ -0,0 +1,190 @@
+#include <gtest/gtest.h>
+
+#include "downward/search_space.h"
+
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/successor_generator.h"
+#include "downward/task_utils/task_properties.h"
+#include "downward/utils/logging.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <vector>
+
+using namespace tests;
+
+/*
+  Depth-first search that reopens states whenever it finds a cheaper path
+  to them, so that paths are set by open, reopen and update_parent. States
+  in which the robot carries two balls are marked as dead ends. Returns the
+  reached states.
+*/
+static std::vector<StateID> explore(
+    SearchSpace& search_space,
+    StateRegistry& registry,
+    const ClassicalTaskProxy& task_proxy,
+    const successor_generator::SuccessorGenerator& successor_generator,
+    const GripperProblem& problem,
+    OperatorCost cost_type)
+{
+    OperatorsProxy operators = task_proxy.get_operators();
+    bool is_unit_cost = task_properties::is_unit_cost(task_proxy);
+
+    State initial_state = registry.get_initial_state();
+    search_space.get_node(initial_state).open_initial();
+    std::vector<StateID> reached = {initial_state.get_id()};
+    std::vector<StateID> stack = {initial_state.get_id()};
+    while (!stack.empty()) {
+        State state = registry.lookup_state(stack.back());
+        stack.pop_back();
+        SearchNode node = search_space.get_node(state);
+        if (!node.is_open()) continue;
+        node.close();
+
+        std::vector<OperatorID> applicable_ops;
+        successor_generator.generate_applicable_ops(state, applicable_ops);
+        for (OperatorID op_id : applicable_ops) {
+            OperatorProxy op = operators[op_id];
+            int cost = get_adjusted_action_cost(op, cost_type, is_unit_cost);
+            State succ = registry.get_successor_state(state, op.get_effect());
+            SearchNode succ_node = search_space.get_node(succ);
+            if (succ_node.is_dead_end()) continue;
+            if (succ_node.is_new()) {
+                reached.push_back(succ.get_id());
+                if (succ[problem.get_variable_carry_left()].get_value() !=
+                        problem.get_num_balls() &&
+                    succ[problem.get_variable_carry_right()].get_value() !=
+                        problem.get_num_balls()) {
+                    succ_node.mark_as_dead_end();
+                } else {
+                    succ_node.open(node, op, cost);
+                    stack.push_back(succ.get_id());
+                }
+            } else if (node.get_g() + cost < succ_node.get_g()) {
+                if (succ_node.is_closed()) {
+                    succ_node.reopen(node, op, cost);
+                    stack.push_back(succ.get_id());
+                } else {
+                    succ_node.update_parent(node, op, cost);
+                }
+            }
+        }
+    }
+    return reached;
+}
+
+TEST(SearchSpaceTestsPublic, test_compact_storage_matches_struct_storage)
+{
+    GripperProblem problem(3, 3);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    successor_generator::SuccessorGenerator successor_generator(task_proxy);
+    utils::LogProxy log = utils::get_silent_log();
+
+    // real_g is only stored separately for adjusted costs.
+    for (OperatorCost cost_type : {NORMAL, PLUSONE}) {
+        StateRegistry registry(task_proxy);
+        SearchSpace struct_space(
+            registry,
+            successor_generator,
+            log,
+            SearchNodeStorage::STRUCT,
+            cost_type);
+        SearchSpace compact_space(
+            registry,
+            successor_generator,
+            log,
+            SearchNodeStorage::COMPACT,
+            cost_type);
+        std::vector<StateID> reached = explore(
+            struct_space,
+            registry,
+            task_proxy,
+            successor_generator,
+            problem,
+            cost_type);
+        ASSERT_EQ(
+            explore(
+                compact_space,
+                registry,
+                task_proxy,
+                successor_generator,
+                problem,
+                cost_type),
+            reached);
+
+        int num_closed = 0;
+        int num_dead_ends = 0;
+        for (StateID id : reached) {
+            State state = registry.lookup_state(id);
+            SearchNode struct_node = struct_space.get_node(state);
+            SearchNode compact_node = compact_space.get_node(state);
+            ASSERT_EQ(compact_node.is_new(), struct_node.is_new());
+            ASSERT_EQ(compact_node.is_open(), struct_node.is_open());
+            ASSERT_EQ(compact_node.is_closed(), struct_node.is_closed());
+            ASSERT_EQ(compact_node.is_dead_end(), struct_node.is_dead_end());
+            if (struct_node.is_dead_end()) {
+                ++num_dead_ends;
+                continue;
+            }
+            ASSERT_TRUE(struct_node.is_closed());
+            ++num_closed;
+            ASSERT_EQ(compact_node.get_g(), struct_node.get_g());
+            ASSERT_EQ(compact_node.get_real_g(), struct_node.get_real_g());
+            ASSERT_EQ(
+                compact_space.get_parent_id(state),
+                struct_space.get_parent_id(state));
+            ASSERT_EQ(
+                compact_space.get_creating_operator(state),
+                struct_space.get_creating_operator(state));
+
+            std::vector<OperatorID> struct_path;
+            std::vector<OperatorID> compact_path;
+            struct_space.trace_path(state, struct_path);
+            compact_space.trace_path(state, compact_path);
+            ASSERT_EQ(compact_path, struct_path);
+        }
+        ASSERT_GT(num_closed, 1);
+        ASSERT_GT(num_dead_ends, 0);
+    }
+}
+
+TEST(SearchSpaceTestsPublic, test_real_g_with_adjusted_costs)
+{
+    GripperProblem problem(2, 1);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    successor_generator::SuccessorGenerator successor_generator(task_proxy);
+    utils::LogProxy log = utils::get_silent_log();
+    OperatorProxy pick =
+        task_proxy.get_operators()[problem.get_operator_pick_left_id(0, 0)];
+
+    for (SearchNodeStorage storage :
+         {SearchNodeStorage::STRUCT, SearchNodeStorage::COMPACT}) {
+        StateRegistry registry(task_proxy);
+        SearchSpace search_space(
+            registry,
+            successor_generator,
+            log,
+            storage,
+            PLUSONE);
+        const State& initial_state = registry.get_initial_state();
+        SearchNode initial_node = search_space.get_node(initial_state);
+        initial_node.open_initial();
+        initial_node.close();
+        State succ =
+            registry.get_successor_state(initial_state, pick.get_effect());
+        SearchNode succ_node = search_space.get_node(succ);
+        succ_node.open(initial_node, pick, 2);
+
+        ASSERT_TRUE(succ_node.is_open());
+        ASSERT_EQ(succ_node.get_g(), 2);
+        ASSERT_EQ(succ_node.get_real_g(), 1);
+        ASSERT_EQ(search_space.get_parent_id(succ), initial_state.get_id());
+        ASSERT_EQ(
+            search_space.get_creating_operator(succ),
+            OperatorID(pick.get_id()));
+    }
+}
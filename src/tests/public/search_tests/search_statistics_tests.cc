@@ -0,0 +1,195 @@
+#include <gtest/gtest.h>
+
+#include "downward/search_statistics.h"
+
+#include "downward/evaluation_context.h"
+#include "downward/evaluator.h"
+#include "downward/task_proxy.h"
+
+#include "downward/utils/json.h"
+#include "downward/utils/logging.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <regex>
+#include <set>
+#include <sstream>
+#include <string>
+
+using namespace tests;
+
+namespace {
+class ConstEvaluator : public Evaluator {
+public:
+    explicit ConstEvaluator(std::string description)
+        : Evaluator(std::move(description), utils::get_silent_log())
+    {
+    }
+
+    EvaluationResult compute_result(EvaluationContext&) override
+    {
+        EvaluationResult result;
+        result.set_evaluator_value(0);
+        result.set_count_evaluation(true);
+        return result;
+    }
+
+    void get_path_dependent_evaluators(std::set<Evaluator*>&) override {}
+};
+} // namespace
+
+/*
+  Write the statistics as a JSON object. The times of the f layers depend
+  on the global timer, so they are replaced by T.
+*/
+static std::string write_json(const SearchStatistics& statistics)
+{
+    std::ostringstream os;
+    utils::JsonWriter json(os);
+    json.begin_object();
+    statistics.write_json(json);
+    json.end_object();
+    static const std::regex layer_time(R"(("reopened":\d+,"time":)[^}]*)");
+    return std::regex_replace(os.str(), layer_time, "$1T");
+}
+
+TEST(SearchStatisticsTestsPublic, test_write_empty_statistics)
+{
+    utils::LogProxy log = utils::get_silent_log();
+    SearchStatistics statistics(log);
+    ASSERT_EQ(
+        write_json(statistics),
+        "{\"expanded\":0,\"reopened\":0,\"evaluated\":0,\"evaluations\":0,"
+        "\"generated\":0,\"generated_ops\":0,\"dead_ends\":0,"
+        "\"evaluators\":[],\"f_layers\":[]}");
+}
+
+TEST(SearchStatisticsTestsPublic, test_write_json)
+{
+    utils::LogProxy log = utils::get_silent_log();
+    SearchStatistics statistics(log);
+    ConstEvaluator h("h");
+
+    statistics.inc_evaluated_states();
+    statistics.inc_evaluations();
+    statistics.inc_generated();
+    statistics.report_f_value_progress(3);
+    statistics.inc_expanded();
+    statistics.inc_generated(2);
+    statistics.inc_evaluated_states(2);
+    statistics.inc_evaluations(2);
+    statistics.inc_generated_ops(4);
+    statistics.report_f_value_progress(3);
+    statistics.report_f_value_progress(5);
+    statistics.inc_dead_ends();
+    statistics.inc_reopened();
+    statistics.report_evaluator_call(&h, 0.5);
+    statistics.report_evaluator_call(&h, 0.25);
+    statistics.report_thread_expansions({1, 3});
+
+    ASSERT_EQ(
+        write_json(statistics),
+        "{\"expanded\":1,\"reopened\":1,\"evaluated\":3,\"evaluations\":3,"
+        "\"generated\":3,\"generated_ops\":4,\"dead_ends\":1,"
+        "\"last_jump\":{\"f\":5,\"expanded\":1,\"reopened\":0,"
+        "\"evaluated\":3,\"generated\":3},"
+        "\"evaluators\":[{\"description\":\"h\",\"calls\":2,\"time\":0.75}],"
+        "\"f_layers\":["
+        "{\"f\":3,\"expanded\":0,\"evaluated\":1,\"generated\":1,"
+        "\"reopened\":0,\"time\":T},"
+        "{\"f\":5,\"expanded\":1,\"evaluated\":3,\"generated\":3,"
+        "\"reopened\":0,\"time\":T}],"
+        "\"thread_expansions\":[1,3],\"load_imbalance\":1.5}");
+}
+
+TEST(SearchStatisticsTestsPublic, test_merge)
+{
+    utils::LogProxy log = utils::get_silent_log();
+    SearchStatistics lhs(log);
+    SearchStatistics rhs(log);
+    // Every worker of a parallel search has its own evaluator instances.
+    ConstEvaluator lhs_h("h");
+    ConstEvaluator rhs_h("h");
+    ConstEvaluator rhs_g("g");
+    // Different evaluators with the same description are kept apart.
+    ConstEvaluator lhs_x1("x");
+    ConstEvaluator lhs_x2("x");
+    ConstEvaluator rhs_x1("x");
+    ConstEvaluator rhs_x2("x");
+
+    lhs.inc_evaluated_states();
+    lhs.report_f_value_progress(2);
+    lhs.inc_expanded();
+    lhs.inc_generated(2);
+    lhs.report_f_value_progress(4);
+    lhs.inc_expanded();
+    lhs.report_evaluator_call(&lhs_h, 0.5);
+    lhs.report_evaluator_call(&lhs_x1, 0.5);
+    lhs.report_evaluator_call(&lhs_x2, 0.25);
+
+    rhs.inc_evaluated_states(2);
+    rhs.report_f_value_progress(3);
+    rhs.inc_expanded(3);
+    rhs.inc_generated(5);
+    rhs.report_evaluator_call(&rhs_h, 0.25);
+    rhs.report_evaluator_call(&rhs_h, 0.25);
+    rhs.report_evaluator_call(&rhs_g, 1.0);
+    rhs.report_evaluator_call(&rhs_x1, 0.5);
+    rhs.report_evaluator_call(&rhs_x2, 0.25);
+    rhs.report_evaluator_call(&rhs_x2, 0.25);
+
+    lhs.merge(rhs);
+
+    /*
+      A layer holds the counters of each search when it first reached the
+      f value or a larger one. The right-hand search never reached 4, so
+      its final counters are part of that layer.
+    */
+    ASSERT_EQ(
+        write_json(lhs),
+        "{\"expanded\":5,\"reopened\":0,\"evaluated\":3,\"evaluations\":0,"
+        "\"generated\":7,\"generated_ops\":0,\"dead_ends\":0,"
+        "\"last_jump\":{\"f\":4,\"expanded\":4,\"reopened\":0,"
+        "\"evaluated\":3,\"generated\":7},"
+        "\"evaluators\":[{\"description\":\"h\",\"calls\":3,\"time\":1},"
+        "{\"description\":\"x\",\"calls\":2,\"time\":1},"
+        "{\"description\":\"x\",\"calls\":3,\"time\":0.75},"
+        "{\"description\":\"g\",\"calls\":1,\"time\":1}],"
+        "\"f_layers\":["
+        "{\"f\":2,\"expanded\":0,\"evaluated\":3,\"generated\":0,"
+        "\"reopened\":0,\"time\":T},"
+        "{\"f\":3,\"expanded\":1,\"evaluated\":3,\"generated\":2,"
+        "\"reopened\":0,\"time\":T},"
+        "{\"f\":4,\"expanded\":4,\"evaluated\":3,\"generated\":7,"
+        "\"reopened\":0,\"time\":T}]}");
+}
+
+TEST(SearchStatisticsTestsPublic, test_evaluators_timed_only_if_enabled)
+{
+    GripperProblem problem(2, 1);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    State state = task_proxy.get_initial_state();
+    utils::LogProxy log = utils::get_silent_log();
+    SearchStatistics statistics(log);
+    ConstEvaluator h("h");
+
+    {
+        EvaluationContext eval_context(state, 0, false, &statistics);
+        eval_context.get_evaluator_value(&h);
+    }
+    ASSERT_EQ(statistics.get_evaluations(), 1);
+    ASSERT_NE(
+        write_json(statistics).find("\"evaluators\":[]"),
+        std::string::npos);
+
+    statistics.set_time_evaluators(true);
+    {
+        EvaluationContext eval_context(state, 0, false, &statistics);
+        eval_context.get_evaluator_value(&h);
+    }
+    ASSERT_EQ(statistics.get_evaluations(), 2);
+    ASSERT_NE(
+        write_json(statistics).find("{\"description\":\"h\",\"calls\":1,"),
+        std::string::npos);
+}
@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include "downward/concurrent_state_registry.h"
+
+#include "downward/task_proxy.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace tests;
+
+// Random (not necessarily reachable) states of the task.
+static std::vector<std::vector<int>> create_random_states(
+    const ClassicalTaskProxy& task_proxy,
+    int num_states,
+    unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<std::vector<int>> states;
+    for (int i = 0; i < num_states; ++i) {
+        std::vector<int> values;
+        for (VariableProxy var : task_proxy.get_variables()) {
+            std::uniform_int_distribution<int> dist(
+                0,
+                var.get_domain_size() - 1);
+            values.push_back(dist(rng));
+        }
+        states.push_back(std::move(values));
+    }
+    return states;
+}
+
+TEST(ConcurrentStateRegistryTestsPublic, test_concurrent_duplicate_detection)
+{
+    const int num_threads = 8;
+    GripperProblem problem(4, 6);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+
+    std::vector<std::vector<int>> states =
+        create_random_states(task_proxy, 20000, 42);
+    ConcurrentStateRegistry registry(task_proxy, states.size());
+
+    /*
+      All threads insert the same states in different orders, so most states
+      are inserted by several threads at roughly the same time.
+    */
+    std::vector<std::vector<StateID>> ids(
+        num_threads,
+        std::vector<StateID>(states.size(), StateID::no_state));
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            std::vector<size_t> order(states.size());
+            for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+            std::shuffle(order.begin(), order.end(), std::mt19937(t));
+            ConcurrentStateRegistry::ThreadHandle handle =
+                registry.create_thread_handle();
+            for (size_t i : order) ids[t][i] = handle.insert_state(states[i]);
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    std::vector<std::vector<int>> distinct_states = states;
+    std::sort(distinct_states.begin(), distinct_states.end());
+    distinct_states.erase(
+        std::unique(distinct_states.begin(), distinct_states.end()),
+        distinct_states.end());
+    ASSERT_EQ(registry.size(), distinct_states.size());
+
+    std::vector<StateID> distinct_ids;
+    for (size_t i = 0; i < states.size(); ++i) {
+        for (int t = 1; t < num_threads; ++t) ASSERT_EQ(ids[t][i], ids[0][i]);
+        ASSERT_EQ(registry.lookup_state_values(ids[0][i]), states[i]);
+        ASSERT_EQ(registry.find_state_id(states[i]), ids[0][i]);
+        distinct_ids.push_back(ids[0][i]);
+    }
+    std::sort(distinct_ids.begin(), distinct_ids.end());
+    distinct_ids.erase(
+        std::unique(distinct_ids.begin(), distinct_ids.end()),
+        distinct_ids.end());
+    ASSERT_EQ(distinct_ids.size(), distinct_states.size());
+}
+
+TEST(ConcurrentStateRegistryTestsPublic, test_per_state_information_growth)
+{
+    // One thread per value of the carry-left variable.
+    const int num_threads = 7;
+    const int states_per_thread = 5000;
+    GripperProblem problem(4, 6);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+
+    std::vector<std::vector<std::vector<int>>> states;
+    for (int t = 0; t < num_threads; ++t) {
+        states.push_back(
+            create_random_states(task_proxy, states_per_thread, 100 + t));
+        for (std::vector<int>& values : states.back())
+            values[problem.get_variable_carry_left()] = t;
+    }
+    ConcurrentStateRegistry registry(
+        task_proxy,
+        num_threads * states_per_thread);
+    ConcurrentPerStateInformation<int> owners(registry, -1);
+
+    /*
+      The threads insert disjoint sets of states and write the entries of
+      their states while the other threads keep growing the registry and the
+      per-state storage.
+    */
+    std::vector<std::vector<StateID>> ids(num_threads);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t) {
+        threads.emplace_back([&, t]() {
+            ConcurrentStateRegistry::ThreadHandle handle =
+                registry.create_thread_handle();
+            for (const std::vector<int>& values : states[t]) {
+                StateID id = handle.insert_state(values);
+                ids[t].push_back(id);
+                owners[id] = t;
+            }
+        });
+    }
+    for (std::thread& thread : threads) thread.join();
+
+    const ConcurrentPerStateInformation<int>& const_owners = owners;
+    for (int t = 0; t < num_threads; ++t) {
+        for (size_t i = 0; i < ids[t].size(); ++i) {
+            StateID id = ids[t][i];
+            ASSERT_EQ(const_owners[id], t);
+            ASSERT_EQ(registry.lookup_state_values(id), states[t][i]);
+        }
+    }
+    ASSERT_LE(registry.get_id_bound(), registry.get_id_capacity());
+}
+
+TEST(ConcurrentStateRegistryTestsPublic, test_successor_states)
+{
+    GripperProblem problem(3, 2);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    ConcurrentStateRegistry registry(task_proxy, 1000);
+    ConcurrentStateRegistry::ThreadHandle handle =
+        registry.create_thread_handle();
+
+    std::vector<int> initial_values =
+        task_proxy.get_initial_state().get_unpacked_values();
+    StateID initial_id = handle.insert_state(initial_values);
+    ASSERT_EQ(handle.insert_state(initial_values), initial_id);
+
+    for (OperatorProxy op : task_proxy.get_operators()) {
+        StateID succ_id =
+            handle.get_successor_state(initial_id, op.get_effect());
+        std::vector<int> succ_values = initial_values;
+        for (FactProxy effect : op.get_effect()) {
+            FactPair fact = effect.get_pair();
+            succ_values[fact.var] = fact.value;
+        }
+        ASSERT_EQ(registry.lookup_state_values(succ_id), succ_values);
+        ASSERT_EQ(handle.insert_state(succ_values), succ_id);
+    }
+}
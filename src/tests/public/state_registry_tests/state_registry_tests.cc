@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "downward/state_registry.h"
+
+#include "downward/task_proxy.h"
+
+#include "tests/tasks/gripper.h"
+
+#include <algorithm>
+#include <random>
+#include <span>
+#include <vector>
+
+using namespace tests;
+
+// Values of random (not necessarily reachable) states, with duplicates.
+static std::vector<int> create_random_values(
+    const ClassicalTaskProxy& task_proxy,
+    int num_states,
+    unsigned seed)
+{
+    std::mt19937 rng(seed);
+    std::vector<int> values;
+    for (int i = 0; i < num_states; ++i) {
+        for (VariableProxy var : task_proxy.get_variables()) {
+            // Few values per variable, so that some states repeat.
+            std::uniform_int_distribution<int> dist(
+                0,
+                std::min(var.get_domain_size(), 2) - 1);
+            values.push_back(dist(rng));
+        }
+    }
+    return values;
+}
+
+TEST(StateRegistryTestsPublic, test_insert_states)
+{
+    GripperProblem problem(3, 6);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    const int num_vars = task_proxy.get_variables().size();
+    const int num_states = 2000;
+    std::vector<int> values = create_random_values(task_proxy, num_states, 7);
+
+    StateRegistry batch_registry(task_proxy);
+    std::vector<StateID> batch_ids =
+        batch_registry.insert_states(values, num_states);
+
+    StateRegistry single_registry(task_proxy);
+    ASSERT_EQ(batch_ids.size(), static_cast<std::size_t>(num_states));
+    for (int i = 0; i < num_states; ++i) {
+        std::vector<int> state_values(
+            values.begin() + i * num_vars,
+            values.begin() + (i + 1) * num_vars);
+        State state = single_registry.insert_state(
+            std::vector<int>(state_values));
+        // Both registries assign IDs in the order of first insertion.
+        ASSERT_EQ(batch_ids[i], state.get_id());
+        ASSERT_EQ(
+            batch_registry.lookup_state(batch_ids[i]).get_unpacked_values(),
+            state_values);
+    }
+    ASSERT_EQ(batch_registry.size(), single_registry.size());
+    // There are only 2^9 different states.
+    ASSERT_LT(batch_registry.size(), static_cast<std::size_t>(num_states));
+}
+
+TEST(StateRegistryTestsPublic, test_find_state_id)
+{
+    GripperProblem problem(3, 6);
+    auto task = create_gripper_task(problem);
+    ClassicalTaskProxy task_proxy(*task);
+    const int num_vars = task_proxy.get_variables().size();
+    const int num_states = 100;
+    std::vector<int> values = create_random_values(task_proxy, num_states, 8);
+    std::span<const int> registered_values(values.data(), 50 * num_vars);
+
+    StateRegistry registry(task_proxy);
+    std::vector<StateID> ids = registry.insert_states(registered_values, 50);
+    size_t num_registered = registry.size();
+
+    for (int i = 0; i < num_states; ++i) {
+        std::span<const int> state_values(
+            values.data() + i * num_vars,
+            num_vars);
+        StateID id = registry.find_state_id(state_values);
+        if (i < 50) {
+            ASSERT_EQ(id, ids[i]);
+        } else if (id != StateID::no_state) {
+            // A later state can be a duplicate of a registered one.
+            State state = registry.lookup_state(id);
+            ASSERT_TRUE(std::equal(
+                state_values.begin(),
+                state_values.end(),
+                state.get_unpacked_values().begin()));
+        }
+        // Nothing is registered, and the registered states are intact.
+        ASSERT_EQ(registry.size(), num_registered);
+    }
+    for (int i = 0; i < 50; ++i) {
+        State state = registry.lookup_state(ids[i]);
+        ASSERT_TRUE(std::equal(
+            state.get_unpacked_values().begin(),
+            state.get_unpacked_values().end(),
+            values.begin() + i * num_vars));
+    }
+
+    // Looking up states does not change the IDs of states registered later.
+    StateRegistry fresh_registry(task_proxy);
+    fresh_registry.insert_states(registered_values, 50);
+    std::span<const int> later_values(
+        values.data() + 50 * num_vars,
+        50 * num_vars);
+    ASSERT_EQ(
+        registry.insert_states(later_values, 50),
+        fresh_registry.insert_states(later_values, 50));
+    ASSERT_EQ(registry.size(), fresh_registry.size());
+}
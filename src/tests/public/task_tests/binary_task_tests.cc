@@ -0,0 +1,166 @@
+#include <gtest/gtest.h>
+
+#include "downward/tasks/root_task.h"
+
+#include "downward/task_proxy.h"
+
+#include "downward/utils/system.h"
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+/*
+  Translator output with three variables of different domain sizes, a
+  mutex group and operators whose names contain spaces.
+*/
+static const std::string sas_task =
+    "begin_version\n3\nend_version\n"
+    "begin_metric\n1\nend_metric\n"
+    "3\n"
+    "begin_variable\nat\n-1\n3\n"
+    "Atom at(a)\nAtom at(b)\nAtom at(c)\nend_variable\n"
+    "begin_variable\nholding\n-1\n2\n"
+    "Atom holding()\nNegatedAtom holding()\nend_variable\n"
+    "begin_variable\ndone\n-1\n2\n"
+    "Atom done()\nNegatedAtom done()\nend_variable\n"
+    "1\n"
+    "begin_mutex_group\n2\n0 2\n1 0\nend_mutex_group\n"
+    "begin_state\n0\n1\n1\nend_state\n"
+    "begin_goal\n2\n0 2\n2 0\nend_goal\n"
+    "4\n"
+    "begin_operator\nmove a b\n0\n1\n0 0 0 1\n2\nend_operator\n"
+    "begin_operator\nmove b c\n1\n1 1\n1\n0 0 1 2\n3\nend_operator\n"
+    "begin_operator\npick up\n1\n0 1\n1\n0 1 1 0\n1\nend_operator\n"
+    "begin_operator\nfinish\n0\n2\n0 1 0 1\n0 2 -1 0\n5\nend_operator\n"
+    "0\n";
+
+class BinaryTaskTestsPublic : public testing::Test {
+protected:
+    std::filesystem::path filename =
+        std::filesystem::temp_directory_path() / "binary_task_tests.bin";
+
+    std::unique_ptr<ClassicalTask> sas_task_from_text() const
+    {
+        std::istringstream in(sas_task);
+        return tasks::read_task_from_sas(in);
+    }
+
+    void TearDown() override { std::filesystem::remove(filename); }
+};
+
+static std::vector<FactPair> get_facts(const auto& facts)
+{
+    std::vector<FactPair> pairs;
+    for (FactProxy fact : facts) pairs.push_back(fact.get_pair());
+    return pairs;
+}
+
+TEST_F(BinaryTaskTestsPublic, test_round_trip)
+{
+    auto task = sas_task_from_text();
+    tasks::write_binary_task(*task, filename);
+    auto binary_task = tasks::read_task_from_binary(filename);
+
+    ClassicalTaskProxy expected(*task);
+    ClassicalTaskProxy actual(*binary_task);
+
+    VariablesProxy expected_vars = expected.get_variables();
+    VariablesProxy actual_vars = actual.get_variables();
+    ASSERT_EQ(actual_vars.size(), expected_vars.size());
+    for (size_t var = 0; var < expected_vars.size(); ++var) {
+        ASSERT_EQ(actual_vars[var].get_name(), expected_vars[var].get_name());
+        ASSERT_EQ(
+            actual_vars[var].get_domain_size(),
+            expected_vars[var].get_domain_size());
+        for (int value = 0; value < expected_vars[var].get_domain_size();
+             ++value) {
+            ASSERT_EQ(
+                actual_vars[var].get_fact(value).get_name(),
+                expected_vars[var].get_fact(value).get_name());
+        }
+    }
+    for (FactProxy fact1 : expected_vars.get_facts()) {
+        for (FactProxy fact2 : expected_vars.get_facts()) {
+            FactPair pair1 = fact1.get_pair();
+            FactPair pair2 = fact2.get_pair();
+            ASSERT_EQ(
+                binary_task->are_facts_mutex(pair1, pair2),
+                task->are_facts_mutex(pair1, pair2));
+        }
+    }
+    ASSERT_TRUE(binary_task->are_facts_mutex(FactPair(0, 2), FactPair(1, 0)));
+
+    OperatorsProxy expected_ops = expected.get_operators();
+    OperatorsProxy actual_ops = actual.get_operators();
+    ASSERT_EQ(actual_ops.size(), expected_ops.size());
+    for (size_t op = 0; op < expected_ops.size(); ++op) {
+        ASSERT_EQ(actual_ops[op].get_name(), expected_ops[op].get_name());
+        ASSERT_EQ(actual_ops[op].get_cost(), expected_ops[op].get_cost());
+        ASSERT_EQ(
+            get_facts(actual_ops[op].get_precondition()),
+            get_facts(expected_ops[op].get_precondition()));
+        ASSERT_EQ(
+            get_facts(actual_ops[op].get_effect()),
+            get_facts(expected_ops[op].get_effect()));
+    }
+
+    ASSERT_EQ(get_facts(actual.get_goal()), get_facts(expected.get_goal()));
+    ASSERT_EQ(
+        binary_task->get_initial_state_values(),
+        task->get_initial_state_values());
+}
+
+TEST_F(BinaryTaskTestsPublic, test_truncated_file_is_rejected)
+{
+    auto task = sas_task_from_text();
+    tasks::write_binary_task(*task, filename);
+    std::filesystem::resize_file(
+        filename,
+        std::filesystem::file_size(filename) - 1);
+    EXPECT_EXIT(
+        tasks::read_task_from_binary(filename),
+        testing::ExitedWithCode(
+            static_cast<int>(utils::ExitCode::SEARCH_INPUT_ERROR)),
+        "is not a binary task file");
+}
+
+TEST_F(BinaryTaskTestsPublic, test_trailing_data_is_rejected)
+{
+    auto task = sas_task_from_text();
+    tasks::write_binary_task(*task, filename);
+    std::ofstream(filename, std::ios::binary | std::ios::app) << '\0';
+    EXPECT_EXIT(
+        tasks::read_task_from_binary(filename),
+        testing::ExitedWithCode(
+            static_cast<int>(utils::ExitCode::SEARCH_INPUT_ERROR)),
+        "is not a binary task file");
+}
+
+TEST_F(BinaryTaskTestsPublic, test_file_shorter_than_header_is_rejected)
+{
+    std::ofstream(filename, std::ios::binary) << "FDB";
+    EXPECT_EXIT(
+        tasks::read_task_from_binary(filename),
+        testing::ExitedWithCode(
+            static_cast<int>(utils::ExitCode::SEARCH_INPUT_ERROR)),
+        "is not a binary task file");
+}
+
+TEST_F(BinaryTaskTestsPublic, test_wrong_magic_is_rejected)
+{
+    auto task = sas_task_from_text();
+    tasks::write_binary_task(*task, filename);
+    {
+        std::fstream file(
+            filename,
+            std::ios::binary | std::ios::in | std::ios::out);
+        file.put('X');
+    }
+    EXPECT_EXIT(
+        tasks::read_task_from_binary(filename),
+        testing::ExitedWithCode(
+            static_cast<int>(utils::ExitCode::SEARCH_INPUT_ERROR)),
+        "is not a binary task file");
+}
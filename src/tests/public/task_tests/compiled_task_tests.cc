@@ -0,0 +1,170 @@
+#include <gtest/gtest.h>
+
+#include "downward/task_utils/compiled_task.h"
+
+#include "downward/operator_cost.h"
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
+
+#include "tests/tasks/blocksworld.h"
+#include "tests/tasks/gripper.h"
+
+#include <memory>
+#include <vector>
+
+using namespace compiled_task;
+using namespace tests;
+
+class CompiledTaskTestsPublic : public testing::Test {
+protected:
+    GripperProblem gripper_problem;
+    BlocksWorldProblem blocksworld_problem;
+    std::vector<std::shared_ptr<ClassicalTask>> tasks;
+
+    CompiledTaskTestsPublic()
+        : gripper_problem(3, 3)
+        // Picking up a block costs 100, putting it down costs 10.
+        , blocksworld_problem(4, 100, 10)
+    {
+        tasks.push_back(create_gripper_task(gripper_problem));
+        std::vector<FactPair> initial = {
+            blocksworld_problem.get_fact_is_hand_empty(true)};
+        for (int block = 0; block < 4; ++block) {
+            initial.push_back(
+                blocksworld_problem.get_fact_location_on_table(block));
+            initial.push_back(
+                blocksworld_problem.get_fact_is_clear(block, true));
+        }
+        std::vector<FactPair> goal = {
+            blocksworld_problem.get_fact_location_on_table(0),
+            blocksworld_problem.get_fact_location_on_block(1, 0),
+            blocksworld_problem.get_fact_location_on_block(2, 1)};
+        tasks.push_back(
+            create_problem_task(blocksworld_problem, initial, goal));
+    }
+
+    static std::vector<FactPair> get_pairs(auto facts)
+    {
+        std::vector<FactPair> pairs;
+        for (FactProxy fact : facts) pairs.push_back(fact.get_pair());
+        return pairs;
+    }
+};
+
+TEST_F(CompiledTaskTestsPublic, test_snapshot_matches_task)
+{
+    for (const auto& task : tasks) {
+        ClassicalTaskProxy task_proxy(*task);
+        const CompiledTask& compiled = g_compiled_tasks[task_proxy];
+        // All users of the task share the snapshot.
+        ASSERT_EQ(&g_compiled_tasks[task_proxy], &compiled);
+
+        VariablesProxy variables = task_proxy.get_variables();
+        ASSERT_EQ(
+            compiled.get_num_variables(),
+            static_cast<int>(variables.size()));
+        int fact_id = 0;
+        for (VariableProxy var : variables) {
+            ASSERT_EQ(
+                compiled.get_domain_size(var.get_id()),
+                var.get_domain_size());
+            for (int value = 0; value < var.get_domain_size(); ++value) {
+                ASSERT_EQ(
+                    compiled.get_fact_id(FactPair(var.get_id(), value)),
+                    fact_id++);
+            }
+        }
+        ASSERT_EQ(compiled.get_num_facts(), fact_id);
+
+        OperatorsProxy operators = task_proxy.get_operators();
+        bool is_unit_cost = task_properties::is_unit_cost(task_proxy);
+        ASSERT_EQ(compiled.is_unit_cost(), is_unit_cost);
+        ASSERT_EQ(
+            compiled.get_num_operators(),
+            static_cast<int>(operators.size()));
+        for (OperatorProxy op : operators) {
+            OperatorID op_id(op.get_id());
+            auto preconditions = compiled.get_preconditions(op_id);
+            auto effects = compiled.get_effects(op_id);
+            ASSERT_EQ(
+                std::vector<FactPair>(
+                    preconditions.begin(),
+                    preconditions.end()),
+                get_pairs(op.get_precondition()));
+            ASSERT_EQ(
+                std::vector<FactPair>(effects.begin(), effects.end()),
+                get_pairs(op.get_effect()));
+            ASSERT_EQ(compiled.get_cost(op_id), op.get_cost());
+            for (OperatorCost cost_type : {NORMAL, ONE, PLUSONE}) {
+                ASSERT_EQ(
+                    compiled.get_adjusted_cost(op_id, cost_type),
+                    get_adjusted_action_cost(op, cost_type, is_unit_cost));
+            }
+        }
+        auto goals = compiled.get_goals();
+        ASSERT_EQ(
+            std::vector<FactPair>(goals.begin(), goals.end()),
+            get_pairs(task_proxy.get_goal()));
+    }
+}
+
+/*
+  Explore all reachable states with the compiled applicability test and
+  effects, and compare every step with the proxies.
+*/
+TEST_F(CompiledTaskTestsPublic, test_reachable_states_match_proxies)
+{
+    for (const auto& task : tasks) {
+        ClassicalTaskProxy task_proxy(*task);
+        const CompiledTask& compiled = g_compiled_tasks[task_proxy];
+        OperatorsProxy operators = task_proxy.get_operators();
+        StateRegistry registry(task_proxy);
+        StateRegistry proxy_registry(task_proxy);
+        // Both registries register the same states in the same order.
+        proxy_registry.get_initial_state();
+
+        std::vector<State> states = {registry.get_initial_state()};
+        int num_goal_states = 0;
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            // Keep the state alive while its unpacked values are used.
+            State state = states[i];
+            const std::vector<int>& values = state.get_unpacked_values();
+            bool is_goal = task_properties::is_goal_state(task_proxy, state);
+            ASSERT_EQ(compiled.is_goal_state(values), is_goal);
+            int num_unsatisfied = 0;
+            for (FactProxy goal : task_proxy.get_goal()) {
+                if (state[goal.get_variable()].get_value() !=
+                    goal.get_value()) {
+                    ++num_unsatisfied;
+                }
+            }
+            ASSERT_EQ(
+                compiled.get_num_unsatisfied_goals(values),
+                num_unsatisfied);
+            num_goal_states += is_goal;
+
+            for (OperatorProxy op : operators) {
+                OperatorID op_id(op.get_id());
+                bool applicable = task_properties::is_applicable(op, state);
+                ASSERT_EQ(compiled.is_applicable(op_id, values), applicable);
+                if (!applicable) continue;
+                std::size_t num_states = registry.size();
+                State succ = registry.get_successor_state(
+                    state,
+                    compiled.get_effects(op_id));
+                State proxy_succ = proxy_registry.get_successor_state(
+                    proxy_registry.lookup_state(state.get_id()),
+                    op.get_effect());
+                ASSERT_EQ(succ.get_id(), proxy_succ.get_id());
+                ASSERT_EQ(
+                    succ.get_unpacked_values(),
+                    proxy_succ.get_unpacked_values());
+                if (registry.size() > num_states) states.push_back(succ);
+            }
+        }
+        ASSERT_GT(states.size(), 100u);
+        ASSERT_GT(num_goal_states, 0);
+    }
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include "neuralfd/task_utils/partial_state_index.h"
+
+#include "downward/state.h"
+
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace partial_state_index;
+
+static constexpr int U = PartialAssignment::UNASSIGNED;
+static constexpr int NO_LIMIT = std::numeric_limits<int>::max();
+
+TEST(PartialStateIndexTestsPublic, test_empty_index)
+{
+    PartialStateIndex index(3);
+    ASSERT_EQ(index.size(), 0u);
+    ASSERT_EQ(
+        index.find_cheapest_generalization({0, 1, 2}, NO_LIMIT),
+        std::make_pair(PartialStateIndex::NO_ENTRY, NO_LIMIT));
+    ASSERT_EQ(
+        index.find_cheapest_specialization({U, U, U}, NO_LIMIT),
+        std::make_pair(PartialStateIndex::NO_ENTRY, NO_LIMIT));
+}
+
+TEST(PartialStateIndexTestsPublic, test_single_entry_is_collapsed_leaf)
+{
+    PartialStateIndex index(3);
+    index.insert({0, U, 2}, 7, 5);
+    ASSERT_EQ(index.size(), 1u);
+    ASSERT_EQ(index.get_num_nodes(), 1u);
+
+    ASSERT_EQ(
+        index.find_cheapest_generalization({0, 1, 2}, NO_LIMIT),
+        std::make_pair(7, 5));
+    ASSERT_EQ(
+        index.find_cheapest_generalization({1, 1, 2}, NO_LIMIT).first,
+        PartialStateIndex::NO_ENTRY);
+    ASSERT_EQ(
+        index.find_cheapest_specialization({0, U, U}, NO_LIMIT),
+        std::make_pair(7, 5));
+    ASSERT_EQ(
+        index.find_cheapest_specialization({0, 1, U}, NO_LIMIT).first,
+        PartialStateIndex::NO_ENTRY);
+}
+
+TEST(PartialStateIndexTestsPublic, test_insert_splits_collapsed_leaves)
+{
+    PartialStateIndex index(3);
+    index.insert({0, 1, 2}, 0, 5);
+    index.insert({0, U, 2}, 1, 3);
+    ASSERT_EQ(index.size(), 2u);
+    // The root, the node for var 0 = 0 and one leaf per entry.
+    ASSERT_EQ(index.get_num_nodes(), 4u);
+
+    ASSERT_EQ(
+        index.find_cheapest_generalization({0, 1, 2}, NO_LIMIT),
+        std::make_pair(1, 3));
+    ASSERT_EQ(
+        index.find_cheapest_generalization({0, 0, 2}, NO_LIMIT),
+        std::make_pair(1, 3));
+    ASSERT_EQ(
+        index.find_cheapest_generalization({0, 1, 1}, NO_LIMIT).first,
+        PartialStateIndex::NO_ENTRY);
+
+    ASSERT_EQ(
+        index.find_cheapest_specialization({0, U, U}, NO_LIMIT),
+        std::make_pair(1, 3));
+    ASSERT_EQ(
+        index.find_cheapest_specialization({U, 1, U}, NO_LIMIT),
+        std::make_pair(0, 5));
+}
+
+TEST(PartialStateIndexTestsPublic, test_cost_limit_is_exclusive)
+{
+    PartialStateIndex index(2);
+    index.insert({0, 1}, 0, 5);
+    index.insert({0, U}, 1, 3);
+
+    ASSERT_EQ(
+        index.find_cheapest_generalization({0, 1}, 4),
+        std::make_pair(1, 3));
+    ASSERT_EQ(
+        index.find_cheapest_generalization({0, 1}, 3),
+        std::make_pair(PartialStateIndex::NO_ENTRY, 3));
+    ASSERT_EQ(
+        index.find_cheapest_specialization({U, 1}, 5),
+        std::make_pair(PartialStateIndex::NO_ENTRY, 5));
+    ASSERT_EQ(
+        index.find_cheapest_specialization({U, 1}, 6),
+        std::make_pair(0, 5));
+}
+
+TEST(PartialStateIndexTestsPublic, test_reinsert_replaces_only_if_cheaper)
+{
+    PartialStateIndex index(3);
+    index.insert({0, 1, 2}, 0, 5);
+    index.insert({1, 1, 2}, 1, 5);
+
+    index.insert({0, 1, 2}, 2, 7);
+    ASSERT_EQ(index.size(), 2u);
+    ASSERT_EQ(
+        index.find_cheapest_generalization({0, 1, 2}, NO_LIMIT),
+        std::make_pair(0, 5));
+
+    index.insert({0, 1, 2}, 3, 4);
+    ASSERT_EQ(index.size(), 2u);
+    ASSERT_EQ(
+        index.find_cheapest_generalization({0, 1, 2}, NO_LIMIT),
+        std::make_pair(3, 4));
+    ASSERT_EQ(
+        index.find_cheapest_specialization({U, 1, 2}, NO_LIMIT),
+        std::make_pair(3, 4));
+}
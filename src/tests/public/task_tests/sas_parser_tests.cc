@@ -0,0 +1,109 @@
+#include <gtest/gtest.h>
+
+#include "downward/tasks/root_task.h"
+
+#include "downward/task_proxy.h"
+
+#include <sstream>
+#include <string>
+
+/*
+  Translator output with two binary variables and the given number of
+  operators. Some operator names contain the magic words that delimit
+  operators, so the parallel parser must not split the operator section
+  at them.
+*/
+static std::string create_sas_task(int num_operators)
+{
+    std::ostringstream out;
+    out << "begin_version\n3\nend_version\n"
+        << "begin_metric\n1\nend_metric\n"
+        << "2\n";
+    for (int var = 0; var < 2; ++var) {
+        out << "begin_variable\nvar" << var << "\n-1\n2\n"
+            << "Atom p" << var << "()\n"
+            << "NegatedAtom p" << var << "()\n"
+            << "end_variable\n";
+    }
+    out << "0\n"
+        << "begin_state\n0\n0\nend_state\n"
+        << "begin_goal\n1\n1 1\nend_goal\n"
+        << num_operators << "\n";
+    for (int i = 0; i < num_operators; ++i) {
+        int var = i % 2;
+        out << "begin_operator\n";
+        switch (i % 4) {
+        case 0: out << "op " << i << "\n"; break;
+        case 1: out << "end_operator\n"; break;
+        case 2: out << "end_operator begin_operator " << i << "\n"; break;
+        case 3: out << "begin_operator\n"; break;
+        }
+        out << "1\n" << 1 - var << " " << i % 2 << "\n"
+            << "1\n0 " << var << " -1 " << (i / 2) % 2 << "\n"
+            << i % 7 + 1 << "\n"
+            << "end_operator\n";
+    }
+    out << "0\n";
+    return out.str();
+}
+
+static std::unique_ptr<ClassicalTask>
+parse_sas_task(const std::string& sas, int num_threads)
+{
+    std::istringstream in(sas);
+    return tasks::read_task_from_sas(in, num_threads);
+}
+
+static void
+assert_equal_operators(const ClassicalTask& lhs, const ClassicalTask& rhs)
+{
+    ClassicalTaskProxy lhs_proxy(lhs);
+    ClassicalTaskProxy rhs_proxy(rhs);
+    OperatorsProxy lhs_operators = lhs_proxy.get_operators();
+    OperatorsProxy rhs_operators = rhs_proxy.get_operators();
+    ASSERT_EQ(lhs_operators.size(), rhs_operators.size());
+    for (size_t i = 0; i < lhs_operators.size(); ++i) {
+        OperatorProxy lhs_op = lhs_operators[i];
+        OperatorProxy rhs_op = rhs_operators[i];
+        ASSERT_EQ(lhs_op.get_name(), rhs_op.get_name());
+        ASSERT_EQ(lhs_op.get_cost(), rhs_op.get_cost());
+        std::vector<FactPair> lhs_facts;
+        std::vector<FactPair> rhs_facts;
+        for (FactProxy fact : lhs_op.get_precondition())
+            lhs_facts.push_back(fact.get_pair());
+        for (FactProxy fact : rhs_op.get_precondition())
+            rhs_facts.push_back(fact.get_pair());
+        ASSERT_EQ(lhs_facts, rhs_facts);
+        lhs_facts.clear();
+        rhs_facts.clear();
+        for (FactProxy fact : lhs_op.get_effect())
+            lhs_facts.push_back(fact.get_pair());
+        for (FactProxy fact : rhs_op.get_effect())
+            rhs_facts.push_back(fact.get_pair());
+        ASSERT_EQ(lhs_facts, rhs_facts);
+    }
+}
+
+TEST(SasParserTestsPublic, test_operator_names_with_magic_words)
+{
+    auto task = parse_sas_task(create_sas_task(4), 1);
+    ClassicalTaskProxy task_proxy(*task);
+    OperatorsProxy operators = task_proxy.get_operators();
+    ASSERT_EQ(operators.size(), 4u);
+    ASSERT_EQ(operators[0].get_name(), "op 0");
+    ASSERT_EQ(operators[1].get_name(), "end_operator");
+    ASSERT_EQ(operators[2].get_name(), "end_operator begin_operator 2");
+    ASSERT_EQ(operators[3].get_name(), "begin_operator");
+    ASSERT_EQ(operators[3].get_cost(), 4);
+}
+
+TEST(SasParserTestsPublic, test_parallel_parsing_gives_same_task)
+{
+    // Enough operators that the parser uses several threads.
+    std::string sas = create_sas_task(50001);
+    auto sequential_task = parse_sas_task(sas, 1);
+    for (int num_threads : {2, 3, 4, 8}) {
+        auto parallel_task = parse_sas_task(sas, num_threads);
+        assert_equal_operators(*sequential_task, *parallel_task);
+    }
+}
@@ -0,0 +1,240 @@
+#include <gtest/gtest.h>
+
+#include "downward/task_utils/successor_generator.h"
+
+#include "downward/state_registry.h"
+#include "downward/task_proxy.h"
+
+#include "tests/tasks/gripper.h"
+#include "tests/tasks/simple_task.h"
+
+#include <algorithm>
+#include <numeric>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace successor_generator;
+using namespace tests;
+
+namespace {
+/*
+  Operators with random preconditions on up to four of the variables, so
+  that the generator tree has forks, leaves on every level and switches of
+  all kinds. Some operators have no precondition at all, and the
+  preconditions on the variables with large domains only use a few values,
+  which gives sparse switches. There are several blocks of the bitset
+  engine.
+*/
+class RandomProblem : public ClassicalPlanningProblem {
+public:
+    RandomProblem(
+        const std::vector<int>& domain_sizes,
+        int num_operators,
+        unsigned seed)
+    {
+        std::mt19937 rng(seed);
+        auto random_int = [&rng](int bound) {
+            return std::uniform_int_distribution<int>(0, bound - 1)(rng);
+        };
+        int num_vars = domain_sizes.size();
+        for (int var = 0; var < num_vars; ++var) {
+            std::vector<std::string> fact_names;
+            for (int value = 0; value < domain_sizes[var]; ++value) {
+                fact_names.push_back(
+                    "v" + std::to_string(var) + "=" + std::to_string(value));
+            }
+            variable_infos.emplace_back(
+                "v" + std::to_string(var),
+                domain_sizes[var],
+                std::move(fact_names));
+        }
+
+        std::vector<int> vars(num_vars);
+        std::iota(vars.begin(), vars.end(), 0);
+        for (int op = 0; op < num_operators; ++op) {
+            std::shuffle(vars.begin(), vars.end(), rng);
+            int num_preconditions = random_int(5);
+            std::vector<FactPair> precondition;
+            for (int i = 0; i < num_preconditions; ++i) {
+                int domain_size = domain_sizes[vars[i]];
+                int value = domain_size > 5 && random_int(2)
+                                ? (random_int(2) ? 0 : domain_size - 1)
+                                : random_int(domain_size);
+                precondition.emplace_back(vars[i], value);
+            }
+            int num_effects = 1 + random_int(2);
+            std::vector<FactPair> effect;
+            for (int i = 0; i < num_effects; ++i) {
+                int var = vars[num_vars - 1 - i];
+                effect.emplace_back(var, random_int(domain_sizes[var]));
+            }
+            std::sort(precondition.begin(), precondition.end());
+            std::sort(effect.begin(), effect.end());
+            operators.emplace_back(
+                "op" + std::to_string(op),
+                1,
+                std::move(precondition),
+                std::move(effect));
+        }
+    }
+};
+} // namespace
+
+class SuccessorGeneratorTestsPublic : public testing::Test {
+protected:
+    RandomProblem random_problem;
+    GripperProblem gripper_problem;
+    std::vector<std::shared_ptr<ClassicalTask>> tasks;
+
+    SuccessorGeneratorTestsPublic()
+        : random_problem({2, 3, 2, 7, 20, 2, 3}, 600, 2024)
+        , gripper_problem(4, 4)
+    {
+        std::vector<FactPair> initial;
+        for (int var = 0; var < random_problem.get_num_variables(); ++var) {
+            initial.emplace_back(var, 0);
+        }
+        tasks.push_back(create_problem_task(random_problem, initial, {}));
+        tasks.push_back(create_gripper_task(gripper_problem));
+    }
+
+    // All states reachable from the initial state, in breadth-first order.
+    static std::vector<State> get_reachable_states(
+        StateRegistry& registry,
+        const ClassicalTaskProxy& task_proxy)
+    {
+        SuccessorGenerator tree(task_proxy);
+        OperatorsProxy operators = task_proxy.get_operators();
+        std::vector<State> states = {registry.get_initial_state()};
+        std::vector<OperatorID> applicable_ops;
+        for (std::size_t i = 0; i < states.size(); ++i) {
+            applicable_ops.clear();
+            tree.generate_applicable_ops(states[i], applicable_ops);
+            for (OperatorID op_id : applicable_ops) {
+                std::size_t num_states = registry.size();
+                State succ = registry.get_successor_state(
+                    states[i],
+                    operators[op_id].get_effect());
+                if (registry.size() > num_states) states.push_back(succ);
+            }
+        }
+        return states;
+    }
+
+    static std::vector<OperatorID> get_applicable_ops(
+        const SuccessorGenerator& generator,
+        const State& state)
+    {
+        std::vector<OperatorID> applicable_ops;
+        generator.generate_applicable_ops(state, applicable_ops);
+        return applicable_ops;
+    }
+
+    static void sort_by_id(std::vector<OperatorID>& ops)
+    {
+        std::sort(ops.begin(), ops.end(), [](OperatorID lhs, OperatorID rhs) {
+            return lhs.get_index() < rhs.get_index();
+        });
+    }
+};
+
+TEST_F(SuccessorGeneratorTestsPublic, test_byte_code_matches_tree)
+{
+    for (const auto& task : tasks) {
+        ClassicalTaskProxy task_proxy(*task);
+        StateRegistry registry(task_proxy);
+        std::vector<State> states = get_reachable_states(registry, task_proxy);
+        ASSERT_GT(states.size(), 1000u);
+
+        SuccessorGenerator tree(task_proxy, Representation::TREE);
+        SuccessorGenerator byte_code(task_proxy, Representation::BYTE_CODE);
+        SuccessorGenerator loaded_byte_code(byte_code.get_byte_code());
+        for (const State& state : states) {
+            std::vector<OperatorID> expected = get_applicable_ops(tree, state);
+            // The byte code generates the operators in the same order.
+            ASSERT_EQ(get_applicable_ops(byte_code, state), expected);
+            ASSERT_EQ(get_applicable_ops(loaded_byte_code, state), expected);
+        }
+    }
+}
+
+TEST_F(SuccessorGeneratorTestsPublic, test_bitset_matches_tree)
+{
+    for (const auto& task : tasks) {
+        ClassicalTaskProxy task_proxy(*task);
+        StateRegistry registry(task_proxy);
+        std::vector<State> states = get_reachable_states(registry, task_proxy);
+
+        SuccessorGenerator tree(task_proxy, Representation::TREE);
+        SuccessorGenerator bitset(task_proxy, Representation::BITSET);
+        SuccessorGenerator automatic(task_proxy, Representation::AUTOMATIC);
+        std::size_t num_applicable_ops = 0;
+        for (const State& state : states) {
+            std::vector<OperatorID> expected = get_applicable_ops(tree, state);
+            // The bitset engine generates the operators ordered by ID.
+            sort_by_id(expected);
+            ASSERT_EQ(get_applicable_ops(bitset, state), expected);
+            std::vector<OperatorID> automatic_ops =
+                get_applicable_ops(automatic, state);
+            sort_by_id(automatic_ops);
+            ASSERT_EQ(automatic_ops, expected);
+            num_applicable_ops += expected.size();
+        }
+        ASSERT_GT(num_applicable_ops, states.size());
+    }
+}
+
+TEST_F(SuccessorGeneratorTestsPublic, test_batch_matches_single_states)
+{
+    for (const auto& task : tasks) {
+        ClassicalTaskProxy task_proxy(*task);
+        StateRegistry registry(task_proxy);
+        std::vector<State> states = get_reachable_states(registry, task_proxy);
+        // Batches may contain the same state several times.
+        std::mt19937 rng(7);
+        for (int i = 0; i < 100; ++i) {
+            states.push_back(states[rng() % states.size()]);
+        }
+        std::shuffle(states.begin(), states.end(), rng);
+
+        for (Representation representation :
+             {Representation::TREE,
+              Representation::BYTE_CODE,
+              Representation::BITSET}) {
+            SuccessorGenerator generator(task_proxy, representation);
+            ApplicableOpsBatch batch;
+            generator.generate_applicable_ops_batch({}, batch);
+            ASSERT_EQ(batch.offsets, std::vector<int>{0});
+            ASSERT_TRUE(batch.operators.empty());
+
+            for (std::size_t batch_size : {1, 7, 256, 1000}) {
+                for (std::size_t begin = 0; begin < states.size();
+                     begin += batch_size) {
+                    std::size_t end =
+                        std::min(begin + batch_size, states.size());
+                    std::span<const State> batch_states(
+                        states.data() + begin,
+                        end - begin);
+                    generator.generate_applicable_ops_batch(
+                        batch_states,
+                        batch);
+                    ASSERT_EQ(batch.offsets.size(), batch_states.size() + 1);
+                    ASSERT_EQ(batch.offsets.front(), 0);
+                    ASSERT_EQ(
+                        batch.offsets.back(),
+                        static_cast<int>(batch.operators.size()));
+                    for (std::size_t i = 0; i < batch_states.size(); ++i) {
+                        std::vector<OperatorID> batch_ops(
+                            batch.operators.begin() + batch.offsets[i],
+                            batch.operators.begin() + batch.offsets[i + 1]);
+                        ASSERT_EQ(
+                            batch_ops,
+                            get_applicable_ops(generator, batch_states[i]));
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+#include <gtest/gtest.h>
+
+#include "downward/utils/json.h"
+
+#include <cstddef>
+#include <limits>
+#include <sstream>
+
+using namespace utils;
+
+TEST(JsonTestsPublic, test_string_escaping)
+{
+    std::ostringstream os;
+    JsonWriter json(os);
+    json.value("quote \" backslash \\ newline \n tab \t return \r bell \a");
+    ASSERT_EQ(
+        os.str(),
+        "\"quote \\\" backslash \\\\ newline \\n tab \\t return \\r "
+        "bell \\u0007\"");
+}
+
+TEST(JsonTestsPublic, test_keys_are_escaped)
+{
+    std::ostringstream os;
+    JsonWriter json(os);
+    json.begin_object();
+    json.key("a\"b");
+    json.value(1);
+    json.end_object();
+    ASSERT_EQ(os.str(), "{\"a\\\"b\":1}");
+}
+
+TEST(JsonTestsPublic, test_nesting_and_commas)
+{
+    std::ostringstream os;
+    JsonWriter json(os);
+    json.begin_object();
+    json.key("empty_object");
+    json.begin_object();
+    json.end_object();
+    json.key("empty_array");
+    json.begin_array();
+    json.end_array();
+    json.key("values");
+    json.begin_array();
+    json.value(-1);
+    json.value(1LL << 40);
+    json.value(std::size_t(7));
+    json.value(0.5);
+    json.value(true);
+    json.null();
+    json.begin_array();
+    json.value("x");
+    json.end_array();
+    json.begin_object();
+    json.key("y");
+    json.value(false);
+    json.end_object();
+    json.end_array();
+    json.key("last");
+    json.value("z");
+    json.end_object();
+    ASSERT_EQ(
+        os.str(),
+        "{\"empty_object\":{},\"empty_array\":[],"
+        "\"values\":[-1,1099511627776,7,0.5,true,null,[\"x\"],{\"y\":false}],"
+        "\"last\":\"z\"}");
+}
+
+TEST(JsonTestsPublic, test_doubles)
+{
+    std::ostringstream os;
+    JsonWriter json(os);
+    json.begin_array();
+    json.value(0.1);
+    json.value(3.0);
+    json.value(std::numeric_limits<double>::infinity());
+    json.value(std::numeric_limits<double>::quiet_NaN());
+    json.end_array();
+    // Doubles are written as the shortest string that reads back exactly.
+    ASSERT_EQ(os.str(), "[0.1,3,null,null]");
+}
@@ -1,5 +1,7 @@
 #include "tests/tasks/gripper.h"
 
+#include "downward/state_registry.h"
+
 #include <set>
 
 namespace tests {
@@ -103,6 +105,16 @@ GripperProblem::GripperProblem(int num_rooms, int num_balls)
     }
 }
 
+int GripperProblem::get_num_rooms() const
+{
+    return num_rooms;
+}
+
+int GripperProblem::get_num_balls() const
+{
+    return num_balls;
+}
+
 int GripperProblem::get_variable_robot_at() const
 {
     return 0;
@@ -229,4 +241,49 @@ void GripperProblem::verify_ball_index(int ball_idx) const
     }
 }
 
+std::shared_ptr<ClassicalTask> create_gripper_task(
+    const GripperProblem& problem,
+    std::vector<FactPair> goal)
+{
+    std::vector<FactPair> initial = {
+        problem.get_fact_robot_at_room(0),
+        problem.get_fact_carry_left_none(),
+        problem.get_fact_carry_right_none()};
+    for (int b = 0; b != problem.get_num_balls(); ++b) {
+        initial.push_back(problem.get_fact_ball_at_room(b, 0));
+    }
+    return create_problem_task(problem, initial, std::move(goal));
+}
+
+std::shared_ptr<ClassicalTask>
+create_gripper_task(const GripperProblem& problem)
+{
+    std::vector<FactPair> goal;
+    for (int b = 0; b != problem.get_num_balls(); ++b) {
+        goal.push_back(problem.get_fact_ball_at_room(b, 1));
+    }
+    return create_gripper_task(problem, std::move(goal));
+}
+
+std::shared_ptr<ClassicalTask>
+create_gripper_round_trip_task(const GripperProblem& problem)
+{
+    std::vector<FactPair> goal = {problem.get_fact_robot_at_room(0)};
+    for (int b = 0; b != problem.get_num_balls(); ++b) {
+        goal.push_back(problem.get_fact_ball_at_room(b, 1));
+    }
+    return create_gripper_task(problem, std::move(goal));
+}
+
+State insert_state_with_robot_at(
+    StateRegistry& registry,
+    const GripperProblem& problem,
+    int room_idx)
+{
+    std::vector<int> values =
+        registry.get_task_proxy().get_initial_state().get_unpacked_values();
+    values[problem.get_variable_robot_at()] = room_idx;
+    return registry.insert_state(std::move(values));
+}
+
 } // namespace tests
@@ -4,6 +4,9 @@
 #include "downward/search_algorithms/search_common.h"
 
 #include "downward/open_list_factory.h"
+#include "downward/task_proxy.h"
+
+#include "downward/task_utils/task_properties.h"
 
 #include <set>
 
@@ -29,4 +32,16 @@ std::unique_ptr<SearchAlgorithm> create_astar_search_algorithm(
         std::shared_ptr<Evaluator>());
 }
 
-}
\ No newline at end of file
+bool leads_to_goal(const ClassicalTaskProxy& task_proxy, const Plan& plan)
+{
+    State state = task_proxy.get_initial_state();
+    OperatorsProxy operators = task_proxy.get_operators();
+    for (OperatorID op_id : plan) {
+        OperatorProxy op = operators[op_id];
+        if (!task_properties::is_applicable(op, state)) return false;
+        state = state.get_unregistered_successor(op.get_effect());
+    }
+    return task_properties::is_goal_state(task_proxy, state);
+}
+
+}